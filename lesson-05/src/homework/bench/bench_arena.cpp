@@ -0,0 +1,73 @@
+// Batches of short-lived matrix temporaries: each job copies two inputs,
+// computes ((a + b) * a)^T and reads one element. Storage comes from the
+// global heap, std::pmr resources, or a MatrixArena reset after each batch.
+
+#include "../include/Matrix.hpp"
+#include "../include/MatrixArena.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+#include <memory_resource>
+
+namespace
+{
+    constexpr size_t JobsPerBatch = 1000;
+
+    float job(const BasicMatrix<float>& x, const BasicMatrix<float>& y, std::pmr::memory_resource* res)
+    {
+        BasicMatrix<float> a(x, res);
+        BasicMatrix<float> b(y, res);
+        BasicMatrix<float> c = ((a + b) * a).transpose();
+        return static_cast<const BasicMatrix<float>&>(c).data()[0];
+    }
+
+    template <class Reset>
+    float batch(const BasicMatrix<float>& x, const BasicMatrix<float>& y, std::pmr::memory_resource* res, Reset&& reset)
+    {
+        float acc = 0;
+        for (size_t j = 0; j < JobsPerBatch; ++j)
+            acc += job(x, y, res);
+        reset();
+        return acc;
+    }
+
+    void run(size_t n, size_t batches)
+    {
+        BasicMatrix<float> x(n, n), y(n, n);
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j) {
+                x.row_ptr(i)[j] = float(i + j);
+                y.row_ptr(i)[j] = float(i) - float(j);
+            }
+
+        auto time = [&](std::pmr::memory_resource* res, auto reset) {
+            return bestOf(3, batches, [&] { doNotOptimize(batch(x, y, res, reset)); }) / double(batches * JobsPerBatch);
+        };
+        const auto noReset = [] {};
+
+        const double tHeap = time(nullptr, noReset);
+
+        std::pmr::unsynchronized_pool_resource pool;
+        const double tPool = time(&pool, noReset);
+
+        std::pmr::monotonic_buffer_resource monotonic;
+        const double tMonotonic = time(&monotonic, [&] { monotonic.release(); });
+
+        MatrixArena arena;
+        const double tArena = time(&arena, [&] { arena.reset(); });
+
+        std::printf("  %3zu x %-3zu  heap %8.1f ns | pmr pool %8.1f ns | pmr monotonic %8.1f ns | MatrixArena %8.1f ns (x%.2f)\n",
+                    n, n, tHeap * 1e9, tPool * 1e9, tMonotonic * 1e9, tArena * 1e9, tHeap / tArena);
+    }
+}
+
+int main()
+{
+    printHeader("Per job: 2 copies + 3 temporaries, batches of 1000 jobs");
+    run(2, 200);
+    run(4, 200);
+    run(8, 100);
+    run(16, 20);
+    run(64, 2);
+    return 0;
+}
@@ -0,0 +1,69 @@
+// A pipeline that passes a large matrix by value through several stages,
+// most of which only read it, with deep copies and with copy-on-write.
+
+#include "../include/Matrix.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+
+namespace
+{
+    constexpr size_t Stages = 16;
+
+    // reads one row, as a cheap "inspect" stage would
+    double inspect(BasicMatrix<double> m, size_t stage)
+    {
+        double s = 0;
+        const BasicMatrix<double>& c = m;
+        for (size_t j = 0; j < c.getColumns(); ++j)
+            s += c[stage % c.getRows()][j];
+        return s;
+    }
+
+    // every writeEvery-th stage modifies its own copy
+    double stage(BasicMatrix<double> m, size_t i, size_t writeEvery)
+    {
+        if (writeEvery != 0 && i % writeEvery == 0) {
+            m[0][0] += 1.0;
+            return m[0][0];
+        }
+        return inspect(std::move(m), i);
+    }
+
+    double pipeline(const BasicMatrix<double>& input, size_t writeEvery)
+    {
+        double acc = 0;
+        for (size_t i = 0; i < Stages; ++i)
+            acc += stage(input, i, writeEvery);
+        return acc;
+    }
+
+    void run(size_t n, size_t writeEvery)
+    {
+        BasicMatrix<double> m(n, n);
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                m.row_ptr(i)[j] = double(i + j);
+        BasicMatrix<double> cow = m;
+        cow.setCopyOnWrite(true);
+
+        const double tDeep = bestOf(3, 1, [&] { doNotOptimize(pipeline(m, writeEvery)); });
+        const double tCow = bestOf(3, 1, [&] { doNotOptimize(pipeline(cow, writeEvery)); });
+        char writes[32];
+        if (writeEvery == 0)
+            std::snprintf(writes, sizeof(writes), "read only");
+        else
+            std::snprintf(writes, sizeof(writes), "1 write in %zu", writeEvery);
+        std::printf("  %5zu x %-5zu %-14s deep %8.2f ms | cow %8.2f ms | x%.1f\n",
+                    n, n, writes, tDeep * 1e3, tCow * 1e3, tDeep / tCow);
+    }
+}
+
+int main()
+{
+    printHeader("Pipeline of 16 by-value stages");
+    for (size_t n : {256, 1024, 2048})
+        for (size_t writeEvery : {0, 8, 1})
+            run(n, writeEvery);
+    return 0;
+}
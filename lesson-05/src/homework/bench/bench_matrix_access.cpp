@@ -0,0 +1,103 @@
+// 5-point stencil written by "user code" through each Matrix accessor.
+//
+//   out[i][j] = 4 * in[i][j] - in[i-1][j] - in[i+1][j] - in[i][j-1] - in[i][j+1]
+
+#include "../include/Matrix.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+
+namespace
+{
+    constexpr size_t N = 1024;
+    constexpr size_t Iterations = 20;
+
+    template <class M>
+    void fill(M& m)
+    {
+        for (size_t i = 0; i < m.getRows(); ++i)
+            for (size_t j = 0; j < m.getColumns(); ++j)
+                m.at(i, j) = float((i * 31 + j * 17) % 97);
+    }
+
+    template <class M>
+    void stencilAt(const M& in, M& out)
+    {
+        for (size_t i = 1; i + 1 < N; ++i)
+            for (size_t j = 1; j + 1 < N; ++j)
+                out.at(i, j) = 4 * in.at(i, j) - in.at(i - 1, j) - in.at(i + 1, j)
+                             - in.at(i, j - 1) - in.at(i, j + 1);
+    }
+
+    template <class M>
+    void stencilProxy(const M& in, M& out)
+    {
+        for (size_t i = 1; i + 1 < N; ++i)
+            for (size_t j = 1; j + 1 < N; ++j)
+                out[i][j] = 4 * in[i][j] - in[i - 1][j] - in[i + 1][j]
+                          - in[i][j - 1] - in[i][j + 1];
+    }
+
+    template <class M>
+    void stencilRowPtr(const M& in, M& out)
+    {
+        for (size_t i = 1; i + 1 < N; ++i) {
+            const float* up = in.row_ptr(i - 1);
+            const float* mid = in.row_ptr(i);
+            const float* down = in.row_ptr(i + 1);
+            float* dst = out.row_ptr(i);
+            for (size_t j = 1; j + 1 < N; ++j)
+                dst[j] = 4 * mid[j] - up[j] - down[j] - mid[j - 1] - mid[j + 1];
+        }
+    }
+
+    template <class M>
+    void stencilSpan(const M& in, M& out)
+    {
+        for (size_t i = 1; i + 1 < N; ++i) {
+            Span<const float> up = in.row_span(i - 1);
+            Span<const float> mid = in.row_span(i);
+            Span<const float> down = in.row_span(i + 1);
+            Span<float> dst = out.row_span(i);
+            for (size_t j = 1; j + 1 < N; ++j)
+                dst[j] = 4 * mid[j] - up[j] - down[j] - mid[j - 1] - mid[j + 1];
+        }
+    }
+
+    template <class M>
+    void stencilData(const M& in, M& out)
+    {
+        const float* src = in.data();
+        float* dst = out.data();
+        for (size_t i = 1; i + 1 < N; ++i)
+            for (size_t j = 1; j + 1 < N; ++j) {
+                const size_t k = i * N + j;
+                dst[k] = 4 * src[k] - src[k - N] - src[k + N] - src[k - 1] - src[k + 1];
+            }
+    }
+
+    template <class M, class F>
+    void run(const char* name, F stencil)
+    {
+        M in(N, N), out(N, N);
+        fill(in);
+        double t = bestOf(3, Iterations, [&] { stencil(in, out); doNotOptimize(out.data()[N + 1]); });
+        double cells = double(N - 2) * double(N - 2) * Iterations;
+        std::printf("  %-28s %8.3f ms  %8.1f Mcell/s\n", name, t * 1e3 / Iterations, cells / t / 1e6);
+    }
+}
+
+int main()
+{
+    using Checked = BasicMatrix<float, CheckedAccess>;
+    using Unchecked = BasicMatrix<float, UncheckedAccess>;
+
+    printHeader("Stencil 1024x1024 float, per sweep");
+    run<Checked>("at()", stencilAt<Checked>);
+    run<Checked>("m[i][j] checked", stencilProxy<Checked>);
+    run<Unchecked>("m[i][j] unchecked", stencilProxy<Unchecked>);
+    run<Checked>("row_ptr(i)", stencilRowPtr<Checked>);
+    run<Checked>("row_span(i)", stencilSpan<Checked>);
+    run<Checked>("data()", stencilData<Checked>);
+    return 0;
+}
@@ -0,0 +1,77 @@
+// Save/load throughput: text (operator<< and a >> reader) vs the binary
+// format vs load_mmap.
+//
+//   bench_matrix_io [n]     n x n int32 matrix, default 4000
+
+#include "../include/Matrix.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+namespace
+{
+    BasicMatrix<int32_t> loadText(const std::string& path, size_t rows, size_t cols)
+    {
+        std::ifstream in(path);
+        BasicMatrix<int32_t> m(rows, cols);
+        for (size_t i = 0; i < rows; ++i)
+            for (size_t j = 0; j < cols; ++j)
+                in >> m[i][j];
+        return m;
+    }
+
+    int64_t checksum(const BasicMatrix<int32_t>& m)
+    {
+        int64_t sum = 0;
+        for (size_t i = 0; i < m.getRows(); ++i) {
+            const int32_t* row = m.row_ptr(i);
+            for (size_t j = 0; j < m.getColumns(); ++j)
+                sum += row[j];
+        }
+        return sum;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4000;
+    BasicMatrix<int32_t> m(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            m.row_ptr(i)[j] = int32_t((i * 2654435761u + j) % 1000003);
+
+    const std::string textPath = "bench_matrix.txt";
+    const std::string binPath = "bench_matrix.bin";
+    const double mb = double(n * n * sizeof(int32_t)) / 1e6;
+
+    char title[64];
+    std::snprintf(title, sizeof(title), "%zu x %zu int32 (%.0f MB in memory)", n, n, mb);
+    printHeader(title);
+
+    const double tTextSave = bestOf(1, 1, [&] { std::ofstream out(textPath); out << m; });
+    const double tBinSave = bestOf(3, 1, [&] { m.save(binPath); });
+    std::printf("  save: text %8.1f ms (%7.1f MB/s) | binary %8.1f ms (%7.1f MB/s)\n",
+                tTextSave * 1e3, mb / tTextSave, tBinSave * 1e3, mb / tBinSave);
+
+    int64_t expected = checksum(m);
+    int64_t got = 0;
+    const double tTextLoad = bestOf(1, 1, [&] { got = checksum(loadText(textPath, n, n)); });
+    if (got != expected) std::printf("  text checksum mismatch!\n");
+    const double tBinLoad = bestOf(3, 1, [&] { got = checksum(BasicMatrix<int32_t>::load(binPath)); });
+    if (got != expected) std::printf("  binary checksum mismatch!\n");
+    const double tMapOpen = bestOf(3, 1, [&] { doNotOptimize(BasicMatrix<int32_t>::load_mmap(binPath).getRows()); });
+    const double tMapLoad = bestOf(3, 1, [&] { got = checksum(BasicMatrix<int32_t>::load_mmap(binPath)); });
+    if (got != expected) std::printf("  mmap checksum mismatch!\n");
+
+    std::printf("  load: text %8.1f ms (%7.1f MB/s) | binary %8.1f ms (%7.1f MB/s)\n",
+                tTextLoad * 1e3, mb / tTextLoad, tBinLoad * 1e3, mb / tBinLoad);
+    std::printf("  load_mmap: open %.3f ms, open + full scan %8.1f ms (%7.1f MB/s)\n",
+                tMapOpen * 1e3, tMapLoad * 1e3, mb / tMapLoad);
+    std::printf("  binary vs text: save %.0fx, load %.0fx\n", tTextSave / tBinSave, tTextLoad / tBinLoad);
+
+    std::remove(textPath.c_str());
+    std::remove(binPath.c_str());
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Reductions on a 4096 x 4096 matrix: a naive loop (column sums walking
+// down each column), matrix_ops with the sequential policy and with the
+// parallel one.
+
+#include "../include/MatrixAlgorithms.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+
+namespace
+{
+    template <class T>
+    matrix_ops::sum_t<T> naiveSum(const BasicMatrix<T>& m)
+    {
+        matrix_ops::sum_t<T> s = 0;
+        for (size_t i = 0; i < m.getRows(); ++i)
+            for (size_t j = 0; j < m.getColumns(); ++j)
+                s += m.at(i, j);
+        return s;
+    }
+
+    template <class T>
+    BasicMatrix<matrix_ops::sum_t<T>> naiveColSums(const BasicMatrix<T>& m)
+    {
+        BasicMatrix<matrix_ops::sum_t<T>> out(1, m.getColumns());
+        for (size_t j = 0; j < m.getColumns(); ++j) {
+            matrix_ops::sum_t<T> s = 0;
+            for (size_t i = 0; i < m.getRows(); ++i)
+                s += m.at(i, j);
+            out.at(0, j) = s;
+        }
+        return out;
+    }
+
+    void line(const char* what, double tNaive, double tSeq, double tPar, double bytes)
+    {
+        if (tNaive > 0)
+            std::printf("  %-10s naive %7.2f ms | seq %7.2f ms (%5.1f GB/s) | par %7.2f ms (%5.1f GB/s)\n",
+                        what, tNaive * 1e3, tSeq * 1e3, bytes / tSeq / 1e9, tPar * 1e3, bytes / tPar / 1e9);
+        else
+            std::printf("  %-10s                  | seq %7.2f ms (%5.1f GB/s) | par %7.2f ms (%5.1f GB/s)\n",
+                        what, tSeq * 1e3, bytes / tSeq / 1e9, tPar * 1e3, bytes / tPar / 1e9);
+    }
+
+    template <class T>
+    void run(const char* type, size_t n)
+    {
+        BasicMatrix<T> m(n, n);
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                m.row_ptr(i)[j] = T(int((i * 31 + j * 17) % 100) - 50);
+        const double bytes = double(n * n * sizeof(T));
+        using matrix_ops::par;
+
+        std::printf(" %s %zu x %zu\n", type, n, n);
+        line("sum",
+             bestOf(3, 1, [&] { doNotOptimize(naiveSum(m)); }),
+             bestOf(5, 1, [&] { doNotOptimize(matrix_ops::sum(m)); }),
+             bestOf(5, 1, [&] { doNotOptimize(matrix_ops::sum(par, m)); }), bytes);
+        line("colSums",
+             bestOf(3, 1, [&] { doNotOptimize(naiveColSums(m).data()[0]); }),
+             bestOf(5, 1, [&] { doNotOptimize(matrix_ops::colSums(m).data()[0]); }),
+             bestOf(5, 1, [&] { doNotOptimize(matrix_ops::colSums(par, m).data()[0]); }), bytes);
+        line("rowSums", 0,
+             bestOf(5, 1, [&] { doNotOptimize(matrix_ops::rowSums(m).data()[0]); }),
+             bestOf(5, 1, [&] { doNotOptimize(matrix_ops::rowSums(par, m).data()[0]); }), bytes);
+        line("max", 0,
+             bestOf(5, 1, [&] { doNotOptimize(matrix_ops::max(m)); }),
+             bestOf(5, 1, [&] { doNotOptimize(matrix_ops::max(par, m)); }), bytes);
+        line("dot", 0,
+             bestOf(5, 1, [&] { doNotOptimize(matrix_ops::dot(m, m)); }),
+             bestOf(5, 1, [&] { doNotOptimize(matrix_ops::dot(par, m, m)); }), bytes);
+        line("norm1", 0,
+             bestOf(5, 1, [&] { doNotOptimize(matrix_ops::norm1(m)); }),
+             bestOf(5, 1, [&] { doNotOptimize(matrix_ops::norm1(par, m)); }), bytes);
+        line("clamp", 0,
+             bestOf(5, 1, [&] { doNotOptimize(matrix_ops::clamp(m, T(-10), T(10)).data()[0]); }),
+             bestOf(5, 1, [&] { doNotOptimize(matrix_ops::clamp(par, m, T(-10), T(10)).data()[0]); }),
+             2 * bytes);
+    }
+}
+
+int main()
+{
+    printHeader("Reductions and element-wise operations");
+    run<float>("float", 4096);
+    run<double>("double", 4096);
+    run<int32_t>("int32", 4096);
+    return 0;
+}
@@ -0,0 +1,78 @@
+// Dense Matrix vs CSR/CSC SparseMatrix: memory, mat-vec and mat-mat
+// throughput at several densities.
+
+#include "../include/SparseMatrix.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+#include <random>
+
+namespace
+{
+    constexpr size_t N = 4000;
+    constexpr size_t RhsColumns = 32;
+
+    BasicMatrix<float> randomSparse(double density, std::mt19937& rng)
+    {
+        BasicMatrix<float> m(N, N);
+        std::uniform_real_distribution<double> coin(0.0, 1.0);
+        std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+        for (size_t i = 0; i < N; ++i) {
+            float* row = m.row_ptr(i);
+            for (size_t j = 0; j < N; ++j)
+                if (coin(rng) < density)
+                    row[j] = value(rng);
+        }
+        return m;
+    }
+
+    void denseMatVec(const BasicMatrix<float>& m, const float* x, float* y)
+    {
+        for (size_t i = 0; i < m.getRows(); ++i) {
+            const float* row = m.row_ptr(i);
+            float sum = 0.0f;
+            for (size_t j = 0; j < m.getColumns(); ++j)
+                sum += row[j] * x[j];
+            y[i] = sum;
+        }
+    }
+}
+
+int main()
+{
+    std::mt19937 rng(42);
+    std::vector<float> x(N, 1.0f), y(N);
+    BasicMatrix<float> rhs(N, RhsColumns);
+    for (size_t i = 0; i < N; ++i)
+        for (size_t j = 0; j < RhsColumns; ++j)
+            rhs[i][j] = float((i + j) % 13) * 0.1f;
+
+    std::printf("N = %zu, %u threads\n", N, unsigned(ThreadPool::instance().concurrency()));
+
+    for (double density : {0.001, 0.01, 0.05, 0.2}) {
+        BasicMatrix<float> dense = randomSparse(density, rng);
+        CsrMatrix<float> csr(dense);
+        CscMatrix<float> csc(dense);
+
+        char title[64];
+        std::snprintf(title, sizeof(title), "density %.1f%% (nnz = %zu)", density * 100, csr.nnz());
+        printHeader(title);
+
+        std::printf("  memory: dense %.1f MB, CSR %.1f MB, CSC %.1f MB\n",
+                    double(N * N * sizeof(float)) / 1e6,
+                    double(csr.memoryBytes()) / 1e6, double(csc.memoryBytes()) / 1e6);
+
+        const double tDense = bestOf(3, 5, [&] { denseMatVec(dense, x.data(), y.data()); doNotOptimize(y[0]); }) / 5;
+        const double tCsr = bestOf(3, 5, [&] { csr.spmv(x.data(), y.data()); doNotOptimize(y[0]); }) / 5;
+        const double tCsc = bestOf(3, 5, [&] { csc.spmv(x.data(), y.data()); doNotOptimize(y[0]); }) / 5;
+        const double tPar = bestOf(3, 5, [&] { csr.spmvParallel(x.data(), y.data()); doNotOptimize(y[0]); }) / 5;
+        std::printf("  mat-vec:  dense %8.3f ms | CSR %8.3f ms | CSC %8.3f ms | CSR parallel %8.3f ms\n",
+                    tDense * 1e3, tCsr * 1e3, tCsc * 1e3, tPar * 1e3);
+
+        const double tDenseMM = bestOf(1, 1, [&] { BasicMatrix<float> c = dense * rhs; doNotOptimize(c.data()[0]); });
+        const double tCsrMM = bestOf(3, 1, [&] { BasicMatrix<float> c = csr * rhs; doNotOptimize(c.data()[0]); });
+        std::printf("  mat-mat (x %zu cols): dense %8.3f ms | CSR %8.3f ms | speedup %.1fx\n",
+                    RhsColumns, tDenseMM * 1e3, tCsrMM * 1e3, tDenseMM / tCsrMM);
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+// Crossover between the blocked kernel and Strassen-Winograd on this
+// machine, for several leaf sizes.
+//
+//   bench_strassen [max_n]     default 2048
+
+#include "../include/Matrix.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    BasicMatrix<float> randomMatrix(size_t n, unsigned seed)
+    {
+        BasicMatrix<float> m(n, n);
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                m.row_ptr(i)[j] = float((i * 7919 + j * 104729 + seed) % 1000) / 500.0f - 1.0f;
+        return m;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const size_t maxN = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2048;
+    const size_t leaves[] = {64, 128, 256};
+
+    std::printf("float, %u threads\n", unsigned(ThreadPool::instance().concurrency()));
+    printHeader("n       blocked      leaf 64     leaf 128     leaf 256   (ms)");
+
+    size_t bestThreshold = 0, bestLeaf = 0;
+    for (size_t n : {256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096}) {
+        if (n > maxN)
+            break;
+        BasicMatrix<float> a = randomMatrix(n, 1);
+        BasicMatrix<float> b = randomMatrix(n, 2);
+        const size_t reps = n <= 512 ? 3 : 1;
+
+        const double tBlocked = bestOf(reps, 1, [&] { doNotOptimize((a * b).data()[0]); });
+        std::printf("%-6zu %9.1f", n, tBlocked * 1e3);
+
+        double bestStrassen = 1e300;
+        size_t leafAtBest = 0;
+        for (size_t leaf : leaves) {
+            if (leaf >= n) {
+                // no recursion at all: same as the blocked kernel
+                std::printf("  %11s", "-");
+                continue;
+            }
+            StrassenOptions opt;
+            opt.leafSize = leaf;
+            const double t = bestOf(reps, 1, [&] { doNotOptimize(multiplyStrassen(a, b, opt).data()[0]); });
+            std::printf("  %11.1f", t * 1e3);
+            if (t < bestStrassen) {
+                bestStrassen = t;
+                leafAtBest = leaf;
+            }
+        }
+        // ask for a clear margin, not timing noise
+        const bool wins = bestStrassen < 0.95 * tBlocked;
+        std::printf("%s\n", wins ? "   <- Strassen wins" : "");
+
+        // first size from which Strassen keeps winning
+        if (wins) {
+            if (bestThreshold == 0) {
+                bestThreshold = n;
+                bestLeaf = leafAtBest;
+            }
+        } else {
+            bestThreshold = 0;
+        }
+    }
+
+    if (bestThreshold != 0)
+        std::printf("\nSuggested: strassenOptions().threshold = %zu, leafSize = %zu\n", bestThreshold, bestLeaf);
+    else
+        std::printf("\nStrassen never won up to n = %zu: keep it disabled\n", maxN);
+    return 0;
+}
@@ -0,0 +1,60 @@
+// Transpose of large non-square matrices: element-by-element copy through
+// at() (what user code did before), a naive raw loop, and
+// Matrix::transpose().
+
+#include "../include/Matrix.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+
+namespace
+{
+    template <class T>
+    BasicMatrix<T> transposeAt(const BasicMatrix<T>& m)
+    {
+        BasicMatrix<T> t(m.getColumns(), m.getRows());
+        for (size_t i = 0; i < m.getRows(); ++i)
+            for (size_t j = 0; j < m.getColumns(); ++j)
+                t.at(j, i) = m.at(i, j);
+        return t;
+    }
+
+    template <class T>
+    BasicMatrix<T> transposeNaive(const BasicMatrix<T>& m)
+    {
+        const size_t rows = m.getRows(), cols = m.getColumns();
+        BasicMatrix<T> t(cols, rows);
+        const T* src = m.data();
+        T* dst = t.data();
+        for (size_t i = 0; i < rows; ++i)
+            for (size_t j = 0; j < cols; ++j)
+                dst[j * rows + i] = src[i * cols + j];
+        return t;
+    }
+
+    template <class T>
+    void run(const char* type, size_t rows, size_t cols)
+    {
+        BasicMatrix<T> m(rows, cols);
+        for (size_t i = 0; i < rows; ++i)
+            for (size_t j = 0; j < cols; ++j)
+                m.row_ptr(i)[j] = T(i + j);
+
+        const double bytes = 2.0 * double(rows * cols * sizeof(T));
+        const double tAt = bestOf(3, 1, [&] { doNotOptimize(transposeAt(m).data()[0]); });
+        const double tNaive = bestOf(3, 1, [&] { doNotOptimize(transposeNaive(m).data()[0]); });
+        const double tBlocked = bestOf(3, 1, [&] { doNotOptimize(m.transpose().data()[0]); });
+        std::printf("  %-6s %5zu x %-5zu  at() %7.2f ms | raw %7.2f ms | transpose() %7.2f ms (%5.2f GB/s)\n",
+                    type, rows, cols, tAt * 1e3, tNaive * 1e3, tBlocked * 1e3, bytes / tBlocked / 1e9);
+    }
+}
+
+int main()
+{
+    printHeader("Transpose");
+    for (auto [rows, cols] : {std::pair<size_t, size_t>{4096, 1024}, {1024, 4096}, {8192, 512}, {3000, 5000}, {4096, 4096}}) {
+        run<float>("float", rows, cols);
+        run<double>("double", rows, cols);
+    }
+    return 0;
+}
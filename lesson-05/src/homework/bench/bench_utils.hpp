@@ -0,0 +1,40 @@
+#ifndef BENCH_UTILS_HPP
+#define BENCH_UTILS_HPP
+
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+
+// Tiny timing helpers shared by the benchmarks in this directory.
+
+// Keeps the optimizer from discarding a computed value.
+template <class T>
+inline void doNotOptimize(const T& value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+// Runs f `iterations` times and returns the best wall time of `repeats`
+// runs, in seconds.
+template <class F>
+double bestOf(size_t repeats, size_t iterations, F&& f)
+{
+    double best = 1e300;
+    for (size_t r = 0; r < repeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+            f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() < best)
+            best = elapsed.count();
+    }
+    return best;
+}
+
+inline void printHeader(const char* title)
+{
+    std::printf("\n%s\n", title);
+    std::printf("========================================\n");
+}
+
+#endif // BENCH_UTILS_HPP
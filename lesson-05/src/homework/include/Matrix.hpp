@@ -1,59 +1,250 @@
 #ifndef MATRIX_HPP
 #define MATRIX_HPP
 
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <stdexcept>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <string>
 
-class Matrix
+#include "MatrixIO.hpp"
+#include "MatrixStorage.hpp"
+#include "Span.hpp"
+
+// Bounds-check policies for Matrix::operator[] (both the row and the column
+// lookup, and the read-only / copy-on-write test of a mutable row access).
+// at() always throws on a bad index, like std::vector::at.
+struct CheckedAccess
+{
+    static constexpr bool checksWrites = true;
+
+    static void check(size_t i, size_t size, const char* what)
+    {
+        if (i >= size)
+            throw std::out_of_range(what);
+    }
+
+    static void checkWritable(bool writable)
+    {
+        if (!writable)
+            throw std::logic_error("Matrix is read-only");
+    }
+};
+
+// No check in release builds: m[i][j] compiles down to a plain load, so user
+// loops over it can be vectorized. Debug builds still assert. Even a cold
+// copy-on-write branch would keep such loops scalar, so matrices with this
+// policy cannot use copy-on-write.
+struct UncheckedAccess
+{
+    static constexpr bool checksWrites = false;
+
+    static void check([[maybe_unused]] size_t i, [[maybe_unused]] size_t size, const char*) noexcept
+    {
+        assert(i < size);
+    }
+
+    static void checkWritable([[maybe_unused]] bool writable) noexcept
+    {
+        assert(writable);
+    }
+};
+
+template <class T>
+class MatrixView;
+
+// Dense row-major matrix. Elements are stored in one contiguous, 64-byte
+// aligned buffer so that the kernels in MatrixKernels.hpp can vectorize.
+//
+// Matrix, the int32_t instantiation, keeps the pre-template class working
+// as it was: `Matrix m(3, 3);`, `const Matrix&`, `Matrix::load(...)`.
+// Access selects the bounds-check policy of operator[]; hot loops can also
+// bypass it entirely through data() / row_ptr() / row_span().
+template <class T, class Access = CheckedAccess>
+class BasicMatrix
 {
     private:
         class ProxyRow
         {
         private:
-            int32_t* data_;
+            friend class BasicMatrix;
+            T* data_;
             size_t cols_;
         public:
             ProxyRow();
-            ProxyRow(int32_t* row_data, size_t cols);
-            int32_t& operator[](size_t j);
-            const int32_t& operator[](size_t j) const;
+            ProxyRow(T* row_data, size_t cols);
+            T& operator[](size_t j);
+            const T& operator[](size_t j) const;
         };
 
-        int32_t** data_;
+        T* data_;
         size_t rows_;
         size_t cols_;
+        matrix_detail::StorageBlock* block_; // owns data_ (heap or mapped file), maybe shared
+        bool writable_;                      // data_ can be written in place without further checks
+        bool copyOnWrite_;                   // copies share block_ until one of them writes
+
+        // The rows_ rows of data_, which operator[] returns by reference.
+        // Kept up to date wherever data_ or the shape changes, so operator[]
+        // has nothing to check: it lives in the same block as the elements
+        // (see allocate()), or in ownRows_ for a block this class did not
+        // allocate (a mapped file).
         ProxyRow* rows_data_;
+        std::unique_ptr<ProxyRow[]> ownRows_;
+
+        // fresh block for data_ and rows_data_, from `resource` or the
+        // aligned heap if null
+        void allocate(size_t rows, size_t cols, std::pmr::memory_resource* resource = nullptr);
+        static size_t rowsOffset(size_t count);
+        void fillRows(size_t rows, size_t cols) noexcept;
+        void releaseStorage();
+        void shareStorage(const BasicMatrix& other);
+
+        // Called before every mutable access; the test is inline, the work is
+        // not. Copy-on-write matrices get a private block if theirs is shared
+        // (or mapped); other read-only matrices throw std::logic_error.
+        void prepareWrite();
+        void makeWritable();
+
+        // adopts a block that already holds rows * cols elements at `data`
+        BasicMatrix(matrix_detail::StorageBlock* block, T* data, size_t rows, size_t cols);
 
     public:
+        using value_type = T;
+        using access_policy = Access;
+
+        static constexpr size_t Alignment = 64;
+
         // ctors / assignment
-        Matrix(size_t rows, size_t cols);
-        Matrix(const Matrix& other);
-        Matrix(Matrix&& other) noexcept;
-        Matrix& operator=(const Matrix& other);
-        Matrix& operator=(Matrix&& other) noexcept;
-        ~Matrix();
+        //
+        // The element buffer comes from `resource` when one is given (e.g. a
+        // std::pmr::monotonic_buffer_resource or a MatrixArena for a batch of
+        // temporaries), otherwise from the aligned global heap. The resource
+        // must outlive the matrix. Like pmr containers, deep copies use the
+        // heap unless a resource is passed and copy assignment keeps the
+        // target's resource; moves (and copy-on-write sharing) carry the
+        // buffer along. Results of +, * and transpose() use the resource of
+        // the left operand.
+        BasicMatrix(size_t rows, size_t cols, std::pmr::memory_resource* resource = nullptr);
+        explicit BasicMatrix(MatrixView<const T> view, std::pmr::memory_resource* resource = nullptr); // deep copy of a view
+        BasicMatrix(const BasicMatrix& other);
+        BasicMatrix(const BasicMatrix& other, std::pmr::memory_resource* resource);
+        BasicMatrix(BasicMatrix&& other) noexcept;
+        BasicMatrix& operator=(const BasicMatrix& other);
+        BasicMatrix& operator=(BasicMatrix&& other) noexcept;
+        ~BasicMatrix();
 
         // access
-        int32_t& at(size_t i, size_t j);
-        const int32_t& at(size_t i, size_t j) const;
+        T& at(size_t i, size_t j);
+        const T& at(size_t i, size_t j) const;
 
         size_t getColumns() const;
         size_t getRows() const;
 
+        // resource the buffer was allocated from; null for heap and mapped buffers
+        std::pmr::memory_resource* resource() const;
+
+        // raw access, no bounds checks (asserted in debug builds);
+        // rows are contiguous and row i starts at data() + i * getColumns()
+        T* data();
+        const T* data() const;
+        T* row_ptr(size_t i);
+        const T* row_ptr(size_t i) const;
+        Span<T> row_span(size_t i);
+        Span<const T> row_span(size_t i) const;
+
+        // non-owning views (see MatrixView.hpp)
+        MatrixView<T> view();
+        MatrixView<const T> view() const;
+        MatrixView<T> submatrix(size_t row, size_t col, size_t rows, size_t cols);
+        MatrixView<const T> submatrix(size_t row, size_t col, size_t rows, size_t cols) const;
+        MatrixView<T> row(size_t i);
+        MatrixView<const T> row(size_t i) const;
+        MatrixView<T> col(size_t j);
+        MatrixView<const T> col(size_t j) const;
+        MatrixView<T> strided(size_t row, size_t col, size_t rows, size_t cols, size_t rowStep, size_t colStep);
+        MatrixView<const T> strided(size_t row, size_t col, size_t rows, size_t cols, size_t rowStep, size_t colStep) const;
+
+        operator MatrixView<const T>() const { return view(); }
+
+        // Binary format (see MatrixIO.hpp). Errors throw std::runtime_error.
+        void save(std::ostream& out) const;
+        void save(const std::string& path) const;
+        static BasicMatrix load(std::istream& in);
+        static BasicMatrix load(const std::string& path);
+
+        // Maps a file written by save() and uses it in place as read-only
+        // storage: nothing is copied, pages are read on first access.
+        // Mutable access to such a matrix throws std::logic_error (only
+        // asserted by operator[] under UncheckedAccess); copies of it are
+        // ordinary heap matrices, unless copy-on-write is enabled.
+        static BasicMatrix load_mmap(const std::string& path);
+        bool isReadOnly() const;
+
+        // Copy-on-write mode (off by default). Copies of a copy-on-write
+        // matrix share its buffer and inherit the mode; the first mutable
+        // access (at(), operator[], data(), row_ptr(), view(), ...) of a
+        // matrix whose buffer is shared makes a private copy first. A mapped
+        // matrix in this mode is copied on its first write instead of
+        // throwing.
+        //
+        // The mutable overloads detach even when only used to read: read
+        // shared matrices through a const reference.
+        // Pointers and views obtained through a mutable accessor write into
+        // the buffer the matrix had at that time: do not keep them across a
+        // copy of the matrix. Turning the mode off unshares the buffer.
+        // Enabling it on an UncheckedAccess matrix throws std::logic_error.
+        void setCopyOnWrite(bool enabled);
+        bool isCopyOnWrite() const;
+        bool isShared() const; // buffer used by several matrices
+
+        // new getColumns() x getRows() matrix (cache-oblivious blocked copy)
+        BasicMatrix transpose() const;
+
         // arithmetic
-        Matrix& operator*=(int32_t val);
-        Matrix operator+(const Matrix& other) const;
+        BasicMatrix& operator*=(T val);
+        BasicMatrix operator+(const BasicMatrix& other) const;
+        BasicMatrix operator*(const BasicMatrix& other) const; // matrix product
 
         // comparisons
-        bool operator==(const Matrix& other) const;
-        bool operator!=(const Matrix& other) const;
+        bool operator==(const BasicMatrix& other) const;
+        bool operator!=(const BasicMatrix& other) const;
 
-        // proxy access
+        // proxy access. Like a pointer from data(), a row obtained from the
+        // mutable overload writes into the buffer the matrix had at that
+        // time.
         ProxyRow& operator[](size_t i);
         const ProxyRow operator[](size_t i) const;
 
-        friend std::ostream& operator<<(std::ostream& os, const Matrix& m);
+        friend std::ostream& operator<<(std::ostream& os, const BasicMatrix& m)
+        {
+            for (size_t i = 0; i < m.rows_; i++)
+            {
+                for (size_t j = 0; j < m.cols_; j++)
+                    os << +m.data_[i * m.cols_ + j] << ' '; // unary + prints int8_t as a number
+                os << '\n';
+            }
+            return os;
+        }
 };
 
-#endif // MATRIX_HPP
\ No newline at end of file
+using Matrix = BasicMatrix<int32_t>;
+
+#include "MatrixView.hpp"
+#include "Matrix.tpp"
+
+// Instantiated once in src/Matrix.cpp.
+extern template class BasicMatrix<int8_t>;
+extern template class BasicMatrix<int16_t>;
+extern template class BasicMatrix<int32_t>;
+extern template class BasicMatrix<int64_t>;
+extern template class BasicMatrix<float>;
+extern template class BasicMatrix<double>;
+extern template class BasicMatrix<int32_t, UncheckedAccess>;
+extern template class BasicMatrix<float, UncheckedAccess>;
+extern template class BasicMatrix<double, UncheckedAccess>;
+
+#endif // MATRIX_HPP
@@ -0,0 +1,605 @@
+#include "MatrixKernels.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <new>
+
+// Element accessors are declared inline so that they are still expanded at
+// the call site for the types instantiated in src/Matrix.cpp (an extern
+// template declaration does not suppress inline functions).
+
+// ProxyRow
+
+template <class T, class Access>
+inline BasicMatrix<T, Access>::ProxyRow::ProxyRow() : data_(nullptr), cols_(0) {}
+
+template <class T, class Access>
+inline BasicMatrix<T, Access>::ProxyRow::ProxyRow(T* row_data, size_t cols) : data_(row_data), cols_(cols) {}
+
+template <class T, class Access>
+inline T& BasicMatrix<T, Access>::ProxyRow::operator[](size_t j)
+{
+    Access::check(j, cols_, "Column index out of range");
+    return data_[j];
+}
+
+template <class T, class Access>
+inline const T& BasicMatrix<T, Access>::ProxyRow::operator[](size_t j) const
+{
+    Access::check(j, cols_, "Column index out of range");
+    return data_[j];
+}
+
+// Storage
+
+// Blocks this class allocates hold the elements, then the row table
+// (aligned for ProxyRow after the last element).
+template <class T, class Access>
+size_t BasicMatrix<T, Access>::rowsOffset(size_t count)
+{
+    return (count * sizeof(T) + alignof(ProxyRow) - 1) / alignof(ProxyRow) * alignof(ProxyRow);
+}
+
+template <class T, class Access>
+void BasicMatrix<T, Access>::allocate(size_t rows, size_t cols, std::pmr::memory_resource* resource)
+{
+    const size_t bytes = rowsOffset(rows * cols) + rows * sizeof(ProxyRow);
+    void* data = nullptr;
+    block_ = resource
+        ? matrix_detail::ResourceStorage<Alignment>::allocate(resource, bytes, &data)
+        : matrix_detail::HeapStorage<Alignment>::allocate(bytes, &data);
+    data_ = static_cast<T*>(data);
+    ownRows_.reset();
+    rows_data_ = reinterpret_cast<ProxyRow*>(static_cast<char*>(data) + rowsOffset(rows * cols));
+    fillRows(rows, cols);
+    writable_ = !copyOnWrite_;
+}
+
+template <class T, class Access>
+void BasicMatrix<T, Access>::fillRows(size_t rows, size_t cols) noexcept
+{
+    for (size_t i = 0; i < rows; i++)
+        new (&rows_data_[i]) ProxyRow(data_ + i * cols, cols);
+}
+
+template <class T, class Access>
+void BasicMatrix<T, Access>::releaseStorage()
+{
+    matrix_detail::release(block_);
+    block_ = nullptr;
+    data_ = nullptr;
+    rows_data_ = nullptr;
+    ownRows_.reset();
+    writable_ = !copyOnWrite_;
+}
+
+// Makes this matrix use other's block (copy-on-write copies), and its row
+// table unless that one belongs to other alone (mapped files).
+template <class T, class Access>
+void BasicMatrix<T, Access>::shareStorage(const BasicMatrix& other)
+{
+    std::unique_ptr<ProxyRow[]> ownRows;
+    if (other.ownRows_) {
+        ownRows.reset(new ProxyRow[other.rows_]);
+        std::copy_n(other.ownRows_.get(), other.rows_, ownRows.get());
+    }
+    matrix_detail::retain(other.block_);
+    matrix_detail::release(block_);
+    block_ = other.block_;
+    data_ = other.data_;
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    ownRows_ = std::move(ownRows);
+    rows_data_ = ownRows_ ? ownRows_.get() : other.rows_data_;
+    copyOnWrite_ = true;
+    writable_ = false;
+}
+
+template <class T, class Access>
+inline void BasicMatrix<T, Access>::prepareWrite()
+{
+    if (!writable_)
+        makeWritable();
+}
+
+template <class T, class Access>
+void BasicMatrix<T, Access>::makeWritable()
+{
+    if (!copyOnWrite_) {
+        CheckedAccess::checkWritable(writable_);
+        return;
+    }
+    // Copy-on-write matrices never cache writable_ = true: a copy made
+    // through a const reference shares the block without touching the
+    // source, so the reference count is the only reliable test.
+    if (!block_ || (block_->writable && block_->refs.load(std::memory_order_acquire) == 1))
+        return;
+
+    matrix_detail::StorageBlock* old = block_;
+    const T* src = data_;
+    allocate(rows_, cols_, old->resource);
+    std::copy_n(src, rows_ * cols_, data_);
+    matrix_detail::release(old);
+}
+
+template <class T, class Access>
+void BasicMatrix<T, Access>::setCopyOnWrite(bool enabled)
+{
+    if (enabled == copyOnWrite_)
+        return;
+    if (enabled) {
+        if (!Access::checksWrites)
+            throw std::logic_error("copy-on-write needs CheckedAccess");
+        copyOnWrite_ = true;
+        writable_ = false;
+        return;
+    }
+    if (isShared()) {
+        makeWritable();
+        copyOnWrite_ = false;
+        writable_ = true;
+        return;
+    }
+    copyOnWrite_ = false;
+    writable_ = !block_ || block_->writable;
+}
+
+template <class T, class Access>
+bool BasicMatrix<T, Access>::isCopyOnWrite() const
+{
+    return copyOnWrite_;
+}
+
+template <class T, class Access>
+bool BasicMatrix<T, Access>::isShared() const
+{
+    return block_ && block_->refs.load(std::memory_order_acquire) > 1;
+}
+
+// A block allocated elsewhere (a mapped file) has no room for the row
+// table: this matrix gets one of its own.
+template <class T, class Access>
+BasicMatrix<T, Access>::BasicMatrix(matrix_detail::StorageBlock* block, T* data, size_t rows, size_t cols)
+    : data_(data), rows_(rows), cols_(cols), block_(block), writable_(!block || block->writable),
+      copyOnWrite_(false), rows_data_(nullptr)
+{
+    if (!block)
+        return;
+    try {
+        ownRows_.reset(new ProxyRow[rows_]);
+    } catch (...) {
+        matrix_detail::release(block_);
+        throw;
+    }
+    rows_data_ = ownRows_.get();
+    fillRows(rows_, cols_);
+}
+
+// Normal constructor
+template <class T, class Access>
+BasicMatrix<T, Access>::BasicMatrix(size_t r, size_t c, std::pmr::memory_resource* resource)
+    : data_(nullptr), rows_(r), cols_(c), block_(nullptr), writable_(true), copyOnWrite_(false),
+      rows_data_(nullptr)
+{
+    if (rows_ == 0 || cols_ == 0)
+        throw std::invalid_argument("rows and cols must be > 0");
+
+    allocate(rows_, cols_, resource);
+    std::fill_n(data_, rows_ * cols_, T());
+}
+
+// Copy of a view
+template <class T, class Access>
+BasicMatrix<T, Access>::BasicMatrix(MatrixView<const T> view, std::pmr::memory_resource* resource)
+    : BasicMatrix(view.getRows(), view.getColumns(), resource)
+{
+    matrix_kernels::copy(rows_, cols_, view.data(), view.rowStride(), view.colStride(),
+                         data_, cols_, size_t(1));
+}
+
+// Copy constructor
+template <class T, class Access>
+BasicMatrix<T, Access>::BasicMatrix(const BasicMatrix& other)
+    : data_(nullptr), rows_(other.rows_), cols_(other.cols_), block_(nullptr), writable_(true),
+      copyOnWrite_(false), rows_data_(nullptr)
+{
+    if (other.copyOnWrite_ && other.block_) {
+        shareStorage(other);
+        return;
+    }
+    allocate(rows_, cols_);
+    std::copy_n(other.data_, rows_ * cols_, data_);
+}
+
+// Copy into a given resource (always a deep copy)
+template <class T, class Access>
+BasicMatrix<T, Access>::BasicMatrix(const BasicMatrix& other, std::pmr::memory_resource* resource)
+    : data_(nullptr), rows_(other.rows_), cols_(other.cols_), block_(nullptr), writable_(true),
+      copyOnWrite_(other.copyOnWrite_), rows_data_(nullptr)
+{
+    allocate(rows_, cols_, resource);
+    std::copy_n(other.data_, rows_ * cols_, data_);
+}
+
+// Move constructor
+template <class T, class Access>
+BasicMatrix<T, Access>::BasicMatrix(BasicMatrix&& other) noexcept
+    : data_(other.data_), rows_(other.rows_), cols_(other.cols_), block_(other.block_),
+      writable_(other.writable_), copyOnWrite_(other.copyOnWrite_), rows_data_(other.rows_data_),
+      ownRows_(std::move(other.ownRows_))
+{
+    other.data_ = nullptr;
+    other.block_ = nullptr;
+    other.rows_data_ = nullptr;
+    other.writable_ = true;
+    other.rows_ = 0;
+    other.cols_ = 0;
+}
+
+// Copy assignment
+template <class T, class Access>
+BasicMatrix<T, Access>& BasicMatrix<T, Access>::operator=(const BasicMatrix& other)
+{
+    if (this == &other) return *this;
+
+    if (other.copyOnWrite_ && other.block_) {
+        shareStorage(other);
+        return *this;
+    }
+    copyOnWrite_ = false;
+
+    // reuse the buffer (and its row table) when the shape does not change
+    if (rows_ != other.rows_ || cols_ != other.cols_ || !block_ || !block_->writable
+        || block_->refs.load(std::memory_order_acquire) != 1) {
+        matrix_detail::StorageBlock* old = block_;
+        allocate(other.rows_, other.cols_, resource());
+        matrix_detail::release(old);
+    }
+    writable_ = true;
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    std::copy_n(other.data_, rows_ * cols_, data_);
+
+    return *this;
+}
+
+// Move assignment
+template <class T, class Access>
+BasicMatrix<T, Access>& BasicMatrix<T, Access>::operator=(BasicMatrix&& other) noexcept
+{
+    if (this == &other) return *this;
+
+    releaseStorage();
+
+    data_ = other.data_;
+    block_ = other.block_;
+    rows_data_ = other.rows_data_;
+    ownRows_ = std::move(other.ownRows_);
+    writable_ = other.writable_;
+    copyOnWrite_ = other.copyOnWrite_;
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+
+    other.data_ = nullptr;
+    other.block_ = nullptr;
+    other.rows_data_ = nullptr;
+    other.writable_ = true;
+    other.rows_ = 0;
+    other.cols_ = 0;
+
+    return *this;
+}
+
+template <class T, class Access>
+inline size_t BasicMatrix<T, Access>::getRows() const { return rows_; }
+
+template <class T, class Access>
+inline size_t BasicMatrix<T, Access>::getColumns() const { return cols_; }
+
+template <class T, class Access>
+std::pmr::memory_resource* BasicMatrix<T, Access>::resource() const
+{
+    return block_ ? block_->resource : nullptr;
+}
+
+template <class T, class Access>
+BasicMatrix<T, Access>::~BasicMatrix()
+{
+    releaseStorage();
+}
+
+template <class T, class Access>
+inline T* BasicMatrix<T, Access>::data()
+{
+    prepareWrite();
+    return data_;
+}
+
+template <class T, class Access>
+inline const T* BasicMatrix<T, Access>::data() const { return data_; }
+
+template <class T, class Access>
+inline T* BasicMatrix<T, Access>::row_ptr(size_t i)
+{
+    assert(i < rows_);
+    prepareWrite();
+    return data_ + i * cols_;
+}
+
+template <class T, class Access>
+inline const T* BasicMatrix<T, Access>::row_ptr(size_t i) const
+{
+    assert(i < rows_);
+    return data_ + i * cols_;
+}
+
+template <class T, class Access>
+inline Span<T> BasicMatrix<T, Access>::row_span(size_t i)
+{
+    return Span<T>(row_ptr(i), cols_);
+}
+
+template <class T, class Access>
+inline Span<const T> BasicMatrix<T, Access>::row_span(size_t i) const
+{
+    return Span<const T>(row_ptr(i), cols_);
+}
+
+template <class T, class Access>
+inline T& BasicMatrix<T, Access>::at(size_t i, size_t j)
+{
+    if (i >= rows_ || j >= cols_)
+        throw std::out_of_range("Matrix indice out of range");
+    prepareWrite();
+    return data_[i * cols_ + j];
+}
+
+template <class T, class Access>
+inline const T& BasicMatrix<T, Access>::at(size_t i, size_t j) const
+{
+    if (i >= rows_ || j >= cols_)
+        throw std::out_of_range("Matrix indice out of range");
+    return data_[i * cols_ + j];
+}
+
+// Views
+
+template <class T, class Access>
+MatrixView<T> BasicMatrix<T, Access>::view()
+{
+    prepareWrite();
+    return MatrixView<T>(data_, rows_, cols_, cols_);
+}
+
+template <class T, class Access>
+MatrixView<const T> BasicMatrix<T, Access>::view() const
+{
+    return MatrixView<const T>(data_, rows_, cols_, cols_);
+}
+
+template <class T, class Access>
+MatrixView<T> BasicMatrix<T, Access>::submatrix(size_t row, size_t col, size_t rows, size_t cols)
+{
+    return view().submatrix(row, col, rows, cols);
+}
+
+template <class T, class Access>
+MatrixView<const T> BasicMatrix<T, Access>::submatrix(size_t row, size_t col, size_t rows, size_t cols) const
+{
+    return view().submatrix(row, col, rows, cols);
+}
+
+template <class T, class Access>
+MatrixView<T> BasicMatrix<T, Access>::row(size_t i) { return view().row(i); }
+
+template <class T, class Access>
+MatrixView<const T> BasicMatrix<T, Access>::row(size_t i) const { return view().row(i); }
+
+template <class T, class Access>
+MatrixView<T> BasicMatrix<T, Access>::col(size_t j) { return view().col(j); }
+
+template <class T, class Access>
+MatrixView<const T> BasicMatrix<T, Access>::col(size_t j) const { return view().col(j); }
+
+template <class T, class Access>
+MatrixView<T> BasicMatrix<T, Access>::strided(size_t row, size_t col, size_t rows, size_t cols,
+                                         size_t rowStep, size_t colStep)
+{
+    return view().strided(row, col, rows, cols, rowStep, colStep);
+}
+
+template <class T, class Access>
+MatrixView<const T> BasicMatrix<T, Access>::strided(size_t row, size_t col, size_t rows, size_t cols,
+                                               size_t rowStep, size_t colStep) const
+{
+    return view().strided(row, col, rows, cols, rowStep, colStep);
+}
+
+template <class T, class Access>
+BasicMatrix<T, Access> BasicMatrix<T, Access>::transpose() const
+{
+    BasicMatrix result(cols_, rows_, resource());
+    matrix_kernels::transpose(rows_, cols_, data_, cols_, result.data_, rows_);
+    return result;
+}
+
+template <class T, class Access>
+BasicMatrix<T, Access>& BasicMatrix<T, Access>::operator*=(T val)
+{
+    prepareWrite();
+    matrix_kernels::scale(data_, val, rows_ * cols_);
+    return *this;
+}
+
+template <class T, class Access>
+BasicMatrix<T, Access> BasicMatrix<T, Access>::operator+(const BasicMatrix& other) const
+{
+    if (other.rows_ == rows_ && other.cols_ == cols_)
+    {
+        BasicMatrix result(rows_, cols_, resource());
+        matrix_kernels::add(data_, other.data_, result.data_, rows_ * cols_);
+        return result;
+    }
+    else
+        throw std::invalid_argument("Matrices sizes do not match");
+}
+
+template <class T, class Access>
+BasicMatrix<T, Access> BasicMatrix<T, Access>::operator*(const BasicMatrix& other) const
+{
+    if (cols_ != other.rows_)
+        throw std::invalid_argument("Matrices sizes do not match");
+
+    BasicMatrix result(rows_, other.cols_, resource());
+
+    const StrassenOptions& strassen = strassenOptions();
+    if (strassen.threshold != 0 && rows_ >= strassen.threshold
+        && rows_ == cols_ && other.rows_ == other.cols_) {
+        matrix_detail::strassen(rows_, data_, cols_, other.data_, other.cols_, result.data_, rows_, strassen);
+        return result;
+    }
+
+    matrix_kernels::gemm(rows_, other.cols_, cols_,
+                         data_, cols_,
+                         other.data_, other.cols_,
+                         result.data_, result.cols_);
+    return result;
+}
+
+template <class T, class Access>
+bool BasicMatrix<T, Access>::operator==(const BasicMatrix& other) const
+{
+    if (other.rows_ != rows_ || other.cols_ != cols_)
+        return false;
+    if constexpr (!std::is_floating_point_v<T>) {
+        if (data_ == other.data_)
+            return true; // same (shared) buffer; NaN != NaN forbids this for floats
+    }
+
+    return matrix_kernels::equal(data_, other.data_, rows_ * cols_);
+}
+
+template <class T, class Access>
+bool BasicMatrix<T, Access>::operator!=(const BasicMatrix& other) const
+{
+    return !(*this == other);
+}
+
+template <class T, class Access>
+inline typename BasicMatrix<T, Access>::ProxyRow& BasicMatrix<T, Access>::operator[](size_t i)
+{
+    Access::check(i, rows_, "Row index out of range");
+    if constexpr (Access::checksWrites)
+        prepareWrite();
+    else
+        Access::checkWritable(writable_);
+    return rows_data_[i];
+}
+
+template <class T, class Access>
+inline const typename BasicMatrix<T, Access>::ProxyRow BasicMatrix<T, Access>::operator[](size_t i) const
+{
+    Access::check(i, rows_, "Row index out of range");
+    return ProxyRow(data_ + i * cols_, cols_);
+}
+
+// Binary I/O
+
+template <class T, class Access>
+bool BasicMatrix<T, Access>::isReadOnly() const
+{
+    return block_ && !block_->writable;
+}
+
+template <class T, class Access>
+void BasicMatrix<T, Access>::save(std::ostream& out) const
+{
+    const matrix_io::FileHeader header =
+        matrix_io::makeHeader(matrix_io::ElementTypeOf<T>::value, sizeof(T), rows_, cols_);
+    char padded[matrix_io::DataOffset] = {};
+    std::memcpy(padded, &header, sizeof(header));
+
+    out.write(padded, sizeof(padded));
+    out.write(reinterpret_cast<const char*>(data_), std::streamsize(rows_ * cols_ * sizeof(T)));
+    if (!out)
+        throw std::runtime_error("cannot write matrix");
+}
+
+template <class T, class Access>
+void BasicMatrix<T, Access>::save(const std::string& path) const
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        throw std::runtime_error("cannot open " + path);
+    save(out);
+}
+
+template <class T, class Access>
+BasicMatrix<T, Access> BasicMatrix<T, Access>::load(std::istream& in)
+{
+    matrix_io::FileHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        throw std::runtime_error("cannot read matrix header");
+    matrix_io::checkHeader(header, matrix_io::ElementTypeOf<T>::value, sizeof(T));
+    in.ignore(std::streamsize(header.dataOffset - sizeof(header)));
+    const uint64_t bytes = header.rows * header.cols * sizeof(T);
+
+    // The dimensions come from the file, so nothing is allocated for them
+    // until the data is known to be there: a seekable stream is measured
+    // first, any other one is staged in a buffer that starts at 64KB and
+    // doubles as it fills, so that a corrupted header fails at the end of
+    // the input rather than in a huge allocation.
+    std::unique_ptr<char[]> staged;
+    const std::streampos start = in.tellg();
+    if (start != std::streampos(-1)) {
+        in.seekg(0, std::ios::end);
+        const std::streampos end = in.tellg();
+        in.seekg(start);
+        if (!in || end < start || uint64_t(end - start) < bytes)
+            throw std::runtime_error("matrix data is truncated");
+    } else {
+        uint64_t capacity = 0, size = 0;
+        while (size < bytes) {
+            if (size == capacity) {
+                capacity = std::min<uint64_t>(bytes, std::max<uint64_t>(capacity * 2, 1 << 16));
+                std::unique_ptr<char[]> grown(new char[size_t(capacity)]);
+                if (size != 0)
+                    std::memcpy(grown.get(), staged.get(), size_t(size));
+                staged = std::move(grown);
+            }
+            const uint64_t chunk = std::min<uint64_t>(capacity - size, 1 << 16);
+            if (!in.read(staged.get() + size, std::streamsize(chunk)))
+                throw std::runtime_error("matrix data is truncated");
+            size += chunk;
+        }
+    }
+
+    BasicMatrix result(static_cast<matrix_detail::StorageBlock*>(nullptr), nullptr, size_t(header.rows), size_t(header.cols));
+    result.allocate(result.rows_, result.cols_);
+    if (start == std::streampos(-1))
+        std::memcpy(result.data_, staged.get(), size_t(bytes));
+    else if (!in.read(reinterpret_cast<char*>(result.data_), std::streamsize(bytes)))
+        throw std::runtime_error("matrix data is truncated");
+    return result;
+}
+
+template <class T, class Access>
+BasicMatrix<T, Access> BasicMatrix<T, Access>::load(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        throw std::runtime_error("cannot open " + path);
+    return load(in);
+}
+
+template <class T, class Access>
+BasicMatrix<T, Access> BasicMatrix<T, Access>::load_mmap(const std::string& path)
+{
+    matrix_io::FileHeader header;
+    const void* data = nullptr;
+    matrix_detail::StorageBlock* block =
+        matrix_io::mapFile(path, matrix_io::ElementTypeOf<T>::value, sizeof(T), header, &data);
+    // the block is never written through: every mutable accessor checks it
+    return BasicMatrix(block, static_cast<T*>(const_cast<void*>(data)), size_t(header.rows), size_t(header.cols));
+}
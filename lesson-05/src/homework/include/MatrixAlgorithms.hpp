@@ -0,0 +1,533 @@
+#ifndef MATRIX_ALGORITHMS_HPP
+#define MATRIX_ALGORITHMS_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Matrix.hpp"
+#include "MatrixKernels.hpp"
+#include "ThreadPool.hpp"
+
+// Reductions and element-wise operations on any matrix-like value
+// (BasicMatrix<T, Access> or MatrixView<T>).
+//
+// Every function takes an optional execution policy as first argument:
+// matrix_ops::seq (the default) runs on the calling thread, matrix_ops::par
+// splits the rows over a ThreadPool. Rows are always traversed in memory
+// order; column reductions keep one accumulator per column and update it
+// row by row, so they never walk down a column of a row-major matrix.
+//
+// Sums of integers are computed in 64 bits (sum_t<T>), floating point sums
+// in T. Parallel floating point sums combine per-chunk partial results and
+// may differ from the sequential ones in the last bits.
+
+namespace matrix_ops
+{
+    struct Sequential {};
+
+    struct Parallel
+    {
+        // nullptr: ThreadPool::instance()
+        ThreadPool* pool = nullptr;
+    };
+
+    inline constexpr Sequential seq{};
+    inline constexpr Parallel par{};
+
+    template <class T>
+    using sum_t = std::conditional_t<
+        std::is_integral_v<T>,
+        std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>,
+        T>;
+
+    namespace detail
+    {
+        // Minimum number of elements handed to one task.
+        constexpr size_t ParallelGrain = size_t(1) << 15;
+
+        inline size_t rowGrain(size_t cols)
+        {
+            return std::max<size_t>(1, ParallelGrain / std::max<size_t>(cols, 1));
+        }
+
+        inline ThreadPool& poolOf(const Parallel& p)
+        {
+            return p.pool ? *p.pool : ThreadPool::instance();
+        }
+
+        // f(lo, hi) over row ranges covering [0, rows)
+        template <class F>
+        void forRows(Sequential, size_t rows, size_t, F&& f)
+        {
+            f(size_t(0), rows);
+        }
+
+        template <class F>
+        void forRows(const Parallel& p, size_t rows, size_t cols, F&& f)
+        {
+            parallelFor(0, rows, rowGrain(cols), f, poolOf(p));
+        }
+
+        // Folds chunk(lo, hi) results over row ranges with combine(acc, part).
+        template <class Chunk, class Combine>
+        auto reduceRows(Sequential, size_t rows, size_t, Chunk&& chunk, Combine&&)
+        {
+            return chunk(size_t(0), rows);
+        }
+
+        template <class Chunk, class Combine>
+        auto reduceRows(const Parallel& p, size_t rows, size_t cols, Chunk&& chunk, Combine&& combine)
+        {
+            ThreadPool& pool = poolOf(p);
+            const size_t grain = rowGrain(cols);
+            const size_t chunks = std::min(pool.concurrency() * 4, (rows + grain - 1) / grain);
+            if (chunks <= 1)
+                return chunk(size_t(0), rows);
+
+            using R = decltype(chunk(size_t(0), rows));
+            const size_t step = (rows + chunks - 1) / chunks;
+            std::vector<R> partials((rows + step - 1) / step);
+            {
+                TaskGroup group(pool);
+                for (size_t c = 1; c < partials.size(); ++c)
+                    group.run([&, c] { partials[c] = chunk(c * step, std::min(rows, (c + 1) * step)); });
+                partials[0] = chunk(size_t(0), std::min(rows, step));
+                group.wait();
+            }
+            R result = std::move(partials[0]);
+            for (size_t c = 1; c < partials.size(); ++c)
+                combine(result, partials[c]);
+            return result;
+        }
+
+        // Calls f(i, row) for rows [lo, hi) of v with `row` pointing to
+        // v.getColumns() contiguous elements. Views with a column stride are
+        // gathered one row at a time into a scratch buffer.
+        template <class T, class F>
+        void forEachRow(MatrixView<const T> v, size_t lo, size_t hi, F&& f)
+        {
+            if (v.rowsContiguous()) {
+                for (size_t i = lo; i < hi; ++i)
+                    f(i, v.row_ptr(i));
+                return;
+            }
+            std::vector<T> row(v.getColumns());
+            for (size_t i = lo; i < hi; ++i) {
+                for (size_t j = 0; j < row.size(); ++j)
+                    row[j] = v(i, j);
+                f(i, static_cast<const T*>(row.data()));
+            }
+        }
+
+        template <class A, class B>
+        void checkSameSize(const A& a, const B& b)
+        {
+            if (a.getRows() != b.getRows() || a.getColumns() != b.getColumns())
+                throw std::invalid_argument("Matrices sizes do not match");
+        }
+
+        template <class M>
+        using EnableMatrix = std::enable_if_t<is_matrix_like_v<M>>;
+
+        template <class P>
+        using EnablePolicy = std::enable_if_t<
+            std::is_same_v<P, Sequential> || std::is_same_v<P, Parallel>>;
+    }
+
+    // Whole-matrix reductions
+
+    template <class Policy, class M, class = detail::EnablePolicy<Policy>, class = detail::EnableMatrix<M>>
+    sum_t<matrix_detail::value_t<M>> sum(const Policy& policy, const M& m)
+    {
+        using T = matrix_detail::value_t<M>;
+        using R = sum_t<T>;
+        const MatrixView<const T> v = asView(m);
+        return detail::reduceRows(policy, v.getRows(), v.getColumns(),
+            [&](size_t lo, size_t hi) {
+                R s = R();
+                detail::forEachRow(v, lo, hi, [&](size_t, const T* row) {
+                    s += matrix_kernels::reduceSum<R>(row, v.getColumns());
+                });
+                return s;
+            },
+            [](R& acc, R part) { acc += part; });
+    }
+
+    template <class Policy, class M, class = detail::EnablePolicy<Policy>, class = detail::EnableMatrix<M>>
+    matrix_detail::value_t<M> min(const Policy& policy, const M& m)
+    {
+        using T = matrix_detail::value_t<M>;
+        const MatrixView<const T> v = asView(m);
+        return detail::reduceRows(policy, v.getRows(), v.getColumns(),
+            [&](size_t lo, size_t hi) {
+                T r = v(lo, 0);
+                detail::forEachRow(v, lo, hi, [&](size_t, const T* row) {
+                    const T x = matrix_kernels::reduceMin(row, v.getColumns());
+                    r = x < r ? x : r;
+                });
+                return r;
+            },
+            [](T& acc, T part) { acc = part < acc ? part : acc; });
+    }
+
+    template <class Policy, class M, class = detail::EnablePolicy<Policy>, class = detail::EnableMatrix<M>>
+    matrix_detail::value_t<M> max(const Policy& policy, const M& m)
+    {
+        using T = matrix_detail::value_t<M>;
+        const MatrixView<const T> v = asView(m);
+        return detail::reduceRows(policy, v.getRows(), v.getColumns(),
+            [&](size_t lo, size_t hi) {
+                T r = v(lo, 0);
+                detail::forEachRow(v, lo, hi, [&](size_t, const T* row) {
+                    const T x = matrix_kernels::reduceMax(row, v.getColumns());
+                    r = r < x ? x : r;
+                });
+                return r;
+            },
+            [](T& acc, T part) { acc = acc < part ? part : acc; });
+    }
+
+    // Sum of a(i, j) * b(i, j) (Frobenius inner product).
+    template <class Policy, class A, class B, class = detail::EnablePolicy<Policy>,
+              class = matrix_detail::EnableMatrixOp<A, B>>
+    sum_t<matrix_detail::value_t<A>> dot(const Policy& policy, const A& a, const B& b)
+    {
+        using T = matrix_detail::value_t<A>;
+        using R = sum_t<T>;
+        const MatrixView<const T> va = asView(a);
+        const MatrixView<const T> vb = asView(b);
+        detail::checkSameSize(va, vb);
+        const size_t cols = va.getColumns();
+        return detail::reduceRows(policy, va.getRows(), cols,
+            [&](size_t lo, size_t hi) {
+                R s = R();
+                if (va.rowsContiguous() && vb.rowsContiguous()) {
+                    for (size_t i = lo; i < hi; ++i)
+                        s += matrix_kernels::reduceDot<R>(va.row_ptr(i), vb.row_ptr(i), cols);
+                } else {
+                    for (size_t i = lo; i < hi; ++i)
+                        for (size_t j = 0; j < cols; ++j)
+                            s += static_cast<R>(va(i, j)) * static_cast<R>(vb(i, j));
+                }
+                return s;
+            },
+            [](R& acc, R part) { acc += part; });
+    }
+
+    // sqrt(sum of squares)
+    template <class Policy, class M, class = detail::EnablePolicy<Policy>, class = detail::EnableMatrix<M>>
+    double frobeniusNorm(const Policy& policy, const M& m)
+    {
+        using T = matrix_detail::value_t<M>;
+        const MatrixView<const T> v = asView(m);
+        return std::sqrt(detail::reduceRows(policy, v.getRows(), v.getColumns(),
+            [&](size_t lo, size_t hi) {
+                double s = 0;
+                detail::forEachRow(v, lo, hi, [&](size_t, const T* row) {
+                    s += matrix_kernels::reduceDot<double>(row, row, v.getColumns());
+                });
+                return s;
+            },
+            [](double& acc, double part) { acc += part; }));
+    }
+
+    // Maximum absolute row sum.
+    template <class Policy, class M, class = detail::EnablePolicy<Policy>, class = detail::EnableMatrix<M>>
+    double normInf(const Policy& policy, const M& m)
+    {
+        using T = matrix_detail::value_t<M>;
+        const MatrixView<const T> v = asView(m);
+        return detail::reduceRows(policy, v.getRows(), v.getColumns(),
+            [&](size_t lo, size_t hi) {
+                double r = 0;
+                detail::forEachRow(v, lo, hi, [&](size_t, const T* row) {
+                    r = std::max(r, matrix_kernels::reduceAbsSum<double>(row, v.getColumns()));
+                });
+                return r;
+            },
+            [](double& acc, double part) { acc = std::max(acc, part); });
+    }
+
+    // Maximum absolute column sum.
+    template <class Policy, class M, class = detail::EnablePolicy<Policy>, class = detail::EnableMatrix<M>>
+    double norm1(const Policy& policy, const M& m)
+    {
+        using T = matrix_detail::value_t<M>;
+        const MatrixView<const T> v = asView(m);
+        const size_t cols = v.getColumns();
+        const std::vector<double> sums = detail::reduceRows(policy, v.getRows(), cols,
+            [&](size_t lo, size_t hi) {
+                std::vector<double> acc(cols, 0.0);
+                detail::forEachRow(v, lo, hi, [&](size_t, const T* row) {
+                    matrix_kernels::accumulateAbsSum(acc.data(), row, cols);
+                });
+                return acc;
+            },
+            [cols](std::vector<double>& acc, const std::vector<double>& part) {
+                matrix_kernels::accumulateSum(acc.data(), part.data(), cols);
+            });
+        return matrix_kernels::reduceMax(sums.data(), cols);
+    }
+
+    // Per-row and per-column reductions. Row results are rows x 1 matrices,
+    // column results 1 x cols.
+
+    template <class Policy, class M, class = detail::EnablePolicy<Policy>, class = detail::EnableMatrix<M>>
+    BasicMatrix<sum_t<matrix_detail::value_t<M>>> rowSums(const Policy& policy, const M& m)
+    {
+        using T = matrix_detail::value_t<M>;
+        using R = sum_t<T>;
+        const MatrixView<const T> v = asView(m);
+        BasicMatrix<R> out(v.getRows(), 1);
+        R* dst = out.data();
+        detail::forRows(policy, v.getRows(), v.getColumns(), [&](size_t lo, size_t hi) {
+            detail::forEachRow(v, lo, hi, [&](size_t i, const T* row) {
+                dst[i] = matrix_kernels::reduceSum<R>(row, v.getColumns());
+            });
+        });
+        return out;
+    }
+
+    template <class Policy, class M, class = detail::EnablePolicy<Policy>, class = detail::EnableMatrix<M>>
+    BasicMatrix<matrix_detail::value_t<M>> rowMin(const Policy& policy, const M& m)
+    {
+        using T = matrix_detail::value_t<M>;
+        const MatrixView<const T> v = asView(m);
+        BasicMatrix<T> out(v.getRows(), 1);
+        T* dst = out.data();
+        detail::forRows(policy, v.getRows(), v.getColumns(), [&](size_t lo, size_t hi) {
+            detail::forEachRow(v, lo, hi, [&](size_t i, const T* row) {
+                dst[i] = matrix_kernels::reduceMin(row, v.getColumns());
+            });
+        });
+        return out;
+    }
+
+    template <class Policy, class M, class = detail::EnablePolicy<Policy>, class = detail::EnableMatrix<M>>
+    BasicMatrix<matrix_detail::value_t<M>> rowMax(const Policy& policy, const M& m)
+    {
+        using T = matrix_detail::value_t<M>;
+        const MatrixView<const T> v = asView(m);
+        BasicMatrix<T> out(v.getRows(), 1);
+        T* dst = out.data();
+        detail::forRows(policy, v.getRows(), v.getColumns(), [&](size_t lo, size_t hi) {
+            detail::forEachRow(v, lo, hi, [&](size_t i, const T* row) {
+                dst[i] = matrix_kernels::reduceMax(row, v.getColumns());
+            });
+        });
+        return out;
+    }
+
+    namespace detail
+    {
+        // Column reduction: each chunk of rows folds into its own
+        // accumulator row with update(acc, row, cols), starting from init(lo)
+        // (a row of identities or the chunk's first row); partial rows are
+        // folded with the same update.
+        template <class R, class Policy, class T, class Init, class Update>
+        BasicMatrix<R> reduceColumns(const Policy& policy, MatrixView<const T> v, Init&& init, Update&& update)
+        {
+            const size_t cols = v.getColumns();
+            std::vector<R> acc = reduceRows(policy, v.getRows(), cols,
+                [&](size_t lo, size_t hi) {
+                    std::vector<R> a = init(lo);
+                    forEachRow(v, lo, hi, [&](size_t, const T* row) { update(a.data(), row, cols); });
+                    return a;
+                },
+                [&](std::vector<R>& a, const std::vector<R>& part) { update(a.data(), part.data(), cols); });
+            BasicMatrix<R> out(1, cols);
+            std::copy(acc.begin(), acc.end(), out.data());
+            return out;
+        }
+
+        template <class T>
+        std::vector<T> rowCopy(MatrixView<const T> v, size_t i)
+        {
+            std::vector<T> r(v.getColumns());
+            for (size_t j = 0; j < r.size(); ++j)
+                r[j] = v(i, j);
+            return r;
+        }
+    }
+
+    template <class Policy, class M, class = detail::EnablePolicy<Policy>, class = detail::EnableMatrix<M>>
+    BasicMatrix<sum_t<matrix_detail::value_t<M>>> colSums(const Policy& policy, const M& m)
+    {
+        using T = matrix_detail::value_t<M>;
+        using R = sum_t<T>;
+        const MatrixView<const T> v = asView(m);
+        return detail::reduceColumns<R>(policy, v,
+            [&](size_t) { return std::vector<R>(v.getColumns(), R()); },
+            [](R* acc, const auto* x, size_t n) { matrix_kernels::accumulateSum(acc, x, n); });
+    }
+
+    template <class Policy, class M, class = detail::EnablePolicy<Policy>, class = detail::EnableMatrix<M>>
+    BasicMatrix<matrix_detail::value_t<M>> colMin(const Policy& policy, const M& m)
+    {
+        using T = matrix_detail::value_t<M>;
+        const MatrixView<const T> v = asView(m);
+        return detail::reduceColumns<T>(policy, v,
+            [&](size_t lo) { return detail::rowCopy(v, lo); },
+            [](T* acc, const T* x, size_t n) { matrix_kernels::accumulateMin(acc, x, n); });
+    }
+
+    template <class Policy, class M, class = detail::EnablePolicy<Policy>, class = detail::EnableMatrix<M>>
+    BasicMatrix<matrix_detail::value_t<M>> colMax(const Policy& policy, const M& m)
+    {
+        using T = matrix_detail::value_t<M>;
+        const MatrixView<const T> v = asView(m);
+        return detail::reduceColumns<T>(policy, v,
+            [&](size_t lo) { return detail::rowCopy(v, lo); },
+            [](T* acc, const T* x, size_t n) { matrix_kernels::accumulateMax(acc, x, n); });
+    }
+
+    // Element-wise operations. f is called once per element, in no
+    // particular order (and from several threads under par), so it must not
+    // depend on side effects. Simple lambdas inline into the row loops and
+    // vectorize.
+
+    // out(i, j) = f(m(i, j))
+    template <class Policy, class M, class F, class = detail::EnablePolicy<Policy>, class = detail::EnableMatrix<M>>
+    auto map(const Policy& policy, const M& m, F f)
+    {
+        using T = matrix_detail::value_t<M>;
+        using R = std::decay_t<std::invoke_result_t<F&, T>>;
+        const MatrixView<const T> v = asView(m);
+        const size_t cols = v.getColumns();
+        BasicMatrix<R> out(v.getRows(), cols);
+        R* dst = out.data();
+        detail::forRows(policy, v.getRows(), cols, [&](size_t lo, size_t hi) {
+            detail::forEachRow(v, lo, hi, [&](size_t i, const T* row) {
+                R* __restrict o = dst + i * cols;
+                for (size_t j = 0; j < cols; ++j)
+                    o[j] = f(row[j]);
+            });
+        });
+        return out;
+    }
+
+    // out(i, j) = f(a(i, j), b(i, j))
+    template <class Policy, class A, class B, class F, class = detail::EnablePolicy<Policy>,
+              class = detail::EnableMatrix<A>, class = detail::EnableMatrix<B>>
+    auto zip(const Policy& policy, const A& a, const B& b, F f)
+    {
+        using TA = matrix_detail::value_t<A>;
+        using TB = matrix_detail::value_t<B>;
+        using R = std::decay_t<std::invoke_result_t<F&, TA, TB>>;
+        const MatrixView<const TA> va = asView(a);
+        const MatrixView<const TB> vb = asView(b);
+        detail::checkSameSize(va, vb);
+        const size_t cols = va.getColumns();
+        BasicMatrix<R> out(va.getRows(), cols);
+        R* dst = out.data();
+        detail::forRows(policy, va.getRows(), cols, [&](size_t lo, size_t hi) {
+            if (va.rowsContiguous() && vb.rowsContiguous()) {
+                for (size_t i = lo; i < hi; ++i) {
+                    const TA* x = va.row_ptr(i);
+                    const TB* y = vb.row_ptr(i);
+                    R* __restrict o = dst + i * cols;
+                    for (size_t j = 0; j < cols; ++j)
+                        o[j] = f(x[j], y[j]);
+                }
+            } else {
+                for (size_t i = lo; i < hi; ++i)
+                    for (size_t j = 0; j < cols; ++j)
+                        dst[i * cols + j] = f(va(i, j), vb(i, j));
+            }
+        });
+        return out;
+    }
+
+    // |x| of signed integers is computed and returned in the unsigned type,
+    // so that the minimum value (INT_MIN) has one: abs of BasicMatrix<int32_t> is
+    // a BasicMatrix<uint32_t>. Other types keep theirs.
+    template <class T>
+    using abs_t = typename std::conditional_t<std::is_integral_v<T> && std::is_signed_v<T>,
+                                              std::make_unsigned<T>, std::common_type<T>>::type;
+
+    template <class Policy, class M, class = detail::EnablePolicy<Policy>, class = detail::EnableMatrix<M>>
+    BasicMatrix<abs_t<matrix_detail::value_t<M>>> abs(const Policy& policy, const M& m)
+    {
+        using T = matrix_detail::value_t<M>;
+        using U = abs_t<T>;
+        if constexpr (std::is_unsigned_v<T>)
+            return BasicMatrix<T>(asView(m));
+        else if constexpr (std::is_integral_v<T>)
+            return map(policy, m, [](T x) { return x < T() ? U(U(0) - U(x)) : U(x); });
+        else
+            return map(policy, m, [](T x) { return x < T() ? T(-x) : x; });
+    }
+
+    template <class Policy, class M, class = detail::EnablePolicy<Policy>, class = detail::EnableMatrix<M>>
+    BasicMatrix<matrix_detail::value_t<M>> clamp(const Policy& policy, const M& m,
+                                            matrix_detail::value_t<M> lo, matrix_detail::value_t<M> hi)
+    {
+        using T = matrix_detail::value_t<M>;
+        if (hi < lo)
+            throw std::invalid_argument("clamp: hi < lo");
+        return map(policy, m, [lo, hi](T x) { return x < lo ? lo : (hi < x ? hi : x); });
+    }
+
+    // Same functions without a policy: sequential.
+
+    template <class M, class = detail::EnableMatrix<M>>
+    auto sum(const M& m) { return sum(seq, m); }
+
+    template <class M, class = detail::EnableMatrix<M>>
+    auto min(const M& m) { return min(seq, m); }
+
+    template <class M, class = detail::EnableMatrix<M>>
+    auto max(const M& m) { return max(seq, m); }
+
+    template <class A, class B, class = matrix_detail::EnableMatrixOp<A, B>>
+    auto dot(const A& a, const B& b) { return dot(seq, a, b); }
+
+    template <class M, class = detail::EnableMatrix<M>>
+    double frobeniusNorm(const M& m) { return frobeniusNorm(seq, m); }
+
+    template <class M, class = detail::EnableMatrix<M>>
+    double normInf(const M& m) { return normInf(seq, m); }
+
+    template <class M, class = detail::EnableMatrix<M>>
+    double norm1(const M& m) { return norm1(seq, m); }
+
+    template <class M, class = detail::EnableMatrix<M>>
+    auto rowSums(const M& m) { return rowSums(seq, m); }
+
+    template <class M, class = detail::EnableMatrix<M>>
+    auto rowMin(const M& m) { return rowMin(seq, m); }
+
+    template <class M, class = detail::EnableMatrix<M>>
+    auto rowMax(const M& m) { return rowMax(seq, m); }
+
+    template <class M, class = detail::EnableMatrix<M>>
+    auto colSums(const M& m) { return colSums(seq, m); }
+
+    template <class M, class = detail::EnableMatrix<M>>
+    auto colMin(const M& m) { return colMin(seq, m); }
+
+    template <class M, class = detail::EnableMatrix<M>>
+    auto colMax(const M& m) { return colMax(seq, m); }
+
+    template <class M, class F, class = detail::EnableMatrix<M>>
+    auto map(const M& m, F f) { return map(seq, m, std::move(f)); }
+
+    template <class A, class B, class F, class = detail::EnableMatrix<A>, class = detail::EnableMatrix<B>>
+    auto zip(const A& a, const B& b, F f) { return zip(seq, a, b, std::move(f)); }
+
+    template <class M, class = detail::EnableMatrix<M>>
+    auto abs(const M& m) { return abs(seq, m); }
+
+    template <class M, class = detail::EnableMatrix<M>>
+    auto clamp(const M& m, matrix_detail::value_t<M> lo, matrix_detail::value_t<M> hi)
+    {
+        return clamp(seq, m, lo, hi);
+    }
+}
+
+#endif // MATRIX_ALGORITHMS_HPP
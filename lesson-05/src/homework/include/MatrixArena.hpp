@@ -0,0 +1,106 @@
+#ifndef MATRIX_ARENA_HPP
+#define MATRIX_ARENA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+// Bump allocator for batches of short-lived matrices:
+//
+//     MatrixArena arena;
+//     for (const Job& job : jobs) {
+//         {
+//             BasicMatrix<float> a(64, 64, &arena);
+//             BasicMatrix<float> c = a * a + a;   // temporaries come from the arena
+//             ...
+//         }                                   // every matrix of the batch is gone
+//         arena.reset();                      // one reset frees the batch
+//     }
+//
+// deallocate() does nothing; reset() makes all the memory available again
+// but keeps the chunks, so a steady-state batch does not call the upstream
+// allocator at all (std::pmr::monotonic_buffer_resource::release() returns
+// its chunks instead). Not thread-safe: use one arena per thread.
+class MatrixArena : public std::pmr::memory_resource
+{
+    private:
+        struct Chunk
+        {
+            char* data;
+            size_t size;
+        };
+
+        std::pmr::memory_resource* upstream_;
+        size_t chunkSize_;
+        std::vector<Chunk> chunks_;
+        size_t current_ = 0; // chunk being filled
+        size_t offset_ = 0;  // first free byte in it
+        size_t used_ = 0;    // bytes handed out since the last reset
+
+        static constexpr size_t ChunkAlignment = 64;
+
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            for (;;) {
+                if (current_ < chunks_.size()) {
+                    Chunk& c = chunks_[current_];
+                    const uintptr_t base = reinterpret_cast<uintptr_t>(c.data);
+                    const size_t start = ((base + offset_ + alignment - 1) & ~uintptr_t(alignment - 1)) - base;
+                    if (start + bytes <= c.size) {
+                        offset_ = start + bytes;
+                        used_ += bytes;
+                        return c.data + start;
+                    }
+                    // try the next kept chunk, which may be big enough
+                    ++current_;
+                    offset_ = 0;
+                    continue;
+                }
+                const size_t size = std::max(chunkSize_, bytes + alignment);
+                chunks_.push_back({static_cast<char*>(upstream_->allocate(size, ChunkAlignment)), size});
+            }
+        }
+
+        void do_deallocate(void*, size_t, size_t) override {}
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+    public:
+        explicit MatrixArena(size_t chunkSize = size_t(1) << 20,
+                             std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+            : upstream_(upstream), chunkSize_(chunkSize) {}
+
+        MatrixArena(const MatrixArena&) = delete;
+        MatrixArena& operator=(const MatrixArena&) = delete;
+
+        ~MatrixArena() override
+        {
+            for (const Chunk& c : chunks_)
+                upstream_->deallocate(c.data, c.size, ChunkAlignment);
+        }
+
+        // Every matrix allocated from the arena must be destroyed first.
+        void reset()
+        {
+            current_ = 0;
+            offset_ = 0;
+            used_ = 0;
+        }
+
+        size_t bytesUsed() const { return used_; }
+
+        size_t bytesReserved() const
+        {
+            size_t total = 0;
+            for (const Chunk& c : chunks_)
+                total += c.size;
+            return total;
+        }
+};
+
+#endif // MATRIX_ARENA_HPP
@@ -0,0 +1,73 @@
+#ifndef MATRIX_IO_HPP
+#define MATRIX_IO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "MatrixStorage.hpp"
+
+// Binary on-disk format of BasicMatrix<T>:
+//
+//   offset 0   FileHeader (little-endian host layout)
+//   ...        zero padding
+//   offset 64  rows * cols elements, row-major, no padding
+//
+// The data offset is a multiple of Matrix::Alignment, so a memory-mapped
+// file (page-aligned) can be used in place as matrix storage.
+
+namespace matrix_io
+{
+    enum class ElementType : uint32_t
+    {
+        Int8 = 1,
+        Int16 = 2,
+        Int32 = 3,
+        Int64 = 4,
+        Float32 = 5,
+        Float64 = 6
+    };
+
+    template <class T>
+    struct ElementTypeOf;
+
+    template <> struct ElementTypeOf<int8_t>  { static constexpr ElementType value = ElementType::Int8; };
+    template <> struct ElementTypeOf<int16_t> { static constexpr ElementType value = ElementType::Int16; };
+    template <> struct ElementTypeOf<int32_t> { static constexpr ElementType value = ElementType::Int32; };
+    template <> struct ElementTypeOf<int64_t> { static constexpr ElementType value = ElementType::Int64; };
+    template <> struct ElementTypeOf<float>   { static constexpr ElementType value = ElementType::Float32; };
+    template <> struct ElementTypeOf<double>  { static constexpr ElementType value = ElementType::Float64; };
+
+    struct FileHeader
+    {
+        char magic[8];        // "MATRIX\0\0"
+        uint32_t endianTag;   // 0x01020304 as written by the host
+        uint32_t version;
+        uint32_t elementType; // ElementType
+        uint32_t elementSize; // sizeof(T)
+        uint64_t rows;
+        uint64_t cols;
+        uint64_t dataOffset;  // where the elements start
+        uint32_t alignment;   // dataOffset is a multiple of this
+        uint32_t reserved;
+    };
+
+    constexpr uint32_t FormatVersion = 1;
+    constexpr uint64_t DataOffset = 64;
+
+    static_assert(sizeof(FileHeader) <= DataOffset, "header must fit before the data");
+
+    FileHeader makeHeader(ElementType type, size_t elementSize, size_t rows, size_t cols);
+
+    // Throws std::runtime_error when the header is not a matrix of the
+    // expected element type written on a host of the same endianness.
+    void checkHeader(const FileHeader& header, ElementType type, size_t elementSize);
+
+    // Maps the whole file read-only. The returned block owns the mapping
+    // (released with matrix_detail::release) and is not writable; *data
+    // points at the first element. Throws std::runtime_error on failure.
+    matrix_detail::StorageBlock* mapFile(const std::string& path, ElementType type, size_t elementSize,
+                                         FileHeader& header, const void** data);
+}
+
+#endif // MATRIX_IO_HPP
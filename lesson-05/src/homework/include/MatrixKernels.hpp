@@ -0,0 +1,341 @@
+#ifndef MATRIX_KERNELS_HPP
+#define MATRIX_KERNELS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Low-level loops used by BasicMatrix<T>. All of them work on raw pointers with
+// an explicit leading dimension (distance between two rows, in elements),
+// so the same kernels serve whole matrices and sub-blocks.
+//
+// The loops are written so that GCC/Clang auto-vectorize them at -O2/-O3;
+// the per-type differences are expressed through Accumulator<T> and madd().
+
+namespace matrix_kernels
+{
+    // Type used to accumulate products of T. Narrow integers are widened to
+    // 32 bits so that the inner loop maps onto widening multiplies
+    // (pmovsx + pmulld) instead of a chain of 8/16-bit operations. The
+    // accumulator is unsigned so long sums wrap instead of overflowing; the
+    // final narrowing gives the same result modulo 2^N as computing in T.
+    template <class T>
+    struct Accumulator { using type = T; };
+
+    template <> struct Accumulator<int8_t>   { using type = uint32_t; };
+    template <> struct Accumulator<uint8_t>  { using type = uint32_t; };
+    template <> struct Accumulator<int16_t>  { using type = uint32_t; };
+    template <> struct Accumulator<uint16_t> { using type = uint32_t; };
+
+    template <class T>
+    using accumulator_t = typename Accumulator<T>::type;
+
+    // acc + a * b. Signed integers are computed in the unsigned type (after
+    // promotion) so that partial sums wrap like the narrow accumulators
+    // above: the result is exact whenever the final sum fits in T. Floating
+    // point types use a fused multiply-add when the target has one,
+    // otherwise std::fma would fall back to a slow libcall.
+    template <class T>
+    inline T madd(T acc, T a, T b)
+    {
+        if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            using U = std::make_unsigned_t<decltype(a * b)>;
+            return static_cast<T>(static_cast<U>(acc) + static_cast<U>(a) * static_cast<U>(b));
+        } else {
+            return static_cast<T>(acc + a * b);
+        }
+    }
+
+#if defined(__FMA__)
+    template <>
+    inline float madd<float>(float acc, float a, float b)
+    {
+        return std::fma(a, b, acc);
+    }
+
+    template <>
+    inline double madd<double>(double acc, double a, double b)
+    {
+        return std::fma(a, b, acc);
+    }
+#endif
+
+    // Blocking parameters for gemm, in elements.
+    constexpr size_t BlockRows = 64;
+    constexpr size_t BlockDepth = 256;
+    constexpr size_t BlockCols = 512;
+
+    // out[i] = a[i] + b[i]; out may be a or b
+    template <class T>
+    void add(const T* a, const T* b, T* out, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+            out[i] = static_cast<T>(a[i] + b[i]);
+    }
+
+    // out[i] = a[i] - b[i]; out may be a or b
+    template <class T>
+    void sub(const T* a, const T* b, T* out, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+            out[i] = static_cast<T>(a[i] - b[i]);
+    }
+
+    // a[i] *= v
+    template <class T>
+    void scale(T* __restrict a, T v, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+            a[i] = static_cast<T>(a[i] * v);
+    }
+
+    // y[i] += a * x[i]
+    template <class T>
+    void axpy(T* __restrict y, T a, const T* __restrict x, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+            y[i] = madd(y[i], a, x[i]);
+    }
+
+    // Reductions keep Lanes independent partial results so that the loop
+    // carries no serial dependency and maps onto vector registers even
+    // for floating point types (where the compiler may not reassociate).
+    constexpr size_t Lanes = 8;
+
+    // sum of x[i], accumulated in R
+    template <class R, class T>
+    R reduceSum(const T* x, size_t n)
+    {
+        R lanes[Lanes] = {};
+        size_t i = 0;
+        for (; i + Lanes <= n; i += Lanes)
+            for (size_t l = 0; l < Lanes; ++l)
+                lanes[l] += static_cast<R>(x[i + l]);
+        R sum = R();
+        for (size_t l = 0; l < Lanes; ++l)
+            sum += lanes[l];
+        for (; i < n; ++i)
+            sum += static_cast<R>(x[i]);
+        return sum;
+    }
+
+    // sum of x[i] * y[i], accumulated in R
+    template <class R, class T>
+    R reduceDot(const T* x, const T* y, size_t n)
+    {
+        R lanes[Lanes] = {};
+        size_t i = 0;
+        for (; i + Lanes <= n; i += Lanes)
+            for (size_t l = 0; l < Lanes; ++l)
+                lanes[l] += static_cast<R>(x[i + l]) * static_cast<R>(y[i + l]);
+        R sum = R();
+        for (size_t l = 0; l < Lanes; ++l)
+            sum += lanes[l];
+        for (; i < n; ++i)
+            sum += static_cast<R>(x[i]) * static_cast<R>(y[i]);
+        return sum;
+    }
+
+    // min / max of x[0..n), n > 0; `a < b ? a : b` maps onto minps/pminsd
+    template <class T>
+    T reduceMin(const T* x, size_t n)
+    {
+        if (n < Lanes)
+            return *std::min_element(x, x + n);
+        T lanes[Lanes];
+        std::copy_n(x, Lanes, lanes);
+        size_t i = Lanes;
+        for (; i + Lanes <= n; i += Lanes)
+            for (size_t l = 0; l < Lanes; ++l)
+                lanes[l] = x[i + l] < lanes[l] ? x[i + l] : lanes[l];
+        T result = *std::min_element(lanes, lanes + Lanes);
+        for (; i < n; ++i)
+            result = x[i] < result ? x[i] : result;
+        return result;
+    }
+
+    template <class T>
+    T reduceMax(const T* x, size_t n)
+    {
+        if (n < Lanes)
+            return *std::max_element(x, x + n);
+        T lanes[Lanes];
+        std::copy_n(x, Lanes, lanes);
+        size_t i = Lanes;
+        for (; i + Lanes <= n; i += Lanes)
+            for (size_t l = 0; l < Lanes; ++l)
+                lanes[l] = lanes[l] < x[i + l] ? x[i + l] : lanes[l];
+        T result = *std::max_element(lanes, lanes + Lanes);
+        for (; i < n; ++i)
+            result = result < x[i] ? x[i] : result;
+        return result;
+    }
+
+    // sum of |x[i]|, accumulated in R (used by the matrix norms)
+    template <class R, class T>
+    R reduceAbsSum(const T* x, size_t n)
+    {
+        R lanes[Lanes] = {};
+        size_t i = 0;
+        for (; i + Lanes <= n; i += Lanes)
+            for (size_t l = 0; l < Lanes; ++l) {
+                const R v = static_cast<R>(x[i + l]);
+                lanes[l] += v < R() ? -v : v;
+            }
+        R sum = R();
+        for (size_t l = 0; l < Lanes; ++l)
+            sum += lanes[l];
+        for (; i < n; ++i) {
+            const R v = static_cast<R>(x[i]);
+            sum += v < R() ? -v : v;
+        }
+        return sum;
+    }
+
+    // Column-wise updates of an accumulator row: one unit-stride pass per
+    // matrix row, which is how column reductions stay cache friendly.
+    template <class R, class T>
+    void accumulateSum(R* __restrict acc, const T* __restrict x, size_t n)
+    {
+        for (size_t j = 0; j < n; ++j)
+            acc[j] += static_cast<R>(x[j]);
+    }
+
+    template <class R, class T>
+    void accumulateAbsSum(R* __restrict acc, const T* __restrict x, size_t n)
+    {
+        for (size_t j = 0; j < n; ++j) {
+            const R v = static_cast<R>(x[j]);
+            acc[j] += v < R() ? -v : v;
+        }
+    }
+
+    template <class T>
+    void accumulateMin(T* __restrict acc, const T* __restrict x, size_t n)
+    {
+        for (size_t j = 0; j < n; ++j)
+            acc[j] = x[j] < acc[j] ? x[j] : acc[j];
+    }
+
+    template <class T>
+    void accumulateMax(T* __restrict acc, const T* __restrict x, size_t n)
+    {
+        for (size_t j = 0; j < n; ++j)
+            acc[j] = acc[j] < x[j] ? x[j] : acc[j];
+    }
+
+    template <class T>
+    bool equal(const T* a, const T* b, size_t n)
+    {
+        return std::equal(a, a + n, b);
+    }
+
+    // C[m x n] += A[m x k] * B[k x n]. A is addressed through a row and a
+    // column stride (it is only read one scalar at a time), B and C have
+    // contiguous rows with leading dimensions ldb / ldc.
+    // i-k-j order keeps the innermost loop unit-stride over B and C.
+    template <class T>
+    void gemm(size_t m, size_t n, size_t k,
+              const T* a, size_t ars, size_t acs,
+              const T* b, size_t ldb,
+              T* c, size_t ldc)
+    {
+        using Acc = accumulator_t<T>;
+
+        if constexpr (std::is_same_v<Acc, T>) {
+            for (size_t i0 = 0; i0 < m; i0 += BlockRows) {
+                const size_t i1 = std::min(m, i0 + BlockRows);
+                for (size_t p0 = 0; p0 < k; p0 += BlockDepth) {
+                    const size_t p1 = std::min(k, p0 + BlockDepth);
+                    for (size_t j0 = 0; j0 < n; j0 += BlockCols) {
+                        const size_t jn = std::min(n, j0 + BlockCols) - j0;
+                        for (size_t i = i0; i < i1; ++i) {
+                            T* __restrict crow = c + i * ldc + j0;
+                            for (size_t p = p0; p < p1; ++p) {
+                                const T aip = a[i * ars + p * acs];
+                                const T* __restrict brow = b + p * ldb + j0;
+                                for (size_t j = 0; j < jn; ++j)
+                                    crow[j] = madd(crow[j], aip, brow[j]);
+                            }
+                        }
+                    }
+                }
+            }
+        } else {
+            // Narrow integers: accumulate a whole row block in a widened
+            // buffer and narrow once per (row, column block).
+            Acc acc[BlockCols];
+            for (size_t j0 = 0; j0 < n; j0 += BlockCols) {
+                const size_t jn = std::min(n, j0 + BlockCols) - j0;
+                for (size_t i = 0; i < m; ++i) {
+                    T* crow = c + i * ldc + j0;
+                    for (size_t j = 0; j < jn; ++j)
+                        acc[j] = static_cast<Acc>(crow[j]);
+                    for (size_t p = 0; p < k; ++p) {
+                        const Acc aip = static_cast<Acc>(a[i * ars + p * acs]);
+                        const T* __restrict brow = b + p * ldb + j0;
+                        for (size_t j = 0; j < jn; ++j)
+                            acc[j] += aip * static_cast<Acc>(brow[j]);
+                    }
+                    for (size_t j = 0; j < jn; ++j)
+                        crow[j] = static_cast<T>(acc[j]);
+                }
+            }
+        }
+    }
+
+    // Row-major A with leading dimension lda.
+    template <class T>
+    void gemm(size_t m, size_t n, size_t k,
+              const T* a, size_t lda,
+              const T* b, size_t ldb,
+              T* c, size_t ldc)
+    {
+        gemm(m, n, k, a, lda, 1, b, ldb, c, ldc);
+    }
+
+    // dst[cols x rows] = transpose(src[rows x cols]). Cache-oblivious: the
+    // larger side is halved until the block fits in L1, so both the reads
+    // and the writes stay cache friendly whatever the cache sizes are.
+    template <class T>
+    void transpose(size_t rows, size_t cols, const T* src, size_t lds, T* dst, size_t ldd)
+    {
+        constexpr size_t Leaf = 32;
+        if (rows <= Leaf && cols <= Leaf) {
+            for (size_t i = 0; i < rows; ++i)
+                for (size_t j = 0; j < cols; ++j)
+                    dst[j * ldd + i] = src[i * lds + j];
+        } else if (rows >= cols) {
+            const size_t h = rows / 2;
+            transpose(h, cols, src, lds, dst, ldd);
+            transpose(rows - h, cols, src + h * lds, lds, dst + h, ldd);
+        } else {
+            const size_t h = cols / 2;
+            transpose(rows, h, src, lds, dst, ldd);
+            transpose(rows, cols - h, src + h, lds, dst + h * ldd, ldd);
+        }
+    }
+
+    // dst = src for two strided rows x cols blocks.
+    template <class T>
+    void copy(size_t rows, size_t cols,
+              const T* src, size_t srs, size_t scs,
+              T* dst, size_t drs, size_t dcs)
+    {
+        if (scs == 1 && dcs == 1) {
+            for (size_t i = 0; i < rows; ++i)
+                std::copy_n(src + i * srs, cols, dst + i * drs);
+        } else if (srs == 1 && dcs == 1) {
+            // source is a transposed view: src^T has contiguous rows
+            transpose(cols, rows, src, scs, dst, drs);
+        } else {
+            for (size_t i = 0; i < rows; ++i)
+                for (size_t j = 0; j < cols; ++j)
+                    dst[i * drs + j * dcs] = src[i * srs + j * scs];
+        }
+    }
+}
+
+#endif // MATRIX_KERNELS_HPP
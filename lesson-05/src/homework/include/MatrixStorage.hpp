@@ -0,0 +1,93 @@
+#ifndef MATRIX_STORAGE_HPP
+#define MATRIX_STORAGE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+namespace matrix_detail
+{
+    // Header of a block of matrix elements. The block records how to free
+    // itself, so a Matrix can own heap memory, memory from a
+    // std::pmr::memory_resource and memory-mapped files through the same
+    // pointer. refs counts the matrices using the block.
+    struct StorageBlock
+    {
+        std::atomic<size_t> refs{1};
+        bool writable = true;
+        void (*release)(StorageBlock*) = nullptr;
+        std::pmr::memory_resource* resource = nullptr; // null: not from a resource
+    };
+
+    // Heap blocks are a single aligned allocation: the header, padding up
+    // to `Alignment`, then the elements.
+    template <size_t Alignment>
+    struct HeapStorage
+    {
+        static constexpr size_t HeaderSize =
+            (sizeof(StorageBlock) + Alignment - 1) / Alignment * Alignment;
+
+        static StorageBlock* allocate(size_t bytes, void** data)
+        {
+            void* raw = ::operator new(HeaderSize + bytes, std::align_val_t(Alignment));
+            StorageBlock* block = new (raw) StorageBlock();
+            block->release = &HeapStorage::release;
+            *data = static_cast<char*>(raw) + HeaderSize;
+            return block;
+        }
+
+        static void release(StorageBlock* block)
+        {
+            block->~StorageBlock();
+            ::operator delete(static_cast<void*>(block), std::align_val_t(Alignment));
+        }
+    };
+
+    // Same layout as HeapStorage, allocated from a memory resource. The block
+    // remembers its size for memory_resource::deallocate.
+    template <size_t Alignment>
+    struct ResourceStorage
+    {
+        struct Block : StorageBlock
+        {
+            size_t bytes = 0;
+        };
+
+        static constexpr size_t HeaderSize =
+            (sizeof(Block) + Alignment - 1) / Alignment * Alignment;
+
+        static StorageBlock* allocate(std::pmr::memory_resource* resource, size_t bytes, void** data)
+        {
+            void* raw = resource->allocate(HeaderSize + bytes, Alignment);
+            Block* block = new (raw) Block();
+            block->release = &ResourceStorage::release;
+            block->resource = resource;
+            block->bytes = HeaderSize + bytes;
+            *data = static_cast<char*>(raw) + HeaderSize;
+            return block;
+        }
+
+        static void release(StorageBlock* base)
+        {
+            Block* block = static_cast<Block*>(base);
+            std::pmr::memory_resource* resource = block->resource;
+            const size_t bytes = block->bytes;
+            block->~Block();
+            resource->deallocate(static_cast<void*>(block), bytes, Alignment);
+        }
+    };
+
+    inline void retain(StorageBlock* block)
+    {
+        block->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline void release(StorageBlock* block)
+    {
+        if (block && block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            block->release(block);
+    }
+}
+
+#endif // MATRIX_STORAGE_HPP
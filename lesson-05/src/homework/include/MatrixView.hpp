@@ -0,0 +1,228 @@
+#ifndef MATRIX_VIEW_HPP
+#define MATRIX_VIEW_HPP
+
+// Included from Matrix.hpp, after the Matrix class definition.
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+#include "MatrixKernels.hpp"
+
+// Non-owning window on the elements of a Matrix (or of any row-major
+// buffer). Element (i, j) lives at data[i * rowStride + j * colStride], so
+// submatrices, single rows/columns, strided slices and transposes are all
+// views of the same storage. MatrixView<const T> is read-only.
+//
+// A view never outlives the matrix it was taken from; the matrix must not
+// be resized or reassigned while views on it exist.
+template <class T>
+class MatrixView
+{
+    private:
+        T* data_;
+        size_t rows_;
+        size_t cols_;
+        size_t rowStride_;
+        size_t colStride_;
+
+    public:
+        using value_type = std::remove_const_t<T>;
+
+        MatrixView(T* data, size_t rows, size_t cols, size_t rowStride, size_t colStride = 1)
+            : data_(data), rows_(rows), cols_(cols), rowStride_(rowStride), colStride_(colStride) {}
+
+        // MatrixView<T> -> MatrixView<const T>
+        template <class U, class = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+        MatrixView(const MatrixView<U>& other)
+            : data_(other.data()), rows_(other.getRows()), cols_(other.getColumns()),
+              rowStride_(other.rowStride()), colStride_(other.colStride()) {}
+
+        size_t getRows() const { return rows_; }
+        size_t getColumns() const { return cols_; }
+        size_t rowStride() const { return rowStride_; }
+        size_t colStride() const { return colStride_; }
+        T* data() const { return data_; }
+
+        // elements of a row are adjacent in memory
+        bool rowsContiguous() const { return colStride_ == 1 || cols_ == 1; }
+
+        // The element ranges [first, last] of the two views intersect, so
+        // writing through one may change what the other reads. Conservative
+        // for interleaved strided views.
+        template <class U>
+        bool overlaps(const MatrixView<U>& other) const
+        {
+            if (rows_ == 0 || cols_ == 0 || other.getRows() == 0 || other.getColumns() == 0)
+                return false;
+            const void* first = data_;
+            const void* last = data_ + (rows_ - 1) * rowStride_ + (cols_ - 1) * colStride_;
+            const void* otherFirst = other.data();
+            const void* otherLast = other.data() + (other.getRows() - 1) * other.rowStride()
+                                    + (other.getColumns() - 1) * other.colStride();
+            std::less_equal<const void*> le;
+            return le(first, otherLast) && le(otherFirst, last);
+        }
+
+        // the same elements in the same order
+        template <class U>
+        bool sameLayout(const MatrixView<U>& other) const
+        {
+            return static_cast<const void*>(data_) == static_cast<const void*>(other.data())
+                && rows_ == other.getRows() && cols_ == other.getColumns()
+                && rowStride_ == other.rowStride() && colStride_ == other.colStride();
+        }
+
+        T& operator()(size_t i, size_t j) const
+        {
+            assert(i < rows_ && j < cols_);
+            return data_[i * rowStride_ + j * colStride_];
+        }
+
+        T& at(size_t i, size_t j) const
+        {
+            if (i >= rows_ || j >= cols_)
+                throw std::out_of_range("Matrix indice out of range");
+            return data_[i * rowStride_ + j * colStride_];
+        }
+
+        // Start of row i; only meaningful element by element when
+        // rowsContiguous().
+        T* row_ptr(size_t i) const
+        {
+            assert(i < rows_);
+            return data_ + i * rowStride_;
+        }
+
+        // Slicing
+
+        MatrixView submatrix(size_t row, size_t col, size_t rows, size_t cols) const
+        {
+            if (rows == 0 || cols == 0 || row + rows > rows_ || col + cols > cols_)
+                throw std::out_of_range("Submatrix out of range");
+            return MatrixView(data_ + row * rowStride_ + col * colStride_, rows, cols, rowStride_, colStride_);
+        }
+
+        MatrixView row(size_t i) const { return submatrix(i, 0, 1, cols_); }
+        MatrixView col(size_t j) const { return submatrix(0, j, rows_, 1); }
+
+        // Every rowStep-th row and colStep-th column of the
+        // rows x cols block starting at (row, col).
+        MatrixView strided(size_t row, size_t col, size_t rows, size_t cols,
+                           size_t rowStep, size_t colStep) const
+        {
+            if (rows == 0 || cols == 0 || rowStep == 0 || colStep == 0
+                || row + (rows - 1) * rowStep >= rows_ || col + (cols - 1) * colStep >= cols_)
+                throw std::out_of_range("Strided view out of range");
+            return MatrixView(data_ + row * rowStride_ + col * colStride_, rows, cols,
+                              rowStride_ * rowStep, colStride_ * colStep);
+        }
+
+        // Transpose without moving any element.
+        MatrixView transposed() const
+        {
+            return MatrixView(data_, cols_, rows_, colStride_, rowStride_);
+        }
+
+        // In-place arithmetic on the viewed elements (mutable views only).
+
+        template <class V>
+        const MatrixView& operator*=(V val) const;
+
+        template <class M>
+        const MatrixView& operator+=(const M& other) const;
+
+        // Copies the elements of a same-sized matrix or view into this one.
+        // The source may overlap this view (e.g. v.assign(v.transposed())):
+        // it is then copied through a temporary Matrix first, as is the
+        // right-hand side of += unless it is this very view.
+        template <class M>
+        const MatrixView& assign(const M& other) const;
+};
+
+// Matrix-like types: BasicMatrix<T, Access> and MatrixView<T>.
+
+template <class M>
+struct MatrixTraits : std::false_type {};
+
+template <class T, class Access>
+struct MatrixTraits<BasicMatrix<T, Access>> : std::true_type { using value_type = T; };
+
+template <class T>
+struct MatrixTraits<MatrixView<T>> : std::true_type { using value_type = std::remove_const_t<T>; };
+
+template <class M>
+constexpr bool is_matrix_like_v = MatrixTraits<std::remove_cv_t<M>>::value;
+
+// Read-only view on any matrix-like value.
+template <class T, class Access>
+MatrixView<const T> asView(const BasicMatrix<T, Access>& m) { return m.view(); }
+
+template <class T>
+MatrixView<const std::remove_const_t<T>> asView(const MatrixView<T>& v) { return v; }
+
+namespace matrix_detail
+{
+    // Enables the free operators below for two matrix-like operands of the
+    // same element type. Matrix op Matrix of one type keeps using the
+    // member operators (an exact non-template match wins).
+    template <class A, class B>
+    using EnableMatrixOp = std::enable_if_t<
+        is_matrix_like_v<A> && is_matrix_like_v<B>
+        && std::is_same_v<typename MatrixTraits<A>::value_type, typename MatrixTraits<B>::value_type>>;
+
+    template <class A>
+    using value_t = typename MatrixTraits<A>::value_type;
+
+    template <class T>
+    BasicMatrix<T> add(MatrixView<const T> a, MatrixView<const T> b);
+
+    template <class T>
+    BasicMatrix<T> multiply(MatrixView<const T> a, MatrixView<const T> b);
+
+    template <class T>
+    bool equal(MatrixView<const T> a, MatrixView<const T> b);
+}
+
+template <class A, class B, class = matrix_detail::EnableMatrixOp<A, B>>
+BasicMatrix<matrix_detail::value_t<A>> operator+(const A& a, const B& b)
+{
+    return matrix_detail::add(asView(a), asView(b));
+}
+
+template <class A, class B, class = matrix_detail::EnableMatrixOp<A, B>>
+BasicMatrix<matrix_detail::value_t<A>> operator*(const A& a, const B& b)
+{
+    return matrix_detail::multiply(asView(a), asView(b));
+}
+
+template <class A, class B, class = matrix_detail::EnableMatrixOp<A, B>>
+bool operator==(const A& a, const B& b)
+{
+    return matrix_detail::equal(asView(a), asView(b));
+}
+
+template <class A, class B, class = matrix_detail::EnableMatrixOp<A, B>>
+bool operator!=(const A& a, const B& b)
+{
+    return !(a == b);
+}
+
+template <class T>
+std::ostream& operator<<(std::ostream& os, const MatrixView<T>& v)
+{
+    for (size_t i = 0; i < v.getRows(); i++)
+    {
+        for (size_t j = 0; j < v.getColumns(); j++)
+            os << +v(i, j) << ' ';
+        os << '\n';
+    }
+    return os;
+}
+
+#include "Strassen.hpp"
+#include "MatrixView.tpp"
+
+#endif // MATRIX_VIEW_HPP
@@ -0,0 +1,152 @@
+#include <memory>
+#include <new>
+
+// In-place arithmetic
+
+template <class T>
+template <class V>
+const MatrixView<T>& MatrixView<T>::operator*=(V val) const
+{
+    static_assert(!std::is_const_v<T>, "cannot modify a read-only view");
+    const value_type v = static_cast<value_type>(val);
+    for (size_t i = 0; i < rows_; ++i) {
+        if (rowsContiguous()) {
+            matrix_kernels::scale(row_ptr(i), v, cols_);
+        } else {
+            for (size_t j = 0; j < cols_; ++j)
+                (*this)(i, j) = static_cast<value_type>((*this)(i, j) * v);
+        }
+    }
+    return *this;
+}
+
+template <class T>
+template <class M>
+const MatrixView<T>& MatrixView<T>::operator+=(const M& other) const
+{
+    static_assert(!std::is_const_v<T>, "cannot modify a read-only view");
+    MatrixView<const value_type> b = asView(other);
+    if (b.getRows() != rows_ || b.getColumns() != cols_)
+        throw std::invalid_argument("Matrices sizes do not match");
+    // v += v reads each element before writing it; any other overlap
+    // would read elements already updated
+    if (overlaps(b) && !sameLayout(b))
+        return *this += BasicMatrix<value_type>(b);
+
+    for (size_t i = 0; i < rows_; ++i) {
+        if (rowsContiguous() && b.rowsContiguous()) {
+            matrix_kernels::add(row_ptr(i), b.row_ptr(i), row_ptr(i), cols_);
+        } else {
+            for (size_t j = 0; j < cols_; ++j)
+                (*this)(i, j) = static_cast<value_type>((*this)(i, j) + b(i, j));
+        }
+    }
+    return *this;
+}
+
+template <class T>
+template <class M>
+const MatrixView<T>& MatrixView<T>::assign(const M& other) const
+{
+    static_assert(!std::is_const_v<T>, "cannot modify a read-only view");
+    MatrixView<const value_type> b = asView(other);
+    if (b.getRows() != rows_ || b.getColumns() != cols_)
+        throw std::invalid_argument("Matrices sizes do not match");
+    if (overlaps(b)) {
+        if (sameLayout(b))
+            return *this;
+        // copy_n / memcpy on overlapping ranges, or reading elements
+        // already overwritten
+        return assign(BasicMatrix<value_type>(b));
+    }
+
+    matrix_kernels::copy(rows_, cols_, b.data(), b.rowStride(), b.colStride(),
+                         data_, rowStride_, colStride_);
+    return *this;
+}
+
+// Free operators
+
+namespace matrix_detail
+{
+    template <class T>
+    BasicMatrix<T> add(MatrixView<const T> a, MatrixView<const T> b)
+    {
+        if (a.getRows() != b.getRows() || a.getColumns() != b.getColumns())
+            throw std::invalid_argument("Matrices sizes do not match");
+
+        BasicMatrix<T> result(a.getRows(), a.getColumns());
+        const size_t cols = a.getColumns();
+        for (size_t i = 0; i < a.getRows(); ++i) {
+            T* out = result.row_ptr(i);
+            if (a.rowsContiguous() && b.rowsContiguous()) {
+                matrix_kernels::add(a.row_ptr(i), b.row_ptr(i), out, cols);
+            } else {
+                for (size_t j = 0; j < cols; ++j)
+                    out[j] = static_cast<T>(a(i, j) + b(i, j));
+            }
+        }
+        return result;
+    }
+
+    template <class T>
+    BasicMatrix<T> multiply(MatrixView<const T> a, MatrixView<const T> b)
+    {
+        if (a.getColumns() != b.getRows())
+            throw std::invalid_argument("Matrices sizes do not match");
+
+        const size_t m = a.getRows(), n = b.getColumns(), k = a.getColumns();
+        BasicMatrix<T> result(m, n);
+
+        const StrassenOptions& strassenOpt = strassenOptions();
+        if (strassenOpt.threshold != 0 && m >= strassenOpt.threshold && m == n && n == k
+            && a.rowsContiguous() && b.rowsContiguous()) {
+            strassen(n, a.data(), a.rowStride(), b.data(), b.rowStride(), result.data(), n, strassenOpt);
+            return result;
+        }
+
+        if (b.rowsContiguous()) {
+            matrix_kernels::gemm(m, n, k, a.data(), a.rowStride(), a.colStride(),
+                                 b.data(), b.rowStride(), result.data(), n);
+            return result;
+        }
+
+        // B has strided rows (a column slice or a transposed view): pack one
+        // block of it at a time into a contiguous panel for the kernel.
+        using matrix_kernels::BlockCols;
+        using matrix_kernels::BlockDepth;
+        std::unique_ptr<T[]> panel(new T[BlockDepth * BlockCols]);
+        for (size_t p0 = 0; p0 < k; p0 += BlockDepth) {
+            const size_t pk = std::min(k, p0 + BlockDepth) - p0;
+            for (size_t j0 = 0; j0 < n; j0 += BlockCols) {
+                const size_t jn = std::min(n, j0 + BlockCols) - j0;
+                const T* src = b.data() + p0 * b.rowStride() + j0 * b.colStride();
+                matrix_kernels::copy(pk, jn, src, b.rowStride(), b.colStride(), panel.get(), jn, size_t(1));
+                matrix_kernels::gemm(m, jn, pk,
+                                     a.data() + p0 * a.colStride(), a.rowStride(), a.colStride(),
+                                     panel.get(), jn,
+                                     result.data() + j0, n);
+            }
+        }
+        return result;
+    }
+
+    template <class T>
+    bool equal(MatrixView<const T> a, MatrixView<const T> b)
+    {
+        if (a.getRows() != b.getRows() || a.getColumns() != b.getColumns())
+            return false;
+
+        for (size_t i = 0; i < a.getRows(); ++i) {
+            if (a.rowsContiguous() && b.rowsContiguous()) {
+                if (!matrix_kernels::equal(a.row_ptr(i), b.row_ptr(i), a.getColumns()))
+                    return false;
+            } else {
+                for (size_t j = 0; j < a.getColumns(); ++j)
+                    if (a(i, j) != b(i, j))
+                        return false;
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef SPAN_HPP
+#define SPAN_HPP
+
+#include <cassert>
+#include <cstddef>
+
+// Minimal non-owning view of a contiguous range (std::span is C++20).
+// Element access is not range-checked outside of debug builds.
+template <class T>
+class Span
+{
+    private:
+        T* data_;
+        size_t size_;
+
+    public:
+        Span() : data_(nullptr), size_(0) {}
+        Span(T* data, size_t size) : data_(data), size_(size) {}
+
+        T* data() const { return data_; }
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+        T& operator[](size_t i) const
+        {
+            assert(i < size_);
+            return data_[i];
+        }
+
+        T* begin() const { return data_; }
+        T* end() const { return data_ + size_; }
+};
+
+#endif // SPAN_HPP
@@ -0,0 +1,329 @@
+#include <algorithm>
+#include <limits>
+
+template <class T, SparseLayout Layout>
+SparseMatrix<T, Layout>::SparseMatrix(size_t rows, size_t cols)
+    : rows_(rows), cols_(cols)
+{
+    if (rows_ == 0 || cols_ == 0)
+        throw std::invalid_argument("rows and cols must be > 0");
+    if (rows_ > std::numeric_limits<index_type>::max() || cols_ > std::numeric_limits<index_type>::max())
+        throw std::invalid_argument("sparse matrix dimensions exceed index range");
+    offsets_.assign(outer() + 1, 0);
+}
+
+template <class T, SparseLayout Layout>
+template <class Access>
+SparseMatrix<T, Layout>::SparseMatrix(const BasicMatrix<T, Access>& dense)
+    : SparseMatrix(dense.getRows(), dense.getColumns())
+{
+    const T zero = T();
+
+    if (Layout == SparseLayout::CSR) {
+        for (size_t i = 0; i < rows_; ++i) {
+            const T* row = dense.row_ptr(i);
+            for (size_t j = 0; j < cols_; ++j)
+                if (row[j] != zero) {
+                    values_.push_back(row[j]);
+                    indices_.push_back(index_type(j));
+                }
+            offsets_[i + 1] = values_.size();
+        }
+        return;
+    }
+
+    // CSC: count per column, then scatter in row-major order so that row
+    // indices come out sorted within each column.
+    for (size_t i = 0; i < rows_; ++i) {
+        const T* row = dense.row_ptr(i);
+        for (size_t j = 0; j < cols_; ++j)
+            if (row[j] != zero)
+                ++offsets_[j + 1];
+    }
+    for (size_t j = 0; j < cols_; ++j)
+        offsets_[j + 1] += offsets_[j];
+    values_.resize(offsets_[cols_]);
+    indices_.resize(offsets_[cols_]);
+
+    std::vector<size_t> next(offsets_.begin(), offsets_.end() - 1);
+    for (size_t i = 0; i < rows_; ++i) {
+        const T* row = dense.row_ptr(i);
+        for (size_t j = 0; j < cols_; ++j)
+            if (row[j] != zero) {
+                const size_t k = next[j]++;
+                values_[k] = row[j];
+                indices_[k] = index_type(i);
+            }
+    }
+}
+
+template <class T, SparseLayout Layout>
+SparseMatrix<T, Layout> SparseMatrix<T, Layout>::fromTriplets(size_t rows, size_t cols,
+                                                             std::vector<Triplet> triplets)
+{
+    SparseMatrix result(rows, cols);
+    for (const Triplet& t : triplets)
+        if (t.row >= rows || t.col >= cols)
+            throw std::out_of_range("Triplet index out of range");
+
+    auto key = [](const Triplet& t) {
+        return Layout == SparseLayout::CSR ? std::make_pair(t.row, t.col)
+                                           : std::make_pair(t.col, t.row);
+    };
+    std::sort(triplets.begin(), triplets.end(),
+              [&](const Triplet& a, const Triplet& b) { return key(a) < key(b); });
+
+    size_t k = 0;
+    while (k < triplets.size()) {
+        const auto [o, in] = key(triplets[k]);
+        T sum = triplets[k].value;
+        size_t next = k + 1;
+        for (; next < triplets.size() && key(triplets[next]) == key(triplets[k]); ++next)
+            sum = static_cast<T>(sum + triplets[next].value);
+        if (sum != T()) {
+            result.values_.push_back(sum);
+            result.indices_.push_back(index_type(in));
+            ++result.offsets_[o + 1];
+        }
+        k = next;
+    }
+    for (size_t o = 0; o < result.outer(); ++o)
+        result.offsets_[o + 1] += result.offsets_[o];
+    return result;
+}
+
+template <class T, SparseLayout Layout>
+size_t SparseMatrix<T, Layout>::memoryBytes() const
+{
+    return values_.size() * sizeof(T)
+         + indices_.size() * sizeof(index_type)
+         + offsets_.size() * sizeof(size_t);
+}
+
+template <class T, SparseLayout Layout>
+T SparseMatrix<T, Layout>::at(size_t i, size_t j) const
+{
+    if (i >= rows_ || j >= cols_)
+        throw std::out_of_range("Matrix indice out of range");
+
+    const size_t o = Layout == SparseLayout::CSR ? i : j;
+    const index_type in = index_type(Layout == SparseLayout::CSR ? j : i);
+    auto first = indices_.begin() + offsets_[o];
+    auto last = indices_.begin() + offsets_[o + 1];
+    auto it = std::lower_bound(first, last, in);
+    if (it == last || *it != in)
+        return T();
+    return values_[size_t(it - indices_.begin())];
+}
+
+template <class T, SparseLayout Layout>
+BasicMatrix<T> SparseMatrix<T, Layout>::toDense() const
+{
+    BasicMatrix<T> dense(rows_, cols_);
+    T* out = dense.data();
+    for (size_t o = 0; o < outer(); ++o)
+        for (size_t k = offsets_[o]; k < offsets_[o + 1]; ++k) {
+            const size_t i = Layout == SparseLayout::CSR ? o : indices_[k];
+            const size_t j = Layout == SparseLayout::CSR ? indices_[k] : o;
+            out[i * cols_ + j] = values_[k];
+        }
+    return dense;
+}
+
+// Converting between layouts is a transpose of the index structure:
+// a counting sort on the inner index.
+template <class T, SparseLayout Layout>
+SparseMatrix<T, SparseLayout::CSR> SparseMatrix<T, Layout>::toCSR() const
+{
+    if constexpr (Layout == SparseLayout::CSR) {
+        return *this;
+    } else {
+        SparseMatrix<T, SparseLayout::CSR> result(rows_, cols_);
+        std::vector<size_t>& offs = result.offsets_;
+        for (index_type r : indices_)
+            ++offs[r + 1];
+        for (size_t i = 0; i < rows_; ++i)
+            offs[i + 1] += offs[i];
+        result.values_.resize(nnz());
+        result.indices_.resize(nnz());
+        std::vector<size_t> next(offs.begin(), offs.end() - 1);
+        for (size_t j = 0; j < cols_; ++j)
+            for (size_t k = offsets_[j]; k < offsets_[j + 1]; ++k) {
+                const size_t dst = next[indices_[k]]++;
+                result.values_[dst] = values_[k];
+                result.indices_[dst] = index_type(j);
+            }
+        return result;
+    }
+}
+
+template <class T, SparseLayout Layout>
+SparseMatrix<T, SparseLayout::CSC> SparseMatrix<T, Layout>::toCSC() const
+{
+    if constexpr (Layout == SparseLayout::CSC) {
+        return *this;
+    } else {
+        SparseMatrix<T, SparseLayout::CSC> result(rows_, cols_);
+        std::vector<size_t>& offs = result.offsets_;
+        for (index_type c : indices_)
+            ++offs[c + 1];
+        for (size_t j = 0; j < cols_; ++j)
+            offs[j + 1] += offs[j];
+        result.values_.resize(nnz());
+        result.indices_.resize(nnz());
+        std::vector<size_t> next(offs.begin(), offs.end() - 1);
+        for (size_t i = 0; i < rows_; ++i)
+            for (size_t k = offsets_[i]; k < offsets_[i + 1]; ++k) {
+                const size_t dst = next[indices_[k]]++;
+                result.values_[dst] = values_[k];
+                result.indices_[dst] = index_type(i);
+            }
+        return result;
+    }
+}
+
+template <class T, SparseLayout Layout>
+void SparseMatrix<T, Layout>::spmvRows(const T* x, T* y, size_t lo, size_t hi) const
+{
+    const T* values = values_.data();
+    const index_type* indices = indices_.data();
+    for (size_t i = lo; i < hi; ++i) {
+        T sum = T();
+        for (size_t k = offsets_[i]; k < offsets_[i + 1]; ++k)
+            sum = matrix_kernels::madd(sum, values[k], x[indices[k]]);
+        y[i] = sum;
+    }
+}
+
+template <class T, SparseLayout Layout>
+void SparseMatrix<T, Layout>::spmv(const T* x, T* y) const
+{
+    if constexpr (Layout == SparseLayout::CSR) {
+        spmvRows(x, y, 0, rows_);
+    } else {
+        std::fill_n(y, rows_, T());
+        for (size_t j = 0; j < cols_; ++j) {
+            const T xj = x[j];
+            for (size_t k = offsets_[j]; k < offsets_[j + 1]; ++k)
+                y[indices_[k]] = matrix_kernels::madd(y[indices_[k]], values_[k], xj);
+        }
+    }
+}
+
+template <class T, SparseLayout Layout>
+std::vector<T> SparseMatrix<T, Layout>::operator*(const std::vector<T>& x) const
+{
+    if (x.size() != cols_)
+        throw std::invalid_argument("Vector size does not match");
+    std::vector<T> y(rows_);
+    spmv(x.data(), y.data());
+    return y;
+}
+
+template <class T, SparseLayout Layout>
+void SparseMatrix<T, Layout>::spmvParallel(const T* x, T* y, ThreadPool& pool) const
+{
+    // below this many non-zeros per task, threading costs more than it saves
+    constexpr size_t MinNnzPerTask = 16 * 1024;
+    const size_t tasks = std::min(pool.concurrency() * 4, std::max<size_t>(1, nnz() / MinNnzPerTask));
+    if (tasks <= 1) {
+        spmv(x, y);
+        return;
+    }
+
+    TaskGroup group(pool);
+    if constexpr (Layout == SparseLayout::CSR) {
+        // split rows so that every task gets about nnz / tasks elements
+        size_t lo = 0;
+        for (size_t t = 1; t <= tasks && lo < rows_; ++t) {
+            const size_t target = nnz() * t / tasks;
+            size_t hi = t == tasks ? rows_
+                : size_t(std::lower_bound(offsets_.begin() + lo, offsets_.end() - 1, target) - offsets_.begin());
+            hi = std::max(hi, lo + 1);
+            group.run([this, x, y, lo, hi] { spmvRows(x, y, lo, hi); });
+            lo = hi;
+        }
+        group.wait();
+    } else {
+        // columns scatter into arbitrary rows: give each task a private
+        // accumulator and sum them afterwards
+        std::vector<std::vector<T>> partial(tasks);
+        const size_t step = (cols_ + tasks - 1) / tasks;
+        for (size_t t = 0; t < tasks; ++t) {
+            const size_t lo = std::min(cols_, t * step);
+            const size_t hi = std::min(cols_, lo + step);
+            group.run([this, x, lo, hi, &acc = partial[t]] {
+                acc.assign(rows_, T());
+                for (size_t j = lo; j < hi; ++j)
+                    for (size_t k = offsets_[j]; k < offsets_[j + 1]; ++k)
+                        acc[indices_[k]] = matrix_kernels::madd(acc[indices_[k]], values_[k], x[j]);
+            });
+        }
+        group.wait();
+        std::copy(partial[0].begin(), partial[0].end(), y);
+        for (size_t t = 1; t < tasks; ++t)
+            matrix_kernels::add(y, partial[t].data(), y, rows_);
+    }
+}
+
+template <class T, SparseLayout Layout>
+template <class Access>
+BasicMatrix<T> SparseMatrix<T, Layout>::operator*(const BasicMatrix<T, Access>& dense) const
+{
+    if (cols_ != dense.getRows())
+        throw std::invalid_argument("Matrices sizes do not match");
+
+    const size_t n = dense.getColumns();
+    BasicMatrix<T> result(rows_, n);
+    // every non-zero A(i, k) adds A(i, k) * B[k, :] to C[i, :]
+    for (size_t o = 0; o < outer(); ++o)
+        for (size_t k = offsets_[o]; k < offsets_[o + 1]; ++k) {
+            const size_t i = Layout == SparseLayout::CSR ? o : indices_[k];
+            const size_t p = Layout == SparseLayout::CSR ? indices_[k] : o;
+            matrix_kernels::axpy(result.row_ptr(i), values_[k], dense.row_ptr(p), n);
+        }
+    return result;
+}
+
+template <class T, SparseLayout Layout>
+SparseMatrix<T, Layout> SparseMatrix<T, Layout>::operator+(const SparseMatrix& other) const
+{
+    if (rows_ != other.rows_ || cols_ != other.cols_)
+        throw std::invalid_argument("Matrices sizes do not match");
+
+    SparseMatrix result(rows_, cols_);
+    result.values_.reserve(nnz() + other.nnz());
+    result.indices_.reserve(nnz() + other.nnz());
+
+    auto push = [&result](index_type in, T v) {
+        if (v != T()) {
+            result.values_.push_back(v);
+            result.indices_.push_back(in);
+        }
+    };
+
+    // merge the two sorted inner index lists of every outer slice
+    for (size_t o = 0; o < outer(); ++o) {
+        size_t a = offsets_[o], aEnd = offsets_[o + 1];
+        size_t b = other.offsets_[o], bEnd = other.offsets_[o + 1];
+        while (a < aEnd && b < bEnd) {
+            if (indices_[a] < other.indices_[b]) {
+                push(indices_[a], values_[a]);
+                ++a;
+            } else if (other.indices_[b] < indices_[a]) {
+                push(other.indices_[b], other.values_[b]);
+                ++b;
+            } else {
+                push(indices_[a], static_cast<T>(values_[a] + other.values_[b]));
+                ++a;
+                ++b;
+            }
+        }
+        for (; a < aEnd; ++a)
+            push(indices_[a], values_[a]);
+        for (; b < bEnd; ++b)
+            push(other.indices_[b], other.values_[b]);
+        result.offsets_[o + 1] = result.values_.size();
+    }
+    return result;
+}
@@ -0,0 +1,190 @@
+#ifndef STRASSEN_HPP
+#define STRASSEN_HPP
+
+// Included from Matrix.hpp.
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include "MatrixKernels.hpp"
+#include "ThreadPool.hpp"
+
+// Strassen-Winograd multiplication for large square products: 7 half-size
+// products and 15 additions per level instead of 8 products, i.e.
+// O(n^2.81). Below leafSize the recursion uses the blocked gemm kernel.
+//
+// It reassociates sums, so floating point results differ from the blocked
+// kernel in the last bits; this is why operator* only uses it when
+// threshold has been set. Signed integers are multiplied in the unsigned
+// type of the same width (see strassen() below).
+struct StrassenOptions
+{
+    // square products with n >= threshold use Strassen; 0 disables it
+    size_t threshold = 0;
+    // recursion stops at or below this size
+    size_t leafSize = 256;
+    // recursion levels whose 7 subproducts run as ThreadPool tasks
+    size_t parallelDepth = 2;
+};
+
+// Process-wide options read by Matrix::operator*. Set them before starting
+// threads that multiply matrices.
+inline StrassenOptions& strassenOptions()
+{
+    static StrassenOptions options;
+    return options;
+}
+
+namespace matrix_detail
+{
+    // out = x + y / x - y on h x h blocks with leading dimensions
+    template <class T>
+    void addBlocks(size_t h, const T* x, size_t ldx, const T* y, size_t ldy, T* out, size_t ldo)
+    {
+        for (size_t i = 0; i < h; ++i)
+            matrix_kernels::add(x + i * ldx, y + i * ldy, out + i * ldo, h);
+    }
+
+    template <class T>
+    void subBlocks(size_t h, const T* x, size_t ldx, const T* y, size_t ldy, T* out, size_t ldo)
+    {
+        for (size_t i = 0; i < h; ++i)
+            matrix_kernels::sub(x + i * ldx, y + i * ldy, out + i * ldo, h);
+    }
+
+    // C[n x n] = A[n x n] * B[n x n], all row-major with leading dimensions.
+    template <class T>
+    void strassenLevel(size_t n, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc,
+                       const StrassenOptions& opt, size_t depth)
+    {
+        if (n <= opt.leafSize || n < 2) {
+            for (size_t i = 0; i < n; ++i)
+                std::fill_n(c + i * ldc, n, T());
+            matrix_kernels::gemm(n, n, n, a, lda, b, ldb, c, ldc);
+            return;
+        }
+
+        if (n % 2 != 0) {
+            // Peel the last row and column:
+            //   C[0:m, 0:m] = A[0:m, 0:m] B[0:m, 0:m] + A[0:m, m] B[m, 0:m]
+            //   C[0:m, m]   = A[0:m, :] B[:, m]
+            //   C[m, :]     = A[m, :] B
+            const size_t m = n - 1;
+            strassenLevel(m, a, lda, b, ldb, c, ldc, opt, depth);
+            matrix_kernels::gemm(m, m, 1, a + m, lda, b + m * ldb, ldb, c, ldc);
+            for (size_t i = 0; i < m; ++i)
+                c[i * ldc + m] = T();
+            matrix_kernels::gemm(m, 1, n, a, lda, b + m, ldb, c + m, ldc);
+            std::fill_n(c + m * ldc, n, T());
+            matrix_kernels::gemm(1, n, n, a + m * lda, lda, b, ldb, c + m * ldc, ldc);
+            return;
+        }
+
+        const size_t h = n / 2;
+        const T* a11 = a;            const T* a12 = a + h;
+        const T* a21 = a + h * lda;  const T* a22 = a21 + h;
+        const T* b11 = b;            const T* b12 = b + h;
+        const T* b21 = b + h * ldb;  const T* b22 = b21 + h;
+        T* c11 = c;                  T* c12 = c + h;
+        T* c21 = c + h * ldc;        T* c22 = c21 + h;
+
+        // scratch: S1..S4, T1..T4 and the seven products, each h x h
+        BasicMatrix<T> scratch(15 * h, h);
+        auto block = [&](size_t k) { return scratch.data() + k * h * h; };
+        T *s1 = block(0), *s2 = block(1), *s3 = block(2), *s4 = block(3);
+        T *t1 = block(4), *t2 = block(5), *t3 = block(6), *t4 = block(7);
+        T* mm[7];
+        for (size_t k = 0; k < 7; ++k)
+            mm[k] = block(8 + k);
+
+        addBlocks(h, a21, lda, a22, lda, s1, h);  // S1 = A21 + A22
+        subBlocks(h, s1, h, a11, lda, s2, h);     // S2 = S1 - A11
+        subBlocks(h, a11, lda, a21, lda, s3, h);  // S3 = A11 - A21
+        subBlocks(h, a12, lda, s2, h, s4, h);     // S4 = A12 - S2
+        subBlocks(h, b12, ldb, b11, ldb, t1, h);  // T1 = B12 - B11
+        subBlocks(h, b22, ldb, t1, h, t2, h);     // T2 = B22 - T1
+        subBlocks(h, b22, ldb, b12, ldb, t3, h);  // T3 = B22 - B12
+        subBlocks(h, t2, h, b21, ldb, t4, h);     // T4 = T2 - B21
+
+        struct Product { const T* x; size_t ldx; const T* y; size_t ldy; };
+        const Product products[7] = {
+            {a11, lda, b11, ldb}, // M1 = A11 B11
+            {a12, lda, b21, ldb}, // M2 = A12 B21
+            {s4, h, b22, ldb},    // M3 = S4 B22
+            {a22, lda, t4, h},    // M4 = A22 T4
+            {s1, h, t1, h},       // M5 = S1 T1
+            {s2, h, t2, h},       // M6 = S2 T2
+            {s3, h, t3, h},       // M7 = S3 T3
+        };
+
+        if (depth < opt.parallelDepth) {
+            TaskGroup group;
+            for (size_t k = 1; k < 7; ++k)
+                group.run([&, k] {
+                    strassenLevel(h, products[k].x, products[k].ldx, products[k].y, products[k].ldy,
+                                  mm[k], h, opt, depth + 1);
+                });
+            strassenLevel(h, products[0].x, products[0].ldx, products[0].y, products[0].ldy, mm[0], h, opt, depth + 1);
+            group.wait();
+        } else {
+            for (size_t k = 0; k < 7; ++k)
+                strassenLevel(h, products[k].x, products[k].ldx, products[k].y, products[k].ldy,
+                              mm[k], h, opt, depth + 1);
+        }
+
+        // C11 = M1 + M2
+        // U2 = M1 + M6, U3 = U2 + M7, U4 = U2 + M5
+        // C12 = U4 + M3, C21 = U3 - M4, C22 = U3 + M5
+        T* u2 = s1; // S/T blocks are free again
+        T* u3 = s2;
+        addBlocks(h, mm[0], h, mm[1], h, c11, ldc);
+        addBlocks(h, mm[0], h, mm[5], h, u2, h);
+        addBlocks(h, u2, h, mm[6], h, u3, h);
+        addBlocks(h, u2, h, mm[4], h, u2, h);
+        addBlocks(h, u2, h, mm[2], h, c12, ldc);
+        subBlocks(h, u3, h, mm[3], h, c21, ldc);
+        addBlocks(h, u3, h, mm[4], h, c22, ldc);
+    }
+
+    // Entry point of the recursion. The pre-sums S1..S4 and T1..T4 of a
+    // signed integer matrix can overflow even when every element of the
+    // product fits, so those run in the unsigned type of the same width:
+    // wraparound keeps the result exact modulo 2^N, which is the product
+    // itself whenever the classical algorithm would not overflow either.
+    template <class T>
+    void strassen(size_t n, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc,
+                  const StrassenOptions& opt)
+    {
+        if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            using U = std::make_unsigned_t<T>;
+            strassenLevel(n, reinterpret_cast<const U*>(a), lda, reinterpret_cast<const U*>(b), ldb,
+                          reinterpret_cast<U*>(c), ldc, opt, 0);
+        } else {
+            strassenLevel(n, a, lda, b, ldb, c, ldc, opt, 0);
+        }
+    }
+}
+
+// Strassen-Winograd product of two square matrices (or views with
+// contiguous rows), regardless of strassenOptions().threshold.
+template <class A, class B, class = matrix_detail::EnableMatrixOp<A, B>>
+BasicMatrix<matrix_detail::value_t<A>> multiplyStrassen(const A& a, const B& b,
+                                                   const StrassenOptions& options = strassenOptions())
+{
+    using T = matrix_detail::value_t<A>;
+    MatrixView<const T> va = asView(a);
+    MatrixView<const T> vb = asView(b);
+    const size_t n = va.getRows();
+    if (va.getColumns() != n || vb.getRows() != n || vb.getColumns() != n)
+        throw std::invalid_argument("Strassen needs square matrices of the same size");
+    if (!va.rowsContiguous() || !vb.rowsContiguous())
+        throw std::invalid_argument("Strassen needs views with contiguous rows");
+
+    BasicMatrix<T> result(n, n);
+    matrix_detail::strassen(n, va.data(), va.rowStride(), vb.data(), vb.rowStride(),
+                            result.data(), n, options);
+    return result;
+}
+
+#endif // STRASSEN_HPP
@@ -0,0 +1,108 @@
+#include "../include/MatrixIO.hpp"
+
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    constexpr char Magic[8] = {'M', 'A', 'T', 'R', 'I', 'X', '\0', '\0'};
+    constexpr uint32_t EndianTag = 0x01020304;
+
+    // A StorageBlock owning an mmap'ed file.
+    struct MappedBlock : matrix_detail::StorageBlock
+    {
+        void* addr = nullptr;
+        size_t length = 0;
+
+        static void unmap(matrix_detail::StorageBlock* block)
+        {
+            MappedBlock* self = static_cast<MappedBlock*>(block);
+            ::munmap(self->addr, self->length);
+            delete self;
+        }
+    };
+}
+
+namespace matrix_io
+{
+    FileHeader makeHeader(ElementType type, size_t elementSize, size_t rows, size_t cols)
+    {
+        FileHeader header{};
+        std::memcpy(header.magic, Magic, sizeof(Magic));
+        header.endianTag = EndianTag;
+        header.version = FormatVersion;
+        header.elementType = static_cast<uint32_t>(type);
+        header.elementSize = static_cast<uint32_t>(elementSize);
+        header.rows = rows;
+        header.cols = cols;
+        header.dataOffset = DataOffset;
+        header.alignment = static_cast<uint32_t>(DataOffset);
+        return header;
+    }
+
+    void checkHeader(const FileHeader& header, ElementType type, size_t elementSize)
+    {
+        if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0)
+            throw std::runtime_error("not a matrix file");
+        if (header.endianTag != EndianTag)
+            throw std::runtime_error("matrix file has foreign byte order");
+        if (header.version != FormatVersion)
+            throw std::runtime_error("unsupported matrix file version");
+        if (header.elementType != static_cast<uint32_t>(type) || header.elementSize != elementSize)
+            throw std::runtime_error("matrix file element type mismatch");
+        if (header.rows == 0 || header.cols == 0)
+            throw std::runtime_error("matrix file has empty dimensions");
+        if (header.dataOffset < sizeof(FileHeader) || header.alignment == 0
+            || header.dataOffset % header.alignment != 0)
+            throw std::runtime_error("matrix file has a bad data offset");
+        if (header.cols > UINT64_MAX / header.rows / elementSize)
+            throw std::runtime_error("matrix file dimensions overflow");
+    }
+
+    matrix_detail::StorageBlock* mapFile(const std::string& path, ElementType type, size_t elementSize,
+                                         FileHeader& header, const void** data)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("cannot open " + path);
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(FileHeader)) {
+            ::close(fd);
+            throw std::runtime_error("cannot map " + path);
+        }
+
+        const size_t length = size_t(st.st_size);
+        std::unique_ptr<MappedBlock> block(new MappedBlock());
+        void* addr = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // the mapping keeps the file alive
+        if (addr == MAP_FAILED)
+            throw std::runtime_error("cannot map " + path);
+
+        try {
+            std::memcpy(&header, addr, sizeof(FileHeader));
+            checkHeader(header, type, elementSize);
+            const uint64_t bytes = header.rows * header.cols * elementSize;
+            if (header.dataOffset > length || bytes > length - header.dataOffset)
+                throw std::runtime_error("matrix file is truncated");
+            if (header.dataOffset % DataOffset != 0)
+                throw std::runtime_error("matrix file data is not aligned");
+        } catch (...) {
+            ::munmap(addr, length);
+            throw;
+        }
+
+        block->writable = false;
+        block->release = &MappedBlock::unmap;
+        block->addr = addr;
+        block->length = length;
+        *data = static_cast<const char*>(addr) + header.dataOffset;
+        return block.release();
+    }
+}
@@ -0,0 +1,6 @@
+#include "../include/SparseMatrix.hpp"
+
+template class SparseMatrix<float, SparseLayout::CSR>;
+template class SparseMatrix<float, SparseLayout::CSC>;
+template class SparseMatrix<double, SparseLayout::CSR>;
+template class SparseMatrix<double, SparseLayout::CSC>;
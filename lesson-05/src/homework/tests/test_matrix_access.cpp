@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include "../include/Matrix.hpp"
+
+TEST(MatrixAccess, RawPointersAreRowMajor) {
+    BasicMatrix<int32_t> m(3, 4);
+    for (size_t i = 0; i < 3; ++i)
+        for (size_t j = 0; j < 4; ++j)
+            m[i][j] = int32_t(i * 10 + j);
+
+    EXPECT_EQ(m.data()[2 * 4 + 1], 21);
+    EXPECT_EQ(m.row_ptr(1), m.data() + 4);
+    EXPECT_EQ(m.row_ptr(2)[3], 23);
+
+    Span<int32_t> row = m.row_span(1);
+    EXPECT_EQ(row.size(), 4u);
+    int32_t sum = 0;
+    for (int32_t v : row)
+        sum += v;
+    EXPECT_EQ(sum, 10 + 11 + 12 + 13);
+
+    row[0] = -1;
+    EXPECT_EQ(m.at(1, 0), -1);
+}
+
+TEST(MatrixAccess, ConstSpan) {
+    BasicMatrix<double> m(2, 2);
+    m[1][0] = 1.5;
+    const BasicMatrix<double>& c = m;
+    Span<const double> row = c.row_span(1);
+    EXPECT_EQ(row[0], 1.5);
+    EXPECT_EQ(c.row_ptr(1)[0], 1.5);
+}
+
+TEST(MatrixAccess, UncheckedPolicy) {
+    BasicMatrix<float, UncheckedAccess> m(2, 3);
+    m[1][2] = 4.0f;
+    EXPECT_EQ(m.at(1, 2), 4.0f);
+    // at() keeps throwing regardless of the policy
+    EXPECT_THROW(m.at(2, 0), std::out_of_range);
+
+    BasicMatrix<float, UncheckedAccess> n = m + m;
+    EXPECT_EQ(n[1][2], 8.0f);
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include "../include/MatrixAlgorithms.hpp"
+#include "test_utils.hpp"
+
+#include <cmath>
+#include <limits>
+
+TEST(MatrixAlgorithms, WholeReductions) {
+    BasicMatrix<int32_t> m(2, 3);
+    m[0][0] = 1; m[0][1] = -2; m[0][2] = 3;
+    m[1][0] = -4; m[1][1] = 5; m[1][2] = -6;
+
+    EXPECT_EQ(matrix_ops::sum(m), -3);
+    EXPECT_EQ(matrix_ops::min(m), -6);
+    EXPECT_EQ(matrix_ops::max(m), 5);
+    EXPECT_EQ(matrix_ops::dot(m, m), 91);
+    EXPECT_DOUBLE_EQ(matrix_ops::frobeniusNorm(m), std::sqrt(91.0));
+    EXPECT_DOUBLE_EQ(matrix_ops::normInf(m), 15.0);
+    EXPECT_DOUBLE_EQ(matrix_ops::norm1(m), 9.0);
+
+    // narrow types are summed in 64 bits
+    BasicMatrix<int8_t> big(100, 100);
+    for (size_t i = 0; i < 100; ++i)
+        for (size_t j = 0; j < 100; ++j)
+            big[i][j] = 100;
+    EXPECT_EQ(matrix_ops::sum(big), 1000000);
+}
+
+TEST(MatrixAlgorithms, RowAndColumnReductions) {
+    BasicMatrix<int32_t> m(2, 3);
+    m[0][0] = 1; m[0][1] = -2; m[0][2] = 3;
+    m[1][0] = -4; m[1][1] = 5; m[1][2] = -6;
+
+    BasicMatrix<int64_t> rs = matrix_ops::rowSums(m);
+    ASSERT_EQ(rs.getRows(), 2u);
+    ASSERT_EQ(rs.getColumns(), 1u);
+    EXPECT_EQ(rs[0][0], 2);
+    EXPECT_EQ(rs[1][0], -5);
+
+    BasicMatrix<int64_t> cs = matrix_ops::colSums(m);
+    ASSERT_EQ(cs.getRows(), 1u);
+    ASSERT_EQ(cs.getColumns(), 3u);
+    EXPECT_EQ(cs[0][0], -3);
+    EXPECT_EQ(cs[0][1], 3);
+    EXPECT_EQ(cs[0][2], -3);
+
+    EXPECT_EQ(matrix_ops::rowMin(m)[1][0], -6);
+    EXPECT_EQ(matrix_ops::rowMax(m)[0][0], 3);
+    EXPECT_EQ(matrix_ops::colMin(m)[0][1], -2);
+    EXPECT_EQ(matrix_ops::colMax(m)[0][2], 3);
+}
+
+TEST(MatrixAlgorithms, ParallelMatchesSequential) {
+    BasicMatrix<int32_t> m = filled<int32_t>(300, 257);
+    BasicMatrix<int32_t> n = filled<int32_t>(300, 257).transpose().transpose();
+    n *= 3;
+    ThreadPool pool(4);
+    const matrix_ops::Parallel par{&pool};
+
+    EXPECT_EQ(matrix_ops::sum(par, m), matrix_ops::sum(m));
+    EXPECT_EQ(matrix_ops::min(par, m), -50);
+    EXPECT_EQ(matrix_ops::max(par, m), 49);
+    EXPECT_EQ(matrix_ops::dot(par, m, n), matrix_ops::dot(m, n));
+    EXPECT_DOUBLE_EQ(matrix_ops::norm1(par, m), matrix_ops::norm1(m));
+    EXPECT_DOUBLE_EQ(matrix_ops::normInf(par, m), matrix_ops::normInf(m));
+    EXPECT_TRUE(matrix_ops::rowSums(par, m) == matrix_ops::rowSums(m));
+    EXPECT_TRUE(matrix_ops::colSums(par, m) == matrix_ops::colSums(m));
+    EXPECT_TRUE(matrix_ops::colMin(par, m) == matrix_ops::colMin(m));
+    EXPECT_TRUE(matrix_ops::colMax(par, m) == matrix_ops::colMax(m));
+    EXPECT_TRUE(matrix_ops::abs(par, m) == matrix_ops::abs(m));
+
+    // column sums against a plain loop
+    BasicMatrix<int64_t> cs = matrix_ops::colSums(par, m);
+    for (size_t j = 0; j < 257; ++j) {
+        int64_t s = 0;
+        for (size_t i = 0; i < 300; ++i)
+            s += m[i][j];
+        EXPECT_EQ(cs[0][j], s);
+    }
+}
+
+TEST(MatrixAlgorithms, Views) {
+    BasicMatrix<double> m = filled<double>(40, 30);
+    MatrixView<const double> t = m.view().transposed();
+
+    // reductions over a transposed view swap rows and columns
+    EXPECT_TRUE(matrix_ops::rowSums(t) == matrix_ops::colSums(m).view().transposed());
+    EXPECT_TRUE(matrix_ops::colMax(t) == matrix_ops::rowMax(m).view().transposed());
+    EXPECT_DOUBLE_EQ(matrix_ops::norm1(t), matrix_ops::normInf(m));
+
+    MatrixView<const double> sub = m.view().submatrix(5, 3, 10, 7);
+    double s = 0;
+    for (size_t i = 0; i < 10; ++i)
+        for (size_t j = 0; j < 7; ++j)
+            s += m[5 + i][3 + j];
+    EXPECT_DOUBLE_EQ(matrix_ops::sum(sub), s);
+    EXPECT_DOUBLE_EQ(matrix_ops::sum(matrix_ops::par, sub), s);
+}
+
+TEST(MatrixAlgorithms, Elementwise) {
+    BasicMatrix<float> m = filled<float>(20, 13);
+
+    BasicMatrix<double> halves = matrix_ops::map(m, [](float x) { return x / 2.0; });
+    BasicMatrix<float> prod = matrix_ops::zip(m, m.view(), [](float x, float y) { return x * y; });
+    BasicMatrix<float> c = matrix_ops::clamp(m, -10.f, 10.f);
+    BasicMatrix<float> a = matrix_ops::abs(m.view().transposed());
+    for (size_t i = 0; i < 20; ++i)
+        for (size_t j = 0; j < 13; ++j) {
+            EXPECT_DOUBLE_EQ(halves[i][j], m[i][j] / 2.0);
+            EXPECT_FLOAT_EQ(prod[i][j], m[i][j] * m[i][j]);
+            EXPECT_FLOAT_EQ(c[i][j], std::min(10.f, std::max(-10.f, m[i][j])));
+            EXPECT_FLOAT_EQ(a[j][i], std::fabs(m[i][j]));
+        }
+
+    EXPECT_TRUE(matrix_ops::map(matrix_ops::par, m, [](float x) { return x + 1; }) == matrix_ops::map(m, [](float x) { return x + 1; }));
+    EXPECT_THROW(matrix_ops::clamp(m, 1.f, -1.f), std::invalid_argument);
+    EXPECT_THROW(matrix_ops::zip(m, BasicMatrix<float>(13, 20), [](float x, float y) { return x + y; }),
+                 std::invalid_argument);
+    EXPECT_THROW(matrix_ops::dot(m, BasicMatrix<float>(20, 12)), std::invalid_argument);
+}
+
+TEST(MatrixAlgorithms, AbsOfSignedLimits) {
+    // the minimum has no positive counterpart in T: abs is unsigned
+    BasicMatrix<int32_t> m(2, 2);
+    m[0][0] = std::numeric_limits<int32_t>::min();
+    m[0][1] = std::numeric_limits<int32_t>::max();
+    m[1][0] = -1;
+    m[1][1] = 0;
+    BasicMatrix<uint32_t> a = matrix_ops::abs(m);
+    EXPECT_EQ(a[0][0], 2147483648u);
+    EXPECT_EQ(a[0][1], 2147483647u);
+    EXPECT_EQ(a[1][0], 1u);
+    EXPECT_EQ(a[1][1], 0u);
+
+    BasicMatrix<int8_t> small(1, 2);
+    small[0][0] = std::numeric_limits<int8_t>::min();
+    small[0][1] = -5;
+    BasicMatrix<uint8_t> b = matrix_ops::abs(matrix_ops::par, small);
+    EXPECT_EQ(b[0][0], 128);
+    EXPECT_EQ(b[0][1], 5);
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include "../include/Matrix.hpp"
+#include "../include/MatrixArena.hpp"
+
+namespace
+{
+    // Forwards to new/delete and counts live allocations.
+    class CountingResource : public std::pmr::memory_resource
+    {
+        public:
+            size_t live = 0;
+            size_t total = 0;
+
+        private:
+            void* do_allocate(size_t bytes, size_t alignment) override
+            {
+                ++live;
+                ++total;
+                return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+            }
+
+            void do_deallocate(void* p, size_t bytes, size_t alignment) override
+            {
+                --live;
+                std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+            {
+                return this == &other;
+            }
+    };
+
+    bool aligned(const BasicMatrix<float>& m)
+    {
+        return reinterpret_cast<uintptr_t>(m.data()) % BasicMatrix<float>::Alignment == 0;
+    }
+}
+
+TEST(MatrixResource, AllocatesFromResource) {
+    CountingResource res;
+    {
+        BasicMatrix<float> a(8, 8, &res);
+        EXPECT_EQ(a.resource(), &res);
+        EXPECT_EQ(res.live, 1u);
+        EXPECT_TRUE(aligned(a));
+        a[1][1] = 2.f;
+
+        // results of member arithmetic use the left operand's resource
+        BasicMatrix<float> b(8, 8);
+        EXPECT_EQ(b.resource(), nullptr);
+        BasicMatrix<float> sum = a + b;
+        BasicMatrix<float> prod = a * a;
+        BasicMatrix<float> t = a.transpose();
+        EXPECT_EQ(sum.resource(), &res);
+        EXPECT_EQ(prod.resource(), &res);
+        EXPECT_EQ(t.resource(), &res);
+        EXPECT_EQ((b + a).resource(), nullptr);
+        EXPECT_FLOAT_EQ(prod[1][1], 4.f);
+        EXPECT_EQ(res.live, 4u);
+
+        // deep copies go to the heap unless a resource is given
+        BasicMatrix<float> copy = a;
+        EXPECT_EQ(copy.resource(), nullptr);
+        BasicMatrix<float> copyIn(b, &res);
+        EXPECT_EQ(copyIn.resource(), &res);
+
+        // assignment keeps the target's resource, moves carry the buffer
+        b = a;
+        EXPECT_EQ(b.resource(), nullptr);
+        BasicMatrix<float> moved = std::move(sum);
+        EXPECT_EQ(moved.resource(), &res);
+        EXPECT_EQ(res.live, 5u);
+    }
+    EXPECT_EQ(res.live, 0u);
+}
+
+TEST(MatrixResource, CopyOnWriteDetachStaysInResource) {
+    CountingResource res;
+    BasicMatrix<float> a(4, 4, &res);
+    a.setCopyOnWrite(true);
+    BasicMatrix<float> b = a;
+    EXPECT_EQ(res.total, 1u);
+    b[0][0] = 1.f;
+    EXPECT_EQ(b.resource(), &res);
+    EXPECT_EQ(res.total, 2u);
+}
+
+TEST(MatrixArena, ResetReusesChunks) {
+    MatrixArena arena(4096);
+    const float* first = nullptr;
+    for (int batch = 0; batch < 3; ++batch) {
+        {
+            BasicMatrix<float> a(10, 10, &arena);
+            BasicMatrix<float> b(10, 10, &arena);
+            a[9][9] = 1.f;
+            b[9][9] = 2.f;
+            BasicMatrix<float> c = a + b;
+            EXPECT_FLOAT_EQ(c[9][9], 3.f);
+            EXPECT_TRUE(aligned(a) && aligned(b) && aligned(c));
+
+            if (batch == 0)
+                first = static_cast<const BasicMatrix<float>&>(a).data();
+            else
+                EXPECT_EQ(static_cast<const BasicMatrix<float>&>(a).data(), first);
+
+            // larger than a chunk: gets its own chunk
+            BasicMatrix<float> big(64, 64, &arena);
+            EXPECT_TRUE(aligned(big));
+        }
+        EXPECT_GT(arena.bytesUsed(), 64u * 64u * sizeof(float));
+        arena.reset();
+        EXPECT_EQ(arena.bytesUsed(), 0u);
+    }
+    // the first batch sized the arena; later ones allocated nothing new
+    EXPECT_LT(arena.bytesReserved(), 2u * 4096u + 64u * 64u * sizeof(float) + 256u);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "../include/Matrix.hpp"
+#include "test_utils.hpp"
+
+#include <cstdio>
+
+namespace
+{
+    const int32_t* buffer(const BasicMatrix<int32_t>& m) { return m.data(); }
+}
+
+TEST(MatrixCopyOnWrite, OffByDefault) {
+    BasicMatrix<int32_t> m = numbered(4, 5);
+    BasicMatrix<int32_t> copy = m;
+    EXPECT_FALSE(m.isCopyOnWrite());
+    EXPECT_FALSE(copy.isCopyOnWrite());
+    EXPECT_FALSE(m.isShared());
+    EXPECT_NE(buffer(copy), buffer(m));
+}
+
+TEST(MatrixCopyOnWrite, CopiesShareUntilWrite) {
+    BasicMatrix<int32_t> m = numbered(4, 5);
+    m.setCopyOnWrite(true);
+
+    const BasicMatrix<int32_t> a = m;
+    BasicMatrix<int32_t> b = a;
+    EXPECT_TRUE(b.isCopyOnWrite());
+    EXPECT_TRUE(m.isShared());
+    EXPECT_EQ(buffer(a), buffer(m));
+    EXPECT_EQ(buffer(b), buffer(m));
+
+    // const reads never copy
+    const BasicMatrix<int32_t>& cb = b;
+    EXPECT_EQ(a[3][4], 304);
+    EXPECT_EQ(cb.at(1, 2), 102);
+    EXPECT_TRUE(a == b);
+    EXPECT_EQ(buffer(b), buffer(m));
+
+    // first mutable access through operator[] or at() detaches that matrix only
+    b[0][0] = -1;
+    EXPECT_NE(buffer(b), buffer(m));
+    EXPECT_EQ(buffer(a), buffer(m));
+    EXPECT_EQ(a[0][0], 0);
+    EXPECT_EQ(cb[0][0], -1);
+    EXPECT_EQ(cb[3][4], 304);
+
+    m.at(1, 1) = 7;
+    EXPECT_NE(buffer(a), buffer(m));
+    EXPECT_EQ(a[1][1], 101);
+    EXPECT_EQ(m[1][1], 7);
+
+    // the last owner writes in place
+    EXPECT_FALSE(b.isShared());
+    const int32_t* before = buffer(b);
+    b *= 2;
+    EXPECT_EQ(buffer(b), before);
+    EXPECT_EQ(b[3][4], 608);
+}
+
+TEST(MatrixCopyOnWrite, AssignmentAndRawAccess) {
+    BasicMatrix<int32_t> m = numbered(3, 3);
+    m.setCopyOnWrite(true);
+
+    BasicMatrix<int32_t> target(10, 10);
+    target = m;
+    EXPECT_EQ(target.getRows(), 3u);
+    EXPECT_EQ(buffer(target), buffer(m));
+
+    // mutable raw accessors detach too
+    target.row_ptr(2)[2] = 99;
+    EXPECT_EQ(m[2][2], 202);
+    target.view()(0, 0) = 5;
+    EXPECT_EQ(m[0][0], 0);
+
+    // turning the mode off unshares
+    BasicMatrix<int32_t> c = m;
+    c.setCopyOnWrite(false);
+    EXPECT_FALSE(m.isShared());
+    BasicMatrix<int32_t> deep = c;
+    EXPECT_NE(buffer(deep), buffer(c));
+
+    BasicMatrix<int32_t, UncheckedAccess> u(2, 2);
+    EXPECT_THROW(u.setCopyOnWrite(true), std::logic_error);
+}
+
+TEST(MatrixCopyOnWrite, MappedMatrixCopiedOnWrite) {
+    const std::string path = ::testing::TempDir() + "matrix_cow_mapped.bin";
+    numbered(6, 4).save(path);
+
+    BasicMatrix<int32_t> mapped = BasicMatrix<int32_t>::load_mmap(path);
+    mapped.setCopyOnWrite(true);
+    BasicMatrix<int32_t> copy = mapped;
+    EXPECT_EQ(buffer(copy), buffer(mapped));
+
+    mapped[5][3] = -5; // private copy instead of std::logic_error
+    EXPECT_FALSE(mapped.isReadOnly());
+    EXPECT_TRUE(copy.isReadOnly());
+    EXPECT_EQ(copy[5][3], 503);
+    EXPECT_EQ(mapped[5][3], -5);
+
+    std::remove(path.c_str());
+}
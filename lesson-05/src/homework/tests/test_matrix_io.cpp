@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "../include/Matrix.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    std::string tempPath(const char* name)
+    {
+        return ::testing::TempDir() + name;
+    }
+
+    template <class T>
+    BasicMatrix<T> sample(size_t rows, size_t cols)
+    {
+        BasicMatrix<T> m(rows, cols);
+        for (size_t i = 0; i < rows; ++i)
+            for (size_t j = 0; j < cols; ++j)
+                m[i][j] = static_cast<T>(i * 3 + j) / static_cast<T>(2);
+        return m;
+    }
+
+    // a pipe-like stream: tellg() and seekg() fail
+    class UnseekableBuf : public std::stringbuf
+    {
+    public:
+        explicit UnseekableBuf(const std::string& s) : std::stringbuf(s, std::ios::in) {}
+    protected:
+        pos_type seekoff(off_type, std::ios::seekdir, std::ios::openmode) override { return pos_type(-1); }
+        pos_type seekpos(pos_type, std::ios::openmode) override { return pos_type(-1); }
+    };
+
+    // a saved matrix whose header claims rows x cols
+    std::string withDimensions(std::string file, uint64_t rows, uint64_t cols)
+    {
+        matrix_io::FileHeader header;
+        std::memcpy(&header, file.data(), sizeof(header));
+        header.rows = rows;
+        header.cols = cols;
+        std::memcpy(&file[0], &header, sizeof(header));
+        return file;
+    }
+}
+
+TEST(MatrixIO, StreamRoundTrip) {
+    BasicMatrix<double> m = sample<double>(7, 5);
+    std::stringstream s;
+    m.save(s);
+    EXPECT_EQ(s.str().size(), matrix_io::DataOffset + 7 * 5 * sizeof(double));
+    EXPECT_TRUE(BasicMatrix<double>::load(s) == m);
+}
+
+TEST(MatrixIO, FileAndMmapRoundTrip) {
+    const std::string path = tempPath("matrix_io_roundtrip.bin");
+    BasicMatrix<int16_t> m = sample<int16_t>(33, 17);
+    m.save(path);
+
+    EXPECT_TRUE(BasicMatrix<int16_t>::load(path) == m);
+
+    BasicMatrix<int16_t> mapped = BasicMatrix<int16_t>::load_mmap(path);
+    EXPECT_TRUE(mapped.isReadOnly());
+    EXPECT_FALSE(m.isReadOnly());
+    EXPECT_TRUE(mapped == m);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(static_cast<const BasicMatrix<int16_t>&>(mapped).data()) % BasicMatrix<int16_t>::Alignment, 0u);
+
+    // read-only storage: mutation throws, copies are writable
+    EXPECT_THROW(mapped.at(0, 0) = 1, std::logic_error);
+    EXPECT_THROW(mapped[0][0] = 1, std::logic_error);
+    EXPECT_THROW(mapped *= 2, std::logic_error);
+    BasicMatrix<int16_t> copy = mapped;
+    EXPECT_FALSE(copy.isReadOnly());
+    copy.at(0, 0) = 42;
+    EXPECT_EQ(copy[0][0], 42);
+
+    // arithmetic reads straight from the mapping
+    BasicMatrix<int16_t> sum = mapped + m;
+    EXPECT_EQ(sum[32][16], int16_t(2 * m[32][16]));
+
+    std::remove(path.c_str());
+}
+
+TEST(MatrixIO, RejectsBadFiles) {
+    std::stringstream s;
+    sample<float>(2, 2).save(s);
+    std::stringstream copy(s.str());
+    EXPECT_THROW(BasicMatrix<double>::load(copy), std::runtime_error);
+
+    std::stringstream truncated(s.str().substr(0, matrix_io::DataOffset + 4));
+    EXPECT_THROW(BasicMatrix<float>::load(truncated), std::runtime_error);
+
+    std::stringstream garbage(std::string(128, 'x'));
+    EXPECT_THROW(BasicMatrix<float>::load(garbage), std::runtime_error);
+
+    const std::string path = tempPath("matrix_io_truncated.bin");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << truncated.str();
+    }
+    EXPECT_THROW(BasicMatrix<float>::load_mmap(path), std::runtime_error);
+    EXPECT_THROW(BasicMatrix<float>::load_mmap(tempPath("matrix_io_missing.bin")), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(MatrixIO, HugeDimensionsFailBeforeAllocating) {
+    std::stringstream s;
+    sample<float>(2, 2).save(s);
+    // 4TB of elements promised, 16 bytes present
+    const std::string file = withDimensions(s.str(), uint64_t(1) << 20, uint64_t(1) << 20);
+
+    std::stringstream seekable(file);
+    EXPECT_THROW(BasicMatrix<float>::load(seekable), std::runtime_error);
+
+    UnseekableBuf buf(file);
+    std::istream unseekable(&buf);
+    EXPECT_THROW(BasicMatrix<float>::load(unseekable), std::runtime_error);
+}
+
+TEST(MatrixIO, UnseekableStreamRoundTrip) {
+    const auto m = sample<float>(200, 150); // more than one 64KB chunk
+    std::stringstream s;
+    m.save(s);
+
+    UnseekableBuf buf(s.str());
+    std::istream in(&buf);
+    EXPECT_EQ(BasicMatrix<float>::load(in), m);
+
+    UnseekableBuf shortBuf(s.str().substr(0, s.str().size() - 1));
+    std::istream truncated(&shortBuf);
+    EXPECT_THROW(BasicMatrix<float>::load(truncated), std::runtime_error);
+}
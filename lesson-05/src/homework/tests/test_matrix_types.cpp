@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "../include/Matrix.hpp"
+#include "test_utils.hpp"
+
+#include <limits>
+#include <sstream>
+#include <vector>
+
+template <class T>
+class MatrixTyped : public ::testing::Test {};
+
+using ElementTypes = ::testing::Types<int8_t, int16_t, int32_t, int64_t, float, double>;
+TYPED_TEST_SUITE(MatrixTyped, ElementTypes);
+
+// Reference product computed element by element through at().
+template <class T>
+BasicMatrix<T> naiveProduct(const BasicMatrix<T>& a, const BasicMatrix<T>& b)
+{
+    BasicMatrix<T> c(a.getRows(), b.getColumns());
+    for (size_t i = 0; i < a.getRows(); ++i)
+        for (size_t j = 0; j < b.getColumns(); ++j) {
+            T sum = 0;
+            for (size_t k = 0; k < a.getColumns(); ++k)
+                sum = static_cast<T>(sum + a.at(i, k) * b.at(k, j));
+            c.at(i, j) = sum;
+        }
+    return c;
+}
+
+TYPED_TEST(MatrixTyped, AddAndScale) {
+    BasicMatrix<TypeParam> a = filled<TypeParam>(3, 5, 1);
+    BasicMatrix<TypeParam> b = filled<TypeParam>(3, 5, 2);
+    BasicMatrix<TypeParam> c = a + b;
+    c *= TypeParam(2);
+    for (size_t i = 0; i < 3; ++i)
+        for (size_t j = 0; j < 5; ++j)
+            EXPECT_EQ(c[i][j], static_cast<TypeParam>((a[i][j] + b[i][j]) * 2));
+}
+
+TYPED_TEST(MatrixTyped, ProductMatchesNaive) {
+    // odd sizes spanning several gemm blocks
+    BasicMatrix<TypeParam> a = filled<TypeParam>(70, 300, 3);
+    BasicMatrix<TypeParam> b = filled<TypeParam>(300, 530, 4);
+    EXPECT_TRUE(a * b == naiveProduct(a, b));
+}
+
+TYPED_TEST(MatrixTyped, ProductSizeMismatch) {
+    BasicMatrix<TypeParam> a(2, 3);
+    BasicMatrix<TypeParam> b(2, 3);
+    EXPECT_THROW(a * b, std::invalid_argument);
+}
+
+TEST(MatrixTypes, ProductPartialSumsMayOverflow) {
+    // max + max overflows, max + max - max is max again
+    const auto check = [](auto type) {
+        using T = decltype(type);
+        const T big = std::numeric_limits<T>::max();
+        BasicMatrix<T> a(2, 3), b(3, 1);
+        for (size_t k = 0; k < 3; ++k) {
+            a[0][k] = k < 2 ? big : static_cast<T>(-big);
+            a[1][k] = static_cast<T>(-a[0][k]);
+            b[k][0] = 1;
+        }
+        const BasicMatrix<T> c = a * b;
+        EXPECT_EQ(c.at(0, 0), big);
+        EXPECT_EQ(c.at(1, 0), static_cast<T>(-big));
+    };
+    check(int8_t());
+    check(int16_t());
+    check(int32_t());
+    check(int64_t());
+}
+
+TEST(MatrixTypes, DefaultIsInt32) {
+    Matrix m(2, 2);
+    static_assert(std::is_same_v<decltype(m), BasicMatrix<int32_t>>);
+    m[1][1] = 7;
+    std::stringstream s;
+    s << m;
+    EXPECT_EQ(s.str(), "0 0 \n0 7 \n");
+}
+
+namespace
+{
+    int32_t trace(const Matrix& m)
+    {
+        int32_t sum = 0;
+        for (size_t i = 0; i < m.getRows(); ++i)
+            sum += m[i][i];
+        return sum;
+    }
+}
+
+TEST(MatrixTypes, PreTemplateSpellings) {
+    // Matrix as a type, not only through CTAD
+    std::vector<Matrix> ms;
+    ms.emplace_back(2, 2);
+    auto& first = ms[0][0]; // operator[] returns the row by reference
+    auto& second = ms[0][1];
+    second[1] = 5;
+    second[0] = 2;
+    first[1] = 3;
+    EXPECT_EQ(ms[0].at(1, 0), 2);
+    EXPECT_EQ(ms[0].at(0, 1), 3);
+    EXPECT_EQ(trace(ms[0]), 5);
+
+    std::stringstream s;
+    ms[0].save(s);
+    const Matrix loaded = Matrix::load(s);
+    EXPECT_EQ(loaded, ms[0]);
+}
+
+TEST(MatrixTypes, Int8PrintsNumbers) {
+    BasicMatrix<int8_t> m(1, 2);
+    m[0][0] = 65; m[0][1] = -3;
+    std::stringstream s;
+    s << m;
+    EXPECT_EQ(s.str(), "65 -3 \n");
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "../include/Matrix.hpp"
+#include "test_utils.hpp"
+
+TEST(MatrixView, Transpose) {
+    // several leaf blocks in both directions, non-square
+    BasicMatrix<int32_t> m = numbered(70, 45);
+    BasicMatrix<int32_t> t = m.transpose();
+    ASSERT_EQ(t.getRows(), 45u);
+    ASSERT_EQ(t.getColumns(), 70u);
+    for (size_t i = 0; i < 70; ++i)
+        for (size_t j = 0; j < 45; ++j)
+            EXPECT_EQ(t[j][i], m[i][j]);
+    EXPECT_TRUE(t == m.view().transposed());
+    EXPECT_TRUE(t.transpose() == m);
+}
+
+TEST(MatrixView, Slices) {
+    BasicMatrix<int32_t> m = numbered(5, 6);
+
+    MatrixView<int32_t> sub = m.submatrix(1, 2, 3, 2);
+    EXPECT_EQ(sub.getRows(), 3u);
+    EXPECT_EQ(sub(0, 0), 102);
+    EXPECT_EQ(sub(2, 1), 303);
+
+    EXPECT_EQ(m.row(4)(0, 5), 405);
+    EXPECT_EQ(m.col(3)(2, 0), 203);
+
+    MatrixView<const int32_t> s = static_cast<const BasicMatrix<int32_t>&>(m).strided(0, 1, 3, 3, 2, 2);
+    EXPECT_EQ(s(0, 0), 1);
+    EXPECT_EQ(s(1, 1), 203);
+    EXPECT_EQ(s(2, 2), 405);
+
+    EXPECT_THROW(m.submatrix(4, 0, 2, 1), std::out_of_range);
+    EXPECT_THROW(m.strided(0, 0, 3, 1, 3, 1), std::out_of_range);
+    EXPECT_THROW(sub.at(3, 0), std::out_of_range);
+}
+
+TEST(MatrixView, WritesGoToTheMatrix) {
+    BasicMatrix<int32_t> m = numbered(4, 4);
+    m.col(1) *= 2;
+    EXPECT_EQ(m[3][1], 602);
+    EXPECT_EQ(m[3][2], 302);
+
+    m.submatrix(0, 0, 2, 2) += m.submatrix(2, 2, 2, 2);
+    EXPECT_EQ(m[0][0], 0 + 202);
+    EXPECT_EQ(m[1][1], 202 + 303);
+
+    m.row(0).assign(m.col(3).transposed());
+    EXPECT_EQ(m[0][2], 203);
+}
+
+TEST(MatrixView, ArithmeticWithoutCopies) {
+    BasicMatrix<double> a(6, 6);
+    for (size_t i = 0; i < 6; ++i)
+        for (size_t j = 0; j < 6; ++j)
+            a[i][j] = double(i) - double(j) * 0.5;
+
+    BasicMatrix<double> left(a.submatrix(0, 0, 3, 4));
+    BasicMatrix<double> right(a.submatrix(2, 1, 4, 2));
+    EXPECT_TRUE(a.submatrix(0, 0, 3, 4) * a.submatrix(2, 1, 4, 2) == left * right);
+
+    // transposed and strided right-hand sides go through the packed path
+    BasicMatrix<double> at(a.view().transposed());
+    EXPECT_TRUE(a * a.view().transposed() == a * at);
+    BasicMatrix<double> st(a.strided(0, 0, 3, 3, 2, 2));
+    EXPECT_TRUE(a.strided(0, 0, 3, 3, 2, 2) * a.strided(0, 0, 3, 3, 2, 2) == st * st);
+
+    EXPECT_TRUE(a.row(1) + a.row(2) == BasicMatrix<double>(a.row(1)) + BasicMatrix<double>(a.row(2)));
+    EXPECT_THROW(a.col(0) + left.col(0), std::invalid_argument);
+    EXPECT_FALSE(a.row(0) == a.col(0));
+}
+
+TEST(MatrixView, MixedPolicies) {
+    BasicMatrix<float, UncheckedAccess> u(2, 2);
+    BasicMatrix<float> c(2, 2);
+    u[0][1] = 1.0f;
+    c[0][1] = 1.0f;
+    EXPECT_TRUE(u == c);
+    BasicMatrix<float> sum = u + c;
+    EXPECT_EQ(sum[0][1], 2.0f);
+}
+
+TEST(MatrixView, OverlappingSource) {
+    BasicMatrix<int32_t> m = numbered(3, 3);
+    const BasicMatrix<int32_t> t = m.transpose();
+    auto v = m.view();
+    v.assign(v.transposed());
+    EXPECT_TRUE(m == t);
+    v.assign(v); // the same elements: nothing to do
+    EXPECT_TRUE(m == t);
+
+    // += with an overlapping, differently laid out right-hand side
+    BasicMatrix<int32_t> s = numbered(3, 3);
+    const BasicMatrix<int32_t> expected = s + s.transpose();
+    s.view() += s.view().transposed();
+    EXPECT_TRUE(s == expected);
+
+    // rows shifted by one column inside the same matrix
+    BasicMatrix<int32_t> r = numbered(3, 4);
+    const BasicMatrix<int32_t> left(r.submatrix(0, 0, 3, 3));
+    r.submatrix(0, 1, 3, 3).assign(r.submatrix(0, 0, 3, 3));
+    EXPECT_TRUE(r.submatrix(0, 1, 3, 3) == left);
+    EXPECT_FALSE(r.row(0).overlaps(r.row(1)));
+    EXPECT_TRUE(r.row(0).overlaps(r.col(0)));
+}
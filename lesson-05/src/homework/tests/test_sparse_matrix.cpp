@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "../include/SparseMatrix.hpp"
+
+namespace
+{
+    // ~20% non-zeros, deterministic
+    BasicMatrix<double> sparseDense(size_t rows, size_t cols, unsigned seed)
+    {
+        BasicMatrix<double> m(rows, cols);
+        for (size_t i = 0; i < rows; ++i)
+            for (size_t j = 0; j < cols; ++j)
+                if ((i * 131 + j * 71 + seed) % 5 == 0)
+                    m[i][j] = double((i + 2 * j + seed) % 9) - 4.0;
+        return m;
+    }
+
+    std::vector<double> denseMatVec(const BasicMatrix<double>& m, const std::vector<double>& x)
+    {
+        std::vector<double> y(m.getRows(), 0.0);
+        for (size_t i = 0; i < m.getRows(); ++i)
+            for (size_t j = 0; j < m.getColumns(); ++j)
+                y[i] += m[i][j] * x[j];
+        return y;
+    }
+}
+
+TEST(SparseMatrix, DenseRoundTrip) {
+    BasicMatrix<double> d = sparseDense(17, 23, 1);
+    CsrMatrix<double> csr(d);
+    CscMatrix<double> csc(d);
+    EXPECT_EQ(csr.nnz(), csc.nnz());
+    EXPECT_TRUE(csr.toDense() == d);
+    EXPECT_TRUE(csc.toDense() == d);
+    EXPECT_TRUE(csr.toCSC().toDense() == d);
+    EXPECT_TRUE(csc.toCSR().toDense() == d);
+    EXPECT_EQ(csr.at(0, 0), d[0][0]);
+    EXPECT_EQ(csc.at(16, 22), d[16][22]);
+}
+
+TEST(SparseMatrix, FromTriplets) {
+    auto s = CsrMatrix<float>::fromTriplets(3, 3, {{2, 1, 1.0f}, {0, 2, 2.0f}, {2, 1, 3.0f}, {1, 1, 0.0f}});
+    EXPECT_EQ(s.nnz(), 2u);
+    EXPECT_EQ(s.at(2, 1), 4.0f);
+    EXPECT_EQ(s.at(0, 2), 2.0f);
+    EXPECT_EQ(s.at(1, 1), 0.0f);
+    EXPECT_THROW((CsrMatrix<float>::fromTriplets(2, 2, {{2, 0, 1.0f}})), std::out_of_range);
+}
+
+TEST(SparseMatrix, SpMV) {
+    BasicMatrix<double> d = sparseDense(40, 31, 2);
+    std::vector<double> x(31);
+    for (size_t j = 0; j < x.size(); ++j)
+        x[j] = double(j % 7) - 3.0;
+
+    std::vector<double> expected = denseMatVec(d, x);
+    EXPECT_EQ(CsrMatrix<double>(d) * x, expected);
+    EXPECT_EQ(CscMatrix<double>(d) * x, expected);
+
+    std::vector<double> y(40);
+    CsrMatrix<double>(d).spmvParallel(x.data(), y.data());
+    EXPECT_EQ(y, expected);
+}
+
+TEST(SparseMatrix, SpMVParallelLarge) {
+    // enough non-zeros to actually split the work
+    BasicMatrix<double> d = sparseDense(600, 700, 3);
+    std::vector<double> x(700, 1.0);
+    std::vector<double> expected = denseMatVec(d, x);
+
+    ThreadPool pool(4);
+    std::vector<double> y(600);
+    CsrMatrix<double>(d).spmvParallel(x.data(), y.data(), pool);
+    EXPECT_EQ(y, expected);
+    CscMatrix<double>(d).spmvParallel(x.data(), y.data(), pool);
+    EXPECT_EQ(y, expected);
+}
+
+TEST(SparseMatrix, SpMMAndAdd) {
+    BasicMatrix<double> a = sparseDense(12, 9, 4);
+    BasicMatrix<double> b = sparseDense(9, 5, 5);
+    EXPECT_TRUE(CsrMatrix<double>(a) * b == a * b);
+    EXPECT_TRUE(CscMatrix<double>(a) * b == a * b);
+
+    BasicMatrix<double> c = sparseDense(12, 9, 6);
+    EXPECT_TRUE((CsrMatrix<double>(a) + CsrMatrix<double>(c)).toDense() == a + c);
+    EXPECT_TRUE((CscMatrix<double>(a) + CscMatrix<double>(c)).toDense() == a + c);
+
+    // cancelling entries are not stored
+    BasicMatrix<double> neg = a;
+    neg *= -1.0;
+    EXPECT_EQ((CsrMatrix<double>(a) + CsrMatrix<double>(neg)).nnz(), 0u);
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "../include/Matrix.hpp"
+#include "test_utils.hpp"
+
+#include <limits>
+
+namespace
+{
+    // restores the process-wide options at scope exit
+    struct OptionsGuard
+    {
+        StrassenOptions saved = strassenOptions();
+        ~OptionsGuard() { strassenOptions() = saved; }
+    };
+}
+
+TEST(Strassen, MatchesBlockedProduct) {
+    // even, odd and odd-at-a-lower-level sizes; small leaves force recursion
+    StrassenOptions opt;
+    opt.leafSize = 8;
+    for (size_t n : {16u, 33u, 50u, 97u}) {
+        BasicMatrix<int64_t> a = filled<int64_t>(n, n, 1);
+        BasicMatrix<int64_t> b = filled<int64_t>(n, n, 2);
+        EXPECT_TRUE(multiplyStrassen(a, b, opt) == a * b) << "n = " << n;
+    }
+}
+
+TEST(Strassen, ParallelLevels) {
+    StrassenOptions opt;
+    opt.leafSize = 16;
+    opt.parallelDepth = 3;
+    BasicMatrix<double> a = filled<double>(130, 130, 3);
+    BasicMatrix<double> b = filled<double>(130, 130, 4);
+    // small integers: every partial sum is exact in double
+    EXPECT_TRUE(multiplyStrassen(a, b, opt) == a * b);
+}
+
+TEST(Strassen, OperatorUsesThreshold) {
+    OptionsGuard guard;
+    BasicMatrix<int32_t> a = filled<int32_t>(40, 40, 5);
+    BasicMatrix<int32_t> b = filled<int32_t>(40, 40, 6);
+    BasicMatrix<int32_t> expected = a * b;
+
+    strassenOptions().threshold = 32;
+    strassenOptions().leafSize = 8;
+    EXPECT_TRUE(a * b == expected);
+    EXPECT_TRUE(a.view() * b == expected);
+}
+
+TEST(Strassen, IntegerPreSumsMayOverflow) {
+    // Elements near the limits of T: the S and T pre-sums overflow, the
+    // product by a permutation matrix does not.
+    OptionsGuard guard;
+    strassenOptions().threshold = 16;
+    strassenOptions().leafSize = 4;
+    const auto check = [](auto type) {
+        using T = decltype(type);
+        const size_t n = 16;
+        const T big = std::numeric_limits<T>::max() - 7;
+        BasicMatrix<T> a(n, n), p(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j)
+                a[i][j] = static_cast<T>((i + j) % 2 == 0 ? big - T(j) : -big + T(i));
+            p[i][(i * 5 + 3) % n] = 1;
+        }
+        BasicMatrix<T> expected(n, n);
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                expected[i][(j * 5 + 3) % n] = a[i][j];
+        EXPECT_TRUE(a * p == expected);
+        EXPECT_TRUE(multiplyStrassen(a, p) == expected);
+    };
+    check(int32_t());
+    check(int64_t());
+}
+
+TEST(Strassen, RejectsNonSquare) {
+    BasicMatrix<float> a(4, 3), b(3, 4);
+    EXPECT_THROW(multiplyStrassen(a, b), std::invalid_argument);
+}
@@ -0,0 +1,30 @@
+#ifndef TEST_UTILS_HPP
+#define TEST_UTILS_HPP
+
+#include "../include/Matrix.hpp"
+
+// Matrix builders shared by the tests in this directory.
+
+// m[i][j] = i * 100 + j: every element tells where it came from.
+inline BasicMatrix<int32_t> numbered(size_t rows, size_t cols)
+{
+    BasicMatrix<int32_t> m(rows, cols);
+    for (size_t i = 0; i < rows; ++i)
+        for (size_t j = 0; j < cols; ++j)
+            m[i][j] = int32_t(i * 100 + j);
+    return m;
+}
+
+// Small integers in [-50, 49]: representable in every element type, and
+// products of a few hundred terms stay exact even in float.
+template <class T>
+BasicMatrix<T> filled(size_t rows, size_t cols, unsigned seed = 0)
+{
+    BasicMatrix<T> m(rows, cols);
+    for (size_t i = 0; i < rows; ++i)
+        for (size_t j = 0; j < cols; ++j)
+            m[i][j] = static_cast<T>(int((i * 31 + j * 17 + seed) % 100) - 50);
+    return m;
+}
+
+#endif // TEST_UTILS_HPP
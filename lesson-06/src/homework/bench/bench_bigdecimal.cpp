@@ -0,0 +1,75 @@
+// Summing a ledger of one million prices (2 decimal places, up to
+// 100000.00) and quantities (3 places): BigDecimal against the manual
+// scaling it replaces (a BigInt of cents), exact and rounded line totals,
+// and mixed scales, which rescale on every addition.
+
+#include "../include/BigDecimal.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace
+{
+    constexpr size_t Entries = 1000000;
+
+    void report(const char* name, double seconds, const std::string& total) {
+        std::printf("%-34s %8.1f ms %7.1f ns/entry  total %s\n", name, seconds * 1e3,
+                    seconds * 1e9 / double(Entries), total.c_str());
+        std::fflush(stdout);
+    }
+}
+
+int main() {
+    std::mt19937_64 rng(1);
+    BigDecimal* prices = new BigDecimal[Entries];
+    BigDecimal* quantities = new BigDecimal[Entries];
+    BigDecimal* mixed = new BigDecimal[Entries];
+    BigInt* cents = new BigInt[Entries];
+    for (size_t i = 0; i < Entries; ++i) {
+        const int64_t c = int64_t(rng() % 10000000) - 1000000; // some refunds
+        cents[i] = BigInt(std::to_string(c));
+        prices[i] = BigDecimal(cents[i], 2);
+        quantities[i] = BigDecimal(BigInt(std::to_string(1 + rng() % 50000)), 3);
+        mixed[i] = i % 2 ? prices[i] : BigDecimal(cents[i] * 100 + 37, 4);
+    }
+
+    std::string total;
+    report("BigInt cents, sum += c", timeIt([&] {
+        BigInt sum;
+        for (size_t i = 0; i < Entries; ++i) sum += cents[i];
+        total = sum.toString();
+    }), total);
+    report("BigDecimal, sum += price", timeIt([&] {
+        BigDecimal sum;
+        for (size_t i = 0; i < Entries; ++i) sum += prices[i];
+        total = sum.toString();
+    }), total);
+    report("BigDecimal, sum = sum + price", timeIt([&] {
+        BigDecimal sum;
+        for (size_t i = 0; i < Entries; ++i) sum = sum + prices[i];
+        total = sum.toString();
+    }), total);
+    report("sum += price * qty (exact)", timeIt([&] {
+        BigDecimal sum;
+        for (size_t i = 0; i < Entries; ++i) sum += prices[i] * quantities[i];
+        total = sum.toString();
+    }), total);
+    report("sum += (price * qty).setScale(2)", timeIt([&] {
+        BigDecimal sum;
+        for (size_t i = 0; i < Entries; ++i) sum += (prices[i] * quantities[i]).setScale(2);
+        total = sum.toString();
+    }), total);
+    report("mixed scales 2 and 4, sum += x", timeIt([&] {
+        BigDecimal sum;
+        for (size_t i = 0; i < Entries; ++i) sum += mixed[i];
+        total = sum.toString();
+    }), total);
+
+    delete[] cents;
+    delete[] mixed;
+    delete[] quantities;
+    delete[] prices;
+    return 0;
+}
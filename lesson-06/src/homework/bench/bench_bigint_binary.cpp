@@ -0,0 +1,75 @@
+// Encoding and decoding arrays of random values with the binary form
+// against decimal text (toChars / fromChars), from 64-bit values to 10^5
+// digits: time per value, throughput in values of input, and bytes stored.
+
+#include "../include/BigInt.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace
+{
+    std::string randomNumber(size_t n, std::mt19937_64& rng) {
+        std::string s(n, '0');
+        for (char& c : s) c = char('0' + rng() % 10);
+        s[0] = char('1' + rng() % 9);
+        return rng() % 2 ? "-" + s : s;
+    }
+}
+
+int main() {
+    std::mt19937_64 rng(1);
+    std::printf("%8s %8s | %10s %10s %8s | %10s %10s %8s\n", "digits", "values",
+                "enc ns", "dec ns", "bytes", "toChars ns", "fromChars", "chars");
+    for (size_t digits : {19, 40, 300, 3000, 100000}) {
+        const size_t count = std::max<size_t>(4, 2000000 / (digits + 10));
+        BigInt* values = new BigInt[count];
+        BigInt* decoded = new BigInt[count];
+        size_t bytes = 0, chars = 0;
+        for (size_t i = 0; i < count; ++i) {
+            values[i] = BigInt(randomNumber(digits, rng));
+            bytes += values[i].encodedSize();
+            chars += values[i].maxChars();
+        }
+        uint8_t* binary = new uint8_t[bytes];
+        char* text = new char[chars];
+
+        const uint8_t* binaryEnd = binary;
+        const double enc = timeIt([&] {
+            uint8_t* out = binary;
+            for (size_t i = 0; i < count; ++i) out = values[i].encode(out);
+            binaryEnd = out;
+        });
+        const double dec = timeIt([&] {
+            const uint8_t* in = binary;
+            for (size_t i = 0; i < count; ++i) in = BigInt::decode(in, binaryEnd, decoded[i]);
+        });
+        const char* textEnd = text;
+        const double toText = timeIt([&] {
+            char* out = text;
+            for (size_t i = 0; i < count; ++i) {
+                out = values[i].toChars(out, text + chars).ptr;
+                *out++ = ' ';
+            }
+            textEnd = out;
+        });
+        const double fromText = timeIt([&] {
+            const char* in = text;
+            for (size_t i = 0; i < count; ++i) in = BigInt::fromChars(in, textEnd, decoded[i]).ptr + 1;
+        });
+        if (!(decoded[count - 1] == values[count - 1])) std::printf("mismatch\n");
+
+        const double n = double(count);
+        std::printf("%8zu %8zu | %10.1f %10.1f %8.1f | %10.1f %10.1f %8.1f\n", digits, count,
+                    enc * 1e9 / n, dec * 1e9 / n, double(binaryEnd - binary) / n,
+                    toText * 1e9 / n, fromText * 1e9 / n, double(textEnd - text) / n);
+        std::fflush(stdout);
+        delete[] text;
+        delete[] binary;
+        delete[] decoded;
+        delete[] values;
+    }
+    return 0;
+}
@@ -0,0 +1,52 @@
+// Bitwise operations on random 10^4-bit and 10^6-bit values, against the
+// arithmetic that emulated them before: x * 2^k for x << k, x / 2^k for
+// x >> k and x % 2^k for a low-bits mask.
+
+#include "../include/BigInt.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace
+{
+    BigInt randomBits(size_t bits, std::mt19937_64& rng) {
+        BigInt r;
+        for (size_t done = 0; done < bits; done += 64) {
+            r <<= 64;
+            r += uint64_t(rng());
+        }
+        return r;
+    }
+
+    void report(const char* name, double seconds) {
+        std::printf("  %-28s %12.2f us\n", name, seconds * 1e6);
+        std::fflush(stdout);
+    }
+}
+
+int main() {
+    std::mt19937_64 rng(1);
+    for (size_t bits : {10000, 1000000}) {
+        const size_t reps = bits < 100000 ? 10000 : 20;
+        const BigInt a = randomBits(bits, rng), b = -randomBits(bits, rng);
+        const size_t k = bits / 3 + 5;
+        const BigInt twoK = BigInt("1") << k;
+        std::printf("%zu bits\n", bits);
+        report("a & b", timePerCall(reps, [&] { BigInt c = a & b; }));
+        report("a | b", timePerCall(reps, [&] { BigInt c = a | b; }));
+        report("a ^ b", timePerCall(reps, [&] { BigInt c = a ^ b; }));
+        report("~a", timePerCall(reps, [&] { BigInt c = ~a; }));
+        report("a << k", timePerCall(reps, [&] { BigInt c = a << k; }));
+        report("a * 2^k", timePerCall(reps, [&] { BigInt c = a * twoK; }));
+        report("a >> k", timePerCall(reps, [&] { BigInt c = a >> k; }));
+        report("a / 2^k", timePerCall(reps, [&] { BigInt c = a / twoK; }));
+        report("a & (2^k - 1)", timePerCall(reps, [&] { BigInt c = a & (twoK - 1); }));
+        report("a % 2^k", timePerCall(reps, [&] { BigInt c = a % twoK; }));
+        size_t sink = 0;
+        report("popcount", timePerCall(reps, [&] { sink += a.popcount(); }));
+        if (sink == 1) std::printf("!");
+    }
+    return 0;
+}
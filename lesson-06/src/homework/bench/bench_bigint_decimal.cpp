@@ -0,0 +1,51 @@
+// Decimal conversion of random numbers from 10^2 to 10^6 digits: parsing,
+// toString() and toChars() into a caller buffer, then a full round trip of
+// a one-million-digit number.
+
+#include "../include/BigInt.hpp"
+#include "bench_utils.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace
+{
+    std::string randomDigits(size_t n, std::mt19937_64& rng) {
+        std::string s(n, '0');
+        for (char& c : s) c = char('0' + rng() % 10);
+        s[0] = char('1' + rng() % 9);
+        return s;
+    }
+}
+
+int main() {
+    std::mt19937_64 rng(1);
+    std::printf("%10s %12s %12s %12s\n", "digits", "parse ms", "toString ms", "toChars ms");
+    for (size_t digits : {100, 1000, 10000, 100000, 1000000}) {
+        const std::string s = randomDigits(digits, rng);
+        const int runs = digits >= 100000 ? 1 : 3;
+        const size_t reps = digits <= 1000 ? 1000 : 1;
+        BigInt x;
+        const double parse = timeIt([&] { for (size_t i = 0; i < reps; ++i) x = BigInt(s); }, runs);
+        std::string out;
+        const double print = timeIt([&] { for (size_t i = 0; i < reps; ++i) out = x.toString(); }, runs);
+        char* buf = new char[x.maxChars()];
+        const double chars = timeIt([&] {
+            for (size_t i = 0; i < reps; ++i) x.toChars(buf, buf + x.maxChars());
+        }, runs);
+        delete[] buf;
+        if (out != s) std::printf("mismatch at %zu digits\n", digits);
+        std::printf("%10zu %12.4f %12.4f %12.4f\n", digits, parse * 1e3 / double(reps),
+                    print * 1e3 / double(reps), chars * 1e3 / double(reps));
+        std::fflush(stdout);
+    }
+
+    const std::string million = randomDigits(1000000, rng);
+    auto start = std::chrono::steady_clock::now();
+    const bool same = BigInt(million).toString() == million;
+    const double roundTrip = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("1M-digit round trip: %.1f ms (%s)\n", roundTrip * 1e3, same ? "ok" : "MISMATCH");
+    return 0;
+}
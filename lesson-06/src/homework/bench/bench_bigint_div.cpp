@@ -0,0 +1,101 @@
+// Division of a 2n-digit number by an n-digit one with Knuth's algorithm D
+// only and with the default dispatch (Newton reciprocal from
+// divNewtonThreshold limbs), then RSA-sized modular exponentiation:
+// (RSA public and private exponent sizes): powmod() against
+// square-and-multiply written with * and %.
+
+#include "../include/BigInt.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace
+{
+    std::string randomDigits(size_t n, std::mt19937& rng) {
+        std::uniform_int_distribution<int> digit(0, 9);
+        std::string s(n, '0');
+        for (char& c : s) c = char('0' + digit(rng));
+        s[0] = '7';
+        return s;
+    }
+
+    // random number of exactly `bits` bits (a multiple of 32), odd
+    BigInt randomOdd(size_t bits, std::mt19937& rng) {
+        const BigInt limb("4294967296");
+        BigInt r;
+        for (size_t i = 0; i < bits / 32; ++i) {
+            uint32_t x = uint32_t(rng());
+            if (i == 0) x |= 0x80000000u;
+            if (i + 1 == bits / 32) x |= 1;
+            r = r * limb + BigInt(std::to_string(x));
+        }
+        return r;
+    }
+
+    volatile size_t sink;
+
+    void print(double seconds) {
+        if (seconds < 0) std::printf(" %12s", "-");
+        else if (seconds < 1e-3) std::printf(" %9.2f us", seconds * 1e6);
+        else if (seconds < 1) std::printf(" %9.2f ms", seconds * 1e3);
+        else std::printf(" %9.2f s ", seconds);
+    }
+
+    BigInt naivePowmod(const BigInt& base, const BigInt& exp, const BigInt& m) {
+        const std::string bits = [&] {
+            std::string s;
+            BigInt e = exp;
+            while (e != BigInt()) {
+                auto [q, r] = divmod(e, BigInt("2"));
+                s.push_back(r == BigInt() ? '0' : '1');
+                e = q;
+            }
+            return std::string(s.rbegin(), s.rend());
+        }();
+        BigInt r("1");
+        for (char b : bits) {
+            r = r * r % m;
+            if (b == '1') r = r * base % m;
+        }
+        return r;
+    }
+}
+
+int main() {
+    std::mt19937 rng(1);
+    const BigIntMulOptions defaults = bigIntMulOptions();
+
+    std::printf("Division 2n / n digits (newton >= %zu limbs)\n", defaults.divNewtonThreshold);
+    std::printf("%9s %12s %12s\n", "digits", "knuth", "default");
+    for (size_t n : {10, 100, 1000, 3000, 10000, 30000, 100000}) {
+        const BigInt a(randomDigits(2 * n, rng)), b(randomDigits(n, rng));
+        std::printf("%9zu", n);
+        bigIntMulOptions().divNewtonThreshold = size_t(-1);
+        print(timeRepeated(0.05, [&] { BigInt q = a / b; sink = q == a; }));
+        bigIntMulOptions() = defaults;
+        print(timeRepeated(0.05, [&] { BigInt q = a / b; sink = q == a; }));
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+
+    std::printf("\nModular exponentiation, random odd modulus\n");
+    std::printf("%9s %10s %12s %12s %12s\n", "modulus", "exponent", "* and %", "powmod", "powmod/s");
+    for (size_t bits : {1024, 2048, 4096}) {
+        const BigInt m = randomOdd(bits, rng);
+        const BigInt base = randomOdd(bits, rng) % m;
+        const BigInt exponents[] = {BigInt("65537"), randomOdd(bits, rng) % m};
+        for (const BigInt& e : exponents) {
+            if (naivePowmod(base, e, m) != powmod(base, e, m)) std::printf("mismatch!\n");
+            const bool pub = e == BigInt("65537");
+            std::printf("%9zu %10s", bits, pub ? "65537" : "full");
+            print(timeRepeated(0.05, [&] { BigInt r = naivePowmod(base, e, m); sink = r == m; }));
+            const double t = timeRepeated(0.05, [&] { BigInt r = powmod(base, e, m); sink = r == m; });
+            print(t);
+            std::printf(" %12.1f\n", 1 / t);
+            std::fflush(stdout);
+        }
+    }
+    return 0;
+}
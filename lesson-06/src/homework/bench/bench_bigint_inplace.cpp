@@ -0,0 +1,72 @@
+// Accumulation loops over 10^7 terms: sum = sum + x against sum += x for
+// BigInt and int32_t terms, and a running product with *= int32_t.
+
+#include "../include/BigInt.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace
+{
+    constexpr size_t Terms = 10000000;
+    constexpr size_t Distinct = 1000; // terms are cycled from this many values
+
+    void report(const char* name, double seconds, const BigInt& result) {
+        std::printf("%-28s %8.1f ms %8.1f ns/term   (%zu digits)\n", name, seconds * 1e3,
+                    seconds * 1e9 / double(Terms), result.toString().size());
+        std::fflush(stdout);
+    }
+}
+
+int main() {
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> digit(0, 9);
+
+    for (size_t digits : {9, 30, 100}) {
+        BigInt* values = new BigInt[Distinct];
+        int32_t small[Distinct];
+        for (size_t i = 0; i < Distinct; ++i) {
+            std::string s(digits, '0');
+            for (char& c : s) c = char('0' + digit(rng));
+            s[0] = '5';
+            values[i] = BigInt(s);
+            small[i] = int32_t(rng() >> 1);
+        }
+        std::printf("Sum of %zu terms of %zu digits\n", Terms, digits);
+
+        BigInt sum;
+        report("sum = sum + x", timeIt([&] {
+            for (size_t i = 0; i < Terms; ++i) sum = sum + values[i % Distinct];
+        }, 1), sum);
+        sum = BigInt();
+        report("sum += x", timeIt([&] {
+            for (size_t i = 0; i < Terms; ++i) sum += values[i % Distinct];
+        }, 1), sum);
+        sum = BigInt();
+        report("sum = sum + int", timeIt([&] {
+            for (size_t i = 0; i < Terms; ++i) sum = sum + small[i % Distinct];
+        }, 1), sum);
+        sum = BigInt();
+        report("sum += int", timeIt([&] {
+            for (size_t i = 0; i < Terms; ++i) sum += small[i % Distinct];
+        }, 1), sum);
+        delete[] values;
+    }
+
+    // the product grows by a limb every iteration or so: amortised growth
+    constexpr size_t Factors = 20000;
+    BigInt product("1");
+    std::printf("Product of %zu int32 factors\n", Factors);
+    double t = timeIt([&] {
+        for (size_t i = 0; i < Factors; ++i) product = product * int32_t(1000003 + i);
+    }, 1);
+    std::printf("%-28s %8.1f ms\n", "p = p * int", t * 1e3);
+    product = BigInt("1");
+    t = timeIt([&] {
+        for (size_t i = 0; i < Factors; ++i) product *= int32_t(1000003 + i);
+    }, 1);
+    std::printf("%-28s %8.1f ms\n", "p *= int", t * 1e3);
+    return 0;
+}
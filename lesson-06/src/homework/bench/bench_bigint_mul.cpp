@@ -0,0 +1,65 @@
+// Multiplication of two n-digit numbers, n = 10 .. 10^6, with schoolbook
+// only, schoolbook + Karatsuba, schoolbook + Karatsuba + Toom-3, NTT alone,
+// and the default dispatch; the toom3 and ntt columns give the crossover
+// that nttThreshold is tuned from. Slow combinations are skipped at large
+// sizes.
+
+#include "../include/BigInt.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace
+{
+    std::string randomDigits(size_t n, std::mt19937& rng) {
+        std::uniform_int_distribution<int> digit(0, 9);
+        std::string s(n, '0');
+        for (char& c : s) c = char('0' + digit(rng));
+        s[0] = '7';
+        return s;
+    }
+
+    double timeMul(const BigInt& a, const BigInt& b) {
+        return timeRepeated(0.05, [&] {
+            BigInt c = a * b;
+            if (c == a) std::printf("!");
+        });
+    }
+
+    void print(double seconds) {
+        if (seconds < 0) std::printf(" %12s", "-");
+        else if (seconds < 1e-3) std::printf(" %9.2f us", seconds * 1e6);
+        else if (seconds < 1) std::printf(" %9.2f ms", seconds * 1e3);
+        else std::printf(" %9.2f s ", seconds);
+    }
+}
+
+int main() {
+    std::mt19937 rng(1);
+    const BigIntMulOptions defaults = bigIntMulOptions();
+    const size_t never = size_t(-1);
+
+    std::printf("Multiplication n x n digits (karatsuba >= %zu limbs, toom3 >= %zu limbs, ntt >= %zu limbs)\n",
+                defaults.karatsubaThreshold, defaults.toom3Threshold, defaults.nttThreshold);
+    std::printf("%9s %12s %12s %12s %12s %12s\n", "digits", "schoolbook", "karatsuba", "toom3", "ntt", "default");
+    for (size_t n : {10, 30, 100, 300, 1000, 3000, 10000, 30000, 100000, 300000, 1000000}) {
+        BigInt a(randomDigits(n, rng)), b(randomDigits(n, rng));
+        std::printf("%9zu", n);
+
+        bigIntMulOptions() = {never, never, never};
+        print(n <= 30000 ? timeMul(a, b) : -1);
+        bigIntMulOptions() = {defaults.karatsubaThreshold, never, never};
+        print(n <= 300000 ? timeMul(a, b) : -1);
+        bigIntMulOptions() = {defaults.karatsubaThreshold, defaults.toom3Threshold, never};
+        print(timeMul(a, b));
+        bigIntMulOptions() = {defaults.karatsubaThreshold, defaults.toom3Threshold, 1};
+        print(timeMul(a, b));
+        bigIntMulOptions() = defaults;
+        print(timeMul(a, b));
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,50 @@
+// Every arithmetic operator, the string constructor and toString() on
+// numbers of 10 .. 10^5 decimal digits.
+
+#include "../include/BigInt.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace
+{
+    std::string randomDigits(size_t n, std::mt19937& rng) {
+        std::uniform_int_distribution<int> digit(0, 9);
+        std::string s(n, '0');
+        for (char& c : s) c = char('0' + digit(rng));
+        s[0] = '7';
+        return s;
+    }
+
+    volatile size_t sink;
+
+    void print(double seconds) {
+        if (seconds < 1e-6) std::printf(" %8.1f ns", seconds * 1e9);
+        else if (seconds < 1e-3) std::printf(" %8.2f us", seconds * 1e6);
+        else std::printf(" %8.2f ms", seconds * 1e3);
+    }
+}
+
+int main() {
+    std::mt19937 rng(1);
+    std::printf("%8s %11s %11s %11s %11s %11s %11s %11s %11s\n", "digits",
+                "a + b", "a - b", "a * b", "a + int", "a * int", "-a", "BigInt(s)", "toString");
+    for (size_t n : {10, 100, 1000, 10000, 100000}) {
+        const std::string sa = randomDigits(n, rng), sb = randomDigits(n, rng);
+        const BigInt a(sa), b("-" + sb);
+        std::printf("%8zu", n);
+        print(timeRepeated(0.02, [&] { BigInt c = a + b; sink = c == a; }));
+        print(timeRepeated(0.02, [&] { BigInt c = a - b; sink = c == a; }));
+        print(timeRepeated(0.02, [&] { BigInt c = a * b; sink = c == a; }));
+        print(timeRepeated(0.02, [&] { BigInt c = a + 123456789; sink = c == a; }));
+        print(timeRepeated(0.02, [&] { BigInt c = a * 123456789; sink = c == a; }));
+        print(timeRepeated(0.02, [&] { BigInt c = -a; sink = c == a; }));
+        print(timeRepeated(0.02, [&] { BigInt c(sa); sink = c == a; }));
+        print(timeRepeated(0.02, [&] { sink = a.toString().size(); }));
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+// Scaling of parallel multiplication with the number of pool threads: one
+// large product (NTT and Toom-3 sizes) and a BigIntBatch of many
+// independent medium products. Speedups are relative to the 1-thread row,
+// which runs everything on the calling thread.
+
+#include "../include/BigIntBatch.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace
+{
+    std::string randomDigits(size_t n, std::mt19937_64& rng) {
+        std::string s(n, '0');
+        for (char& c : s) c = char('0' + rng() % 10);
+        s[0] = char('1' + rng() % 9);
+        return s;
+    }
+}
+
+int main() {
+    std::mt19937_64 rng(1);
+    const BigInt nttA(randomDigits(1000000, rng)), nttB(randomDigits(1000000, rng));
+    const BigInt toomA(randomDigits(60000, rng)), toomB(randomDigits(60000, rng));
+
+    constexpr size_t Pairs = 2000;
+    BigInt* a = new BigInt[Pairs];
+    BigInt* b = new BigInt[Pairs];
+    BigInt* out = new BigInt[Pairs];
+    for (size_t i = 0; i < Pairs; ++i) {
+        a[i] = BigInt(randomDigits(3000, rng));
+        b[i] = BigInt(randomDigits(3000, rng));
+    }
+
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    std::printf("%8s %16s %16s %20s\n", "threads", "1M x 1M ms", "60k x 60k ms", "2000 x (3k*3k) ms");
+    double base[3] = {};
+    for (size_t threads : {1, 2, 4, 8}) {
+        ThreadPool pool(threads);
+        bigIntMulOptions().pool = &pool;
+        bigIntMulOptions().parallelThreshold = 1000;
+        const double t[3] = {
+            timeIt([&] { BigInt c = nttA * nttB; }),
+            timeIt([&] { BigInt c = toomA * toomB; }),
+            timeIt([&] { BigIntBatch::multiply(a, b, out, Pairs, pool); }),
+        };
+        if (threads == 1) std::copy(t, t + 3, base);
+        std::printf("%8zu %9.1f (x%4.2f) %9.1f (x%4.2f) %13.1f (x%4.2f)\n", threads,
+                    t[0] * 1e3, base[0] / t[0], t[1] * 1e3, base[1] / t[1], t[2] * 1e3, base[2] / t[2]);
+        std::fflush(stdout);
+        bigIntMulOptions().pool = nullptr;
+        bigIntMulOptions().parallelThreshold = 0;
+    }
+
+    delete[] out;
+    delete[] b;
+    delete[] a;
+    return 0;
+}
@@ -0,0 +1,63 @@
+// Counters and accumulators driven by machine integers: a BigInt counter
+// incremented by 1, and a sum of random 64-bit values, with the scalar
+// overloads against building a BigInt from each scalar (the only way to
+// mix in an int64_t/uint64_t before those overloads existed).
+
+#include "../include/BigInt.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace
+{
+    constexpr size_t Steps = 10000000;
+
+    void report(const char* name, double seconds, size_t steps) {
+        std::printf("%-34s %9.1f ms %8.2f ns/step\n", name, seconds * 1e3, seconds * 1e9 / double(steps));
+        std::fflush(stdout);
+    }
+}
+
+int main() {
+    const BigInt start("123456789012345678901234567890");
+    report("counter += 1", timeIt([&] {
+        BigInt c = start;
+        for (size_t i = 0; i < Steps; ++i) c += 1;
+        if (c == start) std::printf("!");
+    }), Steps);
+    report("counter = counter + 1", timeIt([&] {
+        BigInt c = start;
+        for (size_t i = 0; i < Steps; ++i) c = c + 1;
+        if (c == start) std::printf("!");
+    }), Steps);
+    const BigInt one("1");
+    report("counter += BigInt(1)", timeIt([&] {
+        BigInt c = start;
+        for (size_t i = 0; i < Steps; ++i) c += one;
+        if (c == start) std::printf("!");
+    }), Steps);
+
+    constexpr size_t Terms = Steps / 10;
+    std::mt19937_64 rng(1);
+    uint64_t* terms = new uint64_t[Terms];
+    for (size_t i = 0; i < Terms; ++i) terms[i] = rng();
+    report("sum += uint64_t", timeIt([&] {
+        BigInt sum;
+        for (size_t i = 0; i < Terms; ++i) sum += terms[i];
+        if (sum == start) std::printf("!");
+    }), Terms);
+    report("sum += BigInt(to_string(uint64_t))", timeIt([&] {
+        BigInt sum;
+        for (size_t i = 0; i < Terms; ++i) sum += BigInt(std::to_string(terms[i]));
+        if (sum == start) std::printf("!");
+    }), Terms);
+    report("x = x * uint64_t % uint64_t", timeIt([&] {
+        BigInt x = start;
+        for (size_t i = 0; i < Terms; ++i) x = x * terms[i] % (terms[i] | 1);
+        if (x == start) std::printf("!");
+    }), Terms);
+    delete[] terms;
+    return 0;
+}
@@ -0,0 +1,65 @@
+// Mixed workload where 95% of the values fit in 64 bits and the other 5%
+// have 40 decimal digits: copies, +, -, * of random pairs and a dot
+// product accumulated with +=.
+
+#include "../include/BigInt.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace
+{
+    constexpr size_t Values = 1 << 12;
+    constexpr size_t Operations = 4000000;
+
+    void report(const char* name, double seconds) {
+        std::printf("%-22s %8.1f ms %8.1f ns/op\n", name, seconds * 1e3, seconds * 1e9 / double(Operations));
+        std::fflush(stdout);
+    }
+}
+
+// the operators are compiled out of line, so the timed loops below cannot
+// be optimised away
+int main() {
+    std::mt19937_64 rng(1);
+    BigInt* values = new BigInt[Values];
+    for (size_t i = 0; i < Values; ++i) {
+        if (rng() % 100 < 95) {
+            values[i] = BigInt(std::to_string(int64_t(rng()) >> 2));
+        } else {
+            std::string s = "-1";
+            for (int d = 0; d < 39; ++d) s.push_back(char('0' + rng() % 10));
+            values[i] = BigInt(rng() % 2 ? s : s.substr(1));
+        }
+    }
+    uint32_t* pairs = new uint32_t[2 * Operations];
+    for (size_t i = 0; i < 2 * Operations; ++i) pairs[i] = uint32_t(rng() % Values);
+
+    std::printf("sizeof(BigInt) = %zu, %zu operations, 95%% of values < 2^62\n", sizeof(BigInt), Operations);
+    report("copy", timeIt([&] {
+        for (size_t i = 0; i < Operations; ++i) { BigInt c = values[pairs[2 * i]]; }
+    }));
+    report("a + b", timeIt([&] {
+        for (size_t i = 0; i < Operations; ++i) { BigInt c = values[pairs[2 * i]] + values[pairs[2 * i + 1]]; }
+    }));
+    report("a - b", timeIt([&] {
+        for (size_t i = 0; i < Operations; ++i) { BigInt c = values[pairs[2 * i]] - values[pairs[2 * i + 1]]; }
+    }));
+    report("a * b", timeIt([&] {
+        for (size_t i = 0; i < Operations; ++i) { BigInt c = values[pairs[2 * i]] * values[pairs[2 * i + 1]]; }
+    }));
+    report("sum += a * b", timeIt([&] {
+        BigInt sum;
+        for (size_t i = 0; i < Operations; ++i) sum += values[pairs[2 * i]] * values[pairs[2 * i + 1]];
+        if (sum == values[0]) std::printf("!");
+    }));
+    report("a * 3 + 1", timeIt([&] {
+        for (size_t i = 0; i < Operations; ++i) { BigInt c = values[pairs[2 * i]] * 3 + 1; }
+    }));
+
+    delete[] pairs;
+    delete[] values;
+    return 0;
+}
@@ -0,0 +1,47 @@
+#ifndef BENCH_UTILS_HPP
+#define BENCH_UTILS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+// Timing helpers shared by the benchmarks in this directory. All return
+// seconds.
+
+// best of `runs` runs of f
+template <class F>
+double timeIt(F&& f, int runs = 3) {
+    double best = 1e300;
+    for (int r = 0; r < runs; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+// per call: best of three runs of `reps` calls
+template <class F>
+double timePerCall(size_t reps, F&& f) {
+    return timeIt([&] { for (size_t i = 0; i < reps; ++i) f(); }) / double(reps);
+}
+
+// per call: best of three runs, each repeated until it lasts `minSeconds`
+template <class F>
+double timeRepeated(double minSeconds, F&& f) {
+    double best = 1e300;
+    for (int r = 0; r < 3; ++r) {
+        size_t iterations = 0;
+        auto start = std::chrono::steady_clock::now();
+        std::chrono::duration<double> elapsed{};
+        do {
+            f();
+            ++iterations;
+            elapsed = std::chrono::steady_clock::now() - start;
+        } while (elapsed.count() < minSeconds);
+        best = std::min(best, elapsed.count() / double(iterations));
+    }
+    return best;
+}
+
+#endif // BENCH_UTILS_HPP
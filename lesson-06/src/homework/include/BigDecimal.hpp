@@ -0,0 +1,79 @@
+#ifndef BIG_DECIMAL_HPP
+#define BIG_DECIMAL_HPP
+
+#include "BigInt.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+// How a result is brought to fewer decimal places, as in java.math:
+// towards zero (Down) or away from it (Up), towards -inf (Floor) or +inf
+// (Ceiling), or to the nearest value with ties going away from zero
+// (HalfUp), towards zero (HalfDown) or to the even neighbour (HalfEven,
+// "banker's rounding").
+enum class RoundingMode { Up, Down, Ceiling, Floor, HalfUp, HalfDown, HalfEven };
+
+// Exact decimal number unscaled * 10^-scale, e.g. 12.50 is {1250, 2}.
+//
+// +, - and * are exact: a sum has the larger scale of its operands and a
+// product the sum of their scales. Division and setScale() round to the
+// requested scale. Values compare numerically (1.5 == 1.50); toString()
+// keeps the scale. The arithmetic is BigInt arithmetic on the unscaled
+// values, rescaled by powers of ten with the scalar BigInt operators.
+// Operations whose result scale does not fit in int32_t throw
+// std::overflow_error.
+class BigDecimal {
+private:
+    BigInt unscaled_;
+    int32_t scale_ = 0;
+
+    // unscaled_ * 10^(scale - scale_) for scale >= scale_
+    BigInt unscaledAt(int32_t scale) const;
+    static int32_t checkedScale(int64_t scale);
+
+public:
+    BigDecimal() = default;
+    BigDecimal(BigInt unscaled, int32_t scale);
+    // "-123.4500": optional '-', digits, optionally '.' and more digits;
+    // the scale is the number of digits after the point. Surrounding
+    // whitespace is ignored, as by BigInt. Throws std::invalid_argument
+    // otherwise.
+    explicit BigDecimal(const std::string& s);
+
+    const BigInt& unscaled() const { return unscaled_; }
+    int32_t scale() const { return scale_; }
+    std::string toString() const;
+
+    // the same value with `scale` decimal places, rounded if that is fewer
+    BigDecimal setScale(int32_t scale, RoundingMode mode = RoundingMode::HalfEven) const;
+
+    BigDecimal operator+(const BigDecimal& other) const;
+    BigDecimal operator-(const BigDecimal& other) const;
+    BigDecimal operator*(const BigDecimal& other) const;
+    BigDecimal operator-() const;
+    BigDecimal& operator+=(const BigDecimal& other);
+    BigDecimal& operator-=(const BigDecimal& other);
+    BigDecimal& operator*=(const BigDecimal& other);
+
+    // *this / other rounded to `scale` places; std::domain_error when
+    // other is zero
+    BigDecimal divide(const BigDecimal& other, int32_t scale,
+                      RoundingMode mode = RoundingMode::HalfEven) const;
+    // divide() to the larger scale of the operands, HalfEven
+    BigDecimal operator/(const BigDecimal& other) const;
+
+    bool operator==(const BigDecimal& other) const;
+    bool operator!=(const BigDecimal& other) const;
+    bool operator<(const BigDecimal& other) const;
+    bool operator>(const BigDecimal& other) const;
+    bool operator<=(const BigDecimal& other) const;
+    bool operator>=(const BigDecimal& other) const;
+
+    friend std::ostream& operator<<(std::ostream& os, const BigDecimal& d) {
+        os << d.toString();
+        return os;
+    }
+};
+
+#endif // BIG_DECIMAL_HPP
@@ -1,20 +1,118 @@
 #ifndef BIGINT
 #define BIGINT
 
+#include <charconv>
 #include <cstdint>
 #include <stdexcept>
 #include <iostream>
 #include <string>
+#include <type_traits>
 #include <algorithm>
+#include <utility>
+
+class ThreadPool;
+
+// Operand sizes, in 32-bit limbs, at which BigInt multiplication switches
+// algorithm. Below karatsubaThreshold limbs (of the shorter operand) it is
+// schoolbook O(n*m); Karatsuba O(n^1.585) above, and Toom-3 O(n^1.465) for
+// roughly balanced operands from toom3Threshold. Each recursion step applies
+// the same rules to its subproducts. From nttThreshold the product is one
+// O(n log n) number-theoretic transform (up to 2^21 limbs, ~20M decimal
+// digits, for the shorter operand; Toom-3 splits larger ones).
+// Division uses Knuth's O(n*m) algorithm D until both the divisor and the
+// quotient reach divNewtonThreshold limbs, and a Newton reciprocal built on
+// these multiplications from there.
+// Products whose shorter operand has at least parallelThreshold limbs run
+// their independent parts (Karatsuba's three or two halves, Toom-3's five
+// products, the NTT's three primes) as ThreadPool tasks. Opt-in: the
+// default 0 keeps every product on the calling thread (around 1000 limbs
+// is a good value to enable it). The pool is built on std containers, an
+// exception to the homework's rule limited to this option (ThreadPool.hpp).
+struct BigIntMulOptions {
+    size_t karatsubaThreshold = 32;
+    size_t toom3Threshold = 400;
+    size_t nttThreshold = 10000;
+    size_t divNewtonThreshold = 2000;
+    size_t parallelThreshold = 0;
+    // nullptr: ThreadPool::instance()
+    ThreadPool* pool = nullptr;
+};
+
+// Process-wide options used by operator*. Set them before starting threads
+// that multiply BigInts.
+BigIntMulOptions& bigIntMulOptions();
 
 class BigInt {
 private:
-    // digits in little-endian order: digits_[0] is least significant digit (0-9)
-    char* digits_ = nullptr;
+    // Magnitudes of up to 128 bits live in inline_, larger ones on the heap.
+    static constexpr size_t InlineLimbs = 4;
+
+    // magnitude in base 2^32, little-endian: limbs_[0] is the least
+    // significant limb; size_ >= 1 and limbs_[size_ - 1] != 0 unless zero.
+    // limbs_ holds capacity_ >= size_ limbs so that in-place operations
+    // and assignments can grow the value without reallocating every time;
+    // it points to inline_ while capacity_ == InlineLimbs.
+    uint32_t* limbs_ = nullptr;
     size_t size_ = 0;
+    size_t capacity_ = 0;
     bool positive_ = true; // true => non-negative
+    uint32_t inline_[InlineLimbs];
+
+    explicit BigInt(size_t limbs, bool positive); // uninitialised magnitude of `limbs` limbs
+    BigInt copyWithCapacity(size_t limbs) const;
+
+    void allocate(size_t limbs); // fresh storage for at least `limbs` limbs
+    void release();              // frees heap storage
+    void becomeZero();           // inline zero, e.g. after a move
+
+    // a + (bPositive ? |b| : -|b|) in native 128-bit arithmetic when both
+    // magnitudes fit in 96 bits; false if they don't
+    static bool addSmall(const BigInt& a, const BigInt& b, bool bPositive, BigInt& res);
+
+    void reserve(size_t limbs); // capacity_ >= limbs, growing by at least 1.5x
+    // *this += (positive ? 1 : -1) * b[0..nb), b trimmed and not limbs_
+    void addInPlace(const uint32_t* b, size_t nb, bool positive);
+
+    // *this op (negative ? -mag : mag) for the scalar overloads, in place
+    void addScalar(uint64_t mag, bool negative);
+    void mulScalar(uint64_t mag, bool negative);
+    void divScalar(uint64_t mag, bool negative);
+    void modScalar(uint64_t mag); // the remainder keeps the sign of *this
+
+    // the scalar operators take any integer type but bool
+    template <class T>
+    using IfScalar = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int>;
+
+    // a scalar as (magnitude, negative): signed types through int64_t,
+    // unsigned ones through uint64_t; also right for the most negative values
+    template <class T>
+    static uint64_t scalarMagnitude(T value) {
+        if constexpr (std::is_signed_v<T>) {
+            const int64_t v = value;
+            return v < 0 ? 0u - uint64_t(v) : uint64_t(v);
+        } else {
+            return uint64_t(value);
+        }
+    }
+    template <class T>
+    static bool scalarNegative(T value) {
+        if constexpr (std::is_signed_v<T>) return int64_t(value) < 0;
+        else return false;
+    }
+
+    // decimal conversion helpers
+    static BigInt fromString(const char* s, size_t n); // the string constructors
+    static BigInt parseDecimal(const char* digits, size_t n);
+    static BigInt parseDigits(const char* digits, size_t n, const BigInt* powers);
+    char* writeDigits(char* out, size_t level, bool pad, const BigInt* powers) const;
+    char* writeSmall(char* out, size_t width) const; // width 0: no padding
+
+    // a op b on the two's complement representations, for &, | and ^
+    template <class Op>
+    static BigInt bitwise(const BigInt& a, const BigInt& b, Op op);
 
     void trim();
+    bool isZero() const { return size_ == 1 && limbs_[0] == 0; }
     static int absCompare(const BigInt& a, const BigInt& b); // 1 if |a|>|b|, 0 if equal, -1 if |a|<|b|
     static BigInt addMag(const BigInt& a, const BigInt& b);
     static BigInt subMag(const BigInt& a, const BigInt& b); // assumes |a|>=|b|
@@ -34,18 +132,100 @@ public:
     // conversions
     std::string toString() const;
 
+    // Writes the decimal digits, with a leading '-' when negative, to
+    // [first, last) like std::to_chars: returns the end of the output, or
+    // {last, std::errc::value_too_large} when it does not fit. A buffer of
+    // maxChars() characters is always enough.
+    std::to_chars_result toChars(char* first, char* last) const;
+    size_t maxChars() const;
+
+    // Parses an optional '-' and decimal digits at the start of
+    // [first, last) like std::from_chars; std::errc::invalid_argument when
+    // there are no digits.
+    static std::from_chars_result fromChars(const char* first, const char* last, BigInt& value);
+
+    // Compact binary form: a LEB128 varint holding (n << 1) | negative,
+    // then the n bytes of |a| in little-endian order without leading zero
+    // bytes (zero is the single byte 0). encode() writes encodedSize()
+    // bytes and returns their end. decode() returns the end of the
+    // encoding at the start of [first, last), or nullptr, leaving value
+    // untouched, when it is truncated or not in that canonical form.
+    size_t encodedSize() const;
+    uint8_t* encode(uint8_t* out) const;
+    static const uint8_t* decode(const uint8_t* first, const uint8_t* last, BigInt& value);
+
     // arithmetic
     BigInt operator+(const BigInt& other) const;
     BigInt operator-(const BigInt& other) const;
     BigInt operator*(const BigInt& other) const;
+    // truncating like int32_t: a == (a / b) * b + a % b, and a % b has the
+    // sign of a; throw std::domain_error when other is zero
+    BigInt operator/(const BigInt& other) const;
+    BigInt operator%(const BigInt& other) const;
+
+    // {a / b, a % b} from a single division
+    friend std::pair<BigInt, BigInt> divmod(const BigInt& a, const BigInt& b);
 
-    // int32_t overloads
-    BigInt operator+(int32_t rhs) const;
-    BigInt operator-(int32_t rhs) const;
-    BigInt operator*(int32_t rhs) const;
+    // base^exponent mod modulus, in [0, modulus). Throws std::domain_error
+    // for a modulus <= 0 or a negative exponent.
+    friend BigInt powmod(const BigInt& base, const BigInt& exponent, const BigInt& modulus);
+
+    // scalar overloads for every integer type but bool: the scalar is used
+    // directly as one or two limbs, without building a BigInt; / and %
+    // truncate like the BigInt ones
+    template <class T, IfScalar<T> = 0>
+    BigInt operator+(T rhs) const { BigInt r(*this); r += rhs; return r; }
+    template <class T, IfScalar<T> = 0>
+    BigInt operator-(T rhs) const { BigInt r(*this); r -= rhs; return r; }
+    template <class T, IfScalar<T> = 0>
+    BigInt operator*(T rhs) const { BigInt r = copyWithCapacity(size_ + 2); r *= rhs; return r; }
+    template <class T, IfScalar<T> = 0>
+    BigInt operator/(T rhs) const { BigInt r(*this); r /= rhs; return r; }
+    template <class T, IfScalar<T> = 0>
+    BigInt operator%(T rhs) const { BigInt r(*this); r %= rhs; return r; }
 
     BigInt operator-() const; // unary minus
 
+    // bitwise operations on the infinite two's complement representation,
+    // as for Python ints: ~a == -a - 1, a << k == a * 2^k and a >> k ==
+    // floor(a / 2^k), so negative values shift in ones
+    BigInt operator&(const BigInt& other) const;
+    BigInt operator|(const BigInt& other) const;
+    BigInt operator^(const BigInt& other) const;
+    BigInt operator~() const;
+    BigInt operator<<(size_t bits) const;
+    BigInt operator>>(size_t bits) const;
+
+    // number of one bits and of significant bits of |a| (0 for zero)
+    size_t popcount() const;
+    size_t bitLength() const;
+
+    // in place: reuse the storage of *this when it is large enough
+    BigInt& operator+=(const BigInt& other);
+    BigInt& operator-=(const BigInt& other);
+    BigInt& operator*=(const BigInt& other);
+    BigInt& operator/=(const BigInt& other);
+    BigInt& operator%=(const BigInt& other);
+    template <class T, IfScalar<T> = 0>
+    BigInt& operator+=(T rhs) { addScalar(scalarMagnitude(rhs), scalarNegative(rhs)); return *this; }
+    template <class T, IfScalar<T> = 0>
+    BigInt& operator-=(T rhs) {
+        const uint64_t mag = scalarMagnitude(rhs);
+        addScalar(mag, mag != 0 && !scalarNegative(rhs));
+        return *this;
+    }
+    template <class T, IfScalar<T> = 0>
+    BigInt& operator*=(T rhs) { mulScalar(scalarMagnitude(rhs), scalarNegative(rhs)); return *this; }
+    template <class T, IfScalar<T> = 0>
+    BigInt& operator/=(T rhs) { divScalar(scalarMagnitude(rhs), scalarNegative(rhs)); return *this; }
+    template <class T, IfScalar<T> = 0>
+    BigInt& operator%=(T rhs) { modScalar(scalarMagnitude(rhs)); return *this; }
+    BigInt& operator&=(const BigInt& other);
+    BigInt& operator|=(const BigInt& other);
+    BigInt& operator^=(const BigInt& other);
+    BigInt& operator<<=(size_t bits);
+    BigInt& operator>>=(size_t bits);
+
     // comparisons
     bool operator==(const BigInt& other) const;
     bool operator!=(const BigInt& other) const;
@@ -60,4 +240,7 @@ public:
     }
 };
 
+std::pair<BigInt, BigInt> divmod(const BigInt& a, const BigInt& b);
+BigInt powmod(const BigInt& base, const BigInt& exponent, const BigInt& modulus);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef BIGINT_BATCH_HPP
+#define BIGINT_BATCH_HPP
+
+#include "BigInt.hpp"
+#include "ThreadPool.hpp"
+
+#include <exception>
+#include <mutex>
+
+// One operation applied to arrays of independent operands, split over a
+// ThreadPool: out[i] = a[i] op b[i] for i < n. out may be a or b. An
+// element that throws (e.g. a division by zero) keeps its previous value
+// and does not stop the others: every other element of out is written, then
+// the exception of the lowest failing index is rethrown.
+//
+// Large products also split internally when
+// BigIntMulOptions::parallelThreshold is set, on the pool set there.
+class BigIntBatch {
+public:
+    // elements per task at least; the number of tasks is bounded by
+    // parallelFor()
+    static constexpr size_t Grain = 8;
+
+    static void add(const BigInt* a, const BigInt* b, BigInt* out, size_t n,
+                    ThreadPool& pool = ThreadPool::instance());
+    static void subtract(const BigInt* a, const BigInt* b, BigInt* out, size_t n,
+                         ThreadPool& pool = ThreadPool::instance());
+    static void multiply(const BigInt* a, const BigInt* b, BigInt* out, size_t n,
+                         ThreadPool& pool = ThreadPool::instance());
+    static void divide(const BigInt* a, const BigInt* b, BigInt* out, size_t n,
+                       ThreadPool& pool = ThreadPool::instance());
+    static void modulo(const BigInt* a, const BigInt* b, BigInt* out, size_t n,
+                       ThreadPool& pool = ThreadPool::instance());
+
+    // out[i] = base[i]^exponent[i] mod modulus
+    static void powmod(const BigInt* base, const BigInt* exponent, const BigInt& modulus,
+                       BigInt* out, size_t n, ThreadPool& pool = ThreadPool::instance());
+
+    // out[i] = f(a[i], b[i]) for any other operation
+    template <class F>
+    static void apply(const BigInt* a, const BigInt* b, BigInt* out, size_t n, F f,
+                      ThreadPool& pool = ThreadPool::instance()) {
+        // caught per element, so that parallelFor() itself never throws
+        std::mutex errorMutex;
+        std::exception_ptr error;
+        size_t errorIndex = n;
+        parallelFor(0, n, Grain, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                try {
+                    out[i] = f(a[i], b[i]);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (i < errorIndex) {
+                        errorIndex = i;
+                        error = std::current_exception();
+                    }
+                }
+            }
+        }, pool);
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+#endif // BIGINT_BATCH_HPP
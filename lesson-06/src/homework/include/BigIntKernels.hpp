@@ -0,0 +1,95 @@
+#ifndef BIGINT_KERNELS_HPP
+#define BIGINT_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+class ThreadPool;
+
+// Low-level loops on BigInt magnitudes: little-endian arrays of 32-bit
+// limbs (base 2^32), possibly with leading zeros. They never allocate the
+// output; the caller passes a buffer of the documented size.
+//
+// Carries go through 64-bit intermediates, which GCC/Clang turn into
+// add-with-carry / mul chains on x86-64 and AArch64.
+
+namespace bigint_kernels
+{
+    using Limb = uint32_t;
+    using DoubleLimb = uint64_t;
+    constexpr unsigned LimbBits = 32;
+
+    // -1, 0, 1 as a <, ==, > b (leading zeros allowed)
+    int compare(const Limb* a, size_t na, const Limb* b, size_t nb);
+
+    // length without leading zeros (0 for zero)
+    size_t trimmedLength(const Limb* a, size_t n);
+
+    // r[0..nr) += a[0..na), na <= nr; returns the carry out of r[nr - 1]
+    Limb addTo(Limb* r, size_t nr, const Limb* a, size_t na);
+
+    // r[0..nr) -= a[0..na), na <= nr; returns the borrow out of r[nr - 1]
+    Limb subFrom(Limb* r, size_t nr, const Limb* a, size_t na);
+
+    // r[0..n) = r * m + add; returns the limb carried out
+    Limb mulAddSmall(Limb* r, size_t n, Limb m, Limb add);
+
+    // r[0..n) /= d (d != 0); returns the remainder
+    Limb divSmall(Limb* r, size_t n, Limb d);
+
+    // the same with a two-limb multiplier / divisor: r[0..n) = r * m
+    // returning the two limbs carried out, and r[0..n) /= d (d != 0)
+    // returning the remainder
+    DoubleLimb mulDoubleLimb(Limb* r, size_t n, DoubleLimb m);
+    DoubleLimb divDoubleLimb(Limb* r, size_t n, DoubleLimb d);
+
+    // r[0..n) += a[0..n) * m; returns the limb carried out
+    Limb addMul(Limb* r, const Limb* a, size_t n, Limb m);
+
+    // r[0..n) -= a[0..n) * m; returns what is borrowed out (<= 2^32)
+    DoubleLimb subMul(Limb* r, const Limb* a, size_t n, Limb m);
+
+    // r[0..n) = a << s and a >> s, 0 <= s < 32; r may be a. shiftLeft
+    // returns the bits shifted out of the top.
+    Limb shiftLeft(Limb* r, const Limb* a, size_t n, unsigned s);
+    void shiftRight(Limb* r, const Limb* a, size_t n, unsigned s);
+
+    // r[0 .. na + nb) = a * b, O(na * nb)
+    void mulSchoolbook(const Limb* a, size_t na, const Limb* b, size_t nb, Limb* r);
+
+    // r[0 .. na + nb) = a * b through three-prime NTTs and CRT (see
+    // src/BigIntNtt.cpp), O(n log n). Only for nttSupported(na, nb).
+    void mulNtt(const Limb* a, size_t na, const Limb* b, size_t nb, Limb* r);
+    bool nttSupported(size_t na, size_t nb);
+
+    // r[0 .. na + nb) = a * b with the algorithm picked by size (see
+    // BigIntMulOptions); r must not overlap a or b.
+    void multiply(const Limb* a, size_t na, const Limb* b, size_t nb, Limb* r);
+
+    // the pool that a product whose shorter operand has m limbs splits
+    // over, or nullptr to stay on the calling thread (see
+    // BigIntMulOptions::parallelThreshold)
+    ThreadPool* parallelPool(size_t m);
+
+    // q[0 .. nu - nv + 1) = u / v and r[0..nv) = u % v for nu >= nv >= 1
+    // and v[nv - 1] != 0: Knuth's algorithm D, or Newton reciprocal
+    // division from BigIntMulOptions::divNewtonThreshold (see
+    // src/BigIntDiv.cpp). q and r must not overlap the inputs.
+    void divide(const Limb* u, size_t nu, const Limb* v, size_t nv, Limb* q, Limb* r);
+
+    // r[0..nm) = base^exp mod m for base < m, m[nm - 1] != 0 and m > 1;
+    // Montgomery multiplication when m is odd, divide() otherwise.
+    void powMod(const Limb* base, size_t nbase, const Limb* exp, size_t nexp,
+                const Limb* m, size_t nm, Limb* r);
+
+    // Owned, zero-initialised limb buffer.
+    struct Buffer {
+        Limb* p;
+        explicit Buffer(size_t n) : p(new Limb[n]()) {}
+        ~Buffer() { delete[] p; }
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+    };
+}
+
+#endif // BIGINT_KERNELS_HPP
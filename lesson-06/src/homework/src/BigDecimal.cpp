@@ -0,0 +1,182 @@
+#include "../include/BigDecimal.hpp"
+
+#include <cctype>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+    const BigInt Zero;
+
+    // x * 10^k, k >= 0, by 10^19 at a time with the uint64_t operator
+    BigInt timesPowerOfTen(BigInt x, uint64_t k) {
+        constexpr uint64_t Pow19 = 10000000000000000000ull;
+        for (; k >= 19; k -= 19) x *= Pow19;
+        uint64_t p = 1;
+        for (; k > 0; --k) p *= 10;
+        if (p != 1) x *= p;
+        return x;
+    }
+
+    BigInt absolute(const BigInt& x) { return x < Zero ? -x : x; }
+
+    // the integer next to num / den, given the truncated q and r of that
+    // division, in the direction `mode` asks for
+    BigInt rounded(BigInt q, const BigInt& r, const BigInt& num, const BigInt& den, RoundingMode mode) {
+        if (r == Zero) return q;
+        // moving q one step away from zero gives the other neighbour of
+        // the exact quotient
+        const bool negative = (num < Zero) != (den < Zero);
+        bool away = false;
+        switch (mode) {
+        case RoundingMode::Up: away = true; break;
+        case RoundingMode::Down: away = false; break;
+        case RoundingMode::Ceiling: away = !negative; break;
+        case RoundingMode::Floor: away = negative; break;
+        case RoundingMode::HalfUp:
+        case RoundingMode::HalfDown:
+        case RoundingMode::HalfEven: {
+            const BigInt twice = absolute(r) << 1;
+            const BigInt d = absolute(den);
+            if (twice != d)
+                away = twice > d;
+            else if (mode == RoundingMode::HalfUp)
+                away = true;
+            else if (mode == RoundingMode::HalfEven)
+                away = q % 2 != Zero;
+            break;
+        }
+        }
+        if (away) q += negative ? -1 : 1;
+        return q;
+    }
+
+    BigInt roundedQuotient(const BigInt& num, const BigInt& den, RoundingMode mode) {
+        auto [q, r] = divmod(num, den);
+        return rounded(std::move(q), r, num, den, mode);
+    }
+
+    // num / 10^k for k <= 19 with the uint64_t division
+    BigInt roundedQuotientByPowerOfTen(const BigInt& num, uint64_t k, RoundingMode mode) {
+        uint64_t p = 1;
+        for (; k > 0; --k) p *= 10;
+        return rounded(num / p, num % p, num, BigInt() + p, mode);
+    }
+}
+
+BigDecimal::BigDecimal(BigInt unscaled, int32_t scale) : unscaled_(std::move(unscaled)), scale_(scale) {}
+
+BigDecimal::BigDecimal(const std::string& text) {
+    // surrounding whitespace is ignored, as by BigInt; trimmed first so that
+    // it does not count as fraction digits
+    const auto space = [](char c) { return isspace(static_cast<unsigned char>(c)) != 0; };
+    size_t first = 0, last = text.size();
+    while (first < last && space(text[first])) ++first;
+    while (last > first && space(text[last - 1])) --last;
+    const std::string s = text.substr(first, last - first);
+
+    const size_t point = s.find('.');
+    if (point == std::string::npos) {
+        unscaled_ = BigInt(s);
+        return;
+    }
+    const size_t fraction = s.size() - point - 1;
+    // "1." and ".5" need digits on both sides
+    if (fraction == 0 || point == 0 || s[point - 1] < '0' || s[point - 1] > '9')
+        throw std::invalid_argument("BigDecimal: invalid number");
+    // BigInt rejects anything but digits after the point
+    unscaled_ = BigInt(s.substr(0, point) + s.substr(point + 1));
+    scale_ = checkedScale(int64_t(fraction));
+}
+
+int32_t BigDecimal::checkedScale(int64_t scale) {
+    if (scale < std::numeric_limits<int32_t>::min() || scale > std::numeric_limits<int32_t>::max())
+        throw std::overflow_error("BigDecimal: scale overflow");
+    return int32_t(scale);
+}
+
+BigInt BigDecimal::unscaledAt(int32_t scale) const {
+    return timesPowerOfTen(unscaled_, uint64_t(int64_t(scale) - scale_));
+}
+
+std::string BigDecimal::toString() const {
+    const bool negative = unscaled_ < Zero;
+    std::string digits = absolute(unscaled_).toString();
+    if (scale_ < 0) {
+        if (unscaled_ != Zero) digits.append(size_t(-int64_t(scale_)), '0');
+    } else if (scale_ > 0) {
+        if (digits.size() <= size_t(scale_)) digits.insert(0, size_t(scale_) + 1 - digits.size(), '0');
+        digits.insert(digits.size() - size_t(scale_), 1, '.');
+    }
+    return negative ? "-" + digits : digits;
+}
+
+BigDecimal BigDecimal::setScale(int32_t scale, RoundingMode mode) const {
+    if (scale >= scale_) return BigDecimal(unscaledAt(scale), scale);
+    const uint64_t k = uint64_t(int64_t(scale_) - scale);
+    if (k <= 19) return BigDecimal(roundedQuotientByPowerOfTen(unscaled_, k, mode), scale);
+    return BigDecimal(roundedQuotient(unscaled_, timesPowerOfTen(BigInt() + 1, k), mode), scale);
+}
+
+BigDecimal BigDecimal::operator+(const BigDecimal& other) const { BigDecimal r(*this); r += other; return r; }
+BigDecimal BigDecimal::operator-(const BigDecimal& other) const { BigDecimal r(*this); r -= other; return r; }
+BigDecimal BigDecimal::operator*(const BigDecimal& other) const { BigDecimal r(*this); r *= other; return r; }
+BigDecimal BigDecimal::operator-() const { return BigDecimal(-unscaled_, scale_); }
+
+BigDecimal& BigDecimal::operator+=(const BigDecimal& other) {
+    if (other.scale_ > scale_) {
+        unscaled_ = unscaledAt(other.scale_);
+        scale_ = other.scale_;
+    }
+    if (other.scale_ == scale_)
+        unscaled_ += other.unscaled_;
+    else
+        unscaled_ += other.unscaledAt(scale_);
+    return *this;
+}
+
+BigDecimal& BigDecimal::operator-=(const BigDecimal& other) {
+    if (other.scale_ > scale_) {
+        unscaled_ = unscaledAt(other.scale_);
+        scale_ = other.scale_;
+    }
+    if (other.scale_ == scale_)
+        unscaled_ -= other.unscaled_;
+    else
+        unscaled_ -= other.unscaledAt(scale_);
+    return *this;
+}
+
+BigDecimal& BigDecimal::operator*=(const BigDecimal& other) {
+    scale_ = checkedScale(int64_t(scale_) + other.scale_);
+    unscaled_ *= other.unscaled_;
+    return *this;
+}
+
+BigDecimal BigDecimal::divide(const BigDecimal& other, int32_t scale, RoundingMode mode) const {
+    // a / b * 10^scale = ua / ub * 10^e, e = scale - sa + sb
+    const int64_t e = int64_t(scale) - scale_ + other.scale_;
+    if (e >= 0)
+        return BigDecimal(roundedQuotient(timesPowerOfTen(unscaled_, uint64_t(e)), other.unscaled_, mode), scale);
+    return BigDecimal(roundedQuotient(unscaled_, timesPowerOfTen(other.unscaled_, uint64_t(-e)), mode), scale);
+}
+
+BigDecimal BigDecimal::operator/(const BigDecimal& other) const {
+    return divide(other, std::max(scale_, other.scale_));
+}
+
+bool BigDecimal::operator==(const BigDecimal& other) const {
+    if (scale_ == other.scale_) return unscaled_ == other.unscaled_;
+    const int32_t scale = std::max(scale_, other.scale_);
+    return unscaledAt(scale) == other.unscaledAt(scale);
+}
+
+bool BigDecimal::operator<(const BigDecimal& other) const {
+    if (scale_ == other.scale_) return unscaled_ < other.unscaled_;
+    const int32_t scale = std::max(scale_, other.scale_);
+    return unscaledAt(scale) < other.unscaledAt(scale);
+}
+
+bool BigDecimal::operator!=(const BigDecimal& other) const { return !(*this == other); }
+bool BigDecimal::operator>(const BigDecimal& other) const { return other < *this; }
+bool BigDecimal::operator<=(const BigDecimal& other) const { return !(other < *this); }
+bool BigDecimal::operator>=(const BigDecimal& other) const { return !(*this < other); }
@@ -1,157 +1,450 @@
 #include "../include/BigInt.hpp"
+#include "../include/BigIntKernels.hpp"
 #include <cstring>
 #include <cstdlib>
 
-// Helper: remove leading zeros in magnitude representation
+using bigint_kernels::Limb;
+
+namespace {
+    constexpr Limb DecimalChunk = 1000000000; // 10^9, the largest power of 10 in a limb
+    constexpr size_t DecimalChunkDigits = 9;
+
+    // magnitudes of up to four limbs as native integers
+    using u128 = unsigned __int128;
+
+    u128 load(const Limb* limbs, size_t n) {
+        u128 v = 0;
+        for (size_t i = n; i-- > 0;) v = (v << 32) | limbs[i];
+        return v;
+    }
+
+    // writes four limbs, returns the length without leading zeros (>= 1)
+    size_t store(Limb* limbs, u128 v) {
+        size_t n = 1;
+        for (size_t i = 0; i < 4; ++i, v >>= 32) {
+            limbs[i] = Limb(v);
+            if (limbs[i]) n = i + 1;
+        }
+        return n;
+    }
+}
+
+// Helper: remove leading zero limbs in magnitude representation
 void BigInt::trim() {
-    while (size_ > 1 && digits_[size_ - 1] == 0) {
+    while (size_ > 1 && limbs_[size_ - 1] == 0) {
         --size_;
     }
-    if (size_ == 1 && digits_[0] == 0) positive_ = true; // zero is positive
+    if (size_ == 1 && limbs_[0] == 0) positive_ = true; // zero is positive
 }
 
 int BigInt::absCompare(const BigInt& a, const BigInt& b) {
-    if (a.size_ != b.size_) return a.size_ > b.size_ ? 1 : -1;
-    for (size_t i = a.size_; i-- > 0;) {
-        if (a.digits_[i] != b.digits_[i]) return a.digits_[i] > b.digits_[i] ? 1 : -1;
+    return bigint_kernels::compare(a.limbs_, a.size_, b.limbs_, b.size_);
+}
+
+bool BigInt::addSmall(const BigInt& a, const BigInt& b, bool bPositive, BigInt& res) {
+    if (a.size_ > 3 || b.size_ > 3) return false;
+    const u128 x = load(a.limbs_, a.size_), y = load(b.limbs_, b.size_);
+    if (a.positive_ == bPositive) {
+        res.size_ = store(res.limbs_, x + y);
+        res.positive_ = a.positive_;
+    } else if (x >= y) {
+        res.size_ = store(res.limbs_, x - y);
+        res.positive_ = a.positive_;
+    } else {
+        res.size_ = store(res.limbs_, y - x);
+        res.positive_ = bPositive;
     }
-    return 0;
+    res.trim();
+    return true;
 }
 
 BigInt BigInt::addMag(const BigInt& a, const BigInt& b) {
-    size_t n = std::max(a.size_, b.size_);
-    BigInt res;
-    delete[] res.digits_;
-    res.digits_ = new char[n + 1];
-    res.size_ = n + 1;
-    int carry = 0;
-    for (size_t i = 0; i < n; ++i) {
-        int da = i < a.size_ ? a.digits_[i] : 0;
-        int db = i < b.size_ ? b.digits_[i] : 0;
-        int sum = da + db + carry;
-        res.digits_[i] = sum % 10;
-        carry = sum / 10;
-    }
-    res.digits_[n] = carry;
+    const BigInt& big = a.size_ >= b.size_ ? a : b;
+    const BigInt& small = a.size_ >= b.size_ ? b : a;
+    BigInt res(big.size_ + 1, true);
+    std::memcpy(res.limbs_, big.limbs_, big.size_ * sizeof(Limb));
+    res.limbs_[big.size_] = 0;
+    bigint_kernels::addTo(res.limbs_, res.size_, small.limbs_, small.size_);
     res.trim();
     return res;
 }
 
 BigInt BigInt::subMag(const BigInt& a, const BigInt& b) {
     // assumes |a| >= |b|
-    BigInt res;
-    delete[] res.digits_;
-    res.digits_ = new char[a.size_];
-    res.size_ = a.size_;
-    int borrow = 0;
-    for (size_t i = 0; i < a.size_; ++i) {
-        int da = a.digits_[i];
-        int db = i < b.size_ ? b.digits_[i] : 0;
-        int diff = da - db - borrow;
-        if (diff < 0) { diff += 10; borrow = 1; }
-        else borrow = 0;
-        res.digits_[i] = diff;
-    }
+    BigInt res(a.size_, true);
+    std::memcpy(res.limbs_, a.limbs_, a.size_ * sizeof(Limb));
+    bigint_kernels::subFrom(res.limbs_, res.size_, b.limbs_, b.size_);
     res.trim();
     return res;
 }
 
-// Constructors / dtor / assign
-BigInt::BigInt() {
+BigInt::BigInt(size_t limbs, bool positive) {
+    allocate(limbs);
+    size_ = limbs;
+    positive_ = positive;
+}
+
+void BigInt::allocate(size_t limbs) {
+    if (limbs <= InlineLimbs) {
+        limbs_ = inline_;
+        capacity_ = InlineLimbs;
+    } else {
+        limbs_ = new Limb[limbs];
+        capacity_ = limbs;
+    }
+}
+
+void BigInt::release() {
+    if (limbs_ != inline_) delete[] limbs_;
+}
+
+void BigInt::becomeZero() {
+    limbs_ = inline_;
+    capacity_ = InlineLimbs;
     size_ = 1;
-    digits_ = new char[1];
-    digits_[0] = 0;
+    inline_[0] = 0;
     positive_ = true;
 }
 
-BigInt::BigInt(const char* s) {
-    if (!s) throw std::invalid_argument("null string");
-    std::string str(s);
-    // remove leading/trailing spaces
-    size_t pos = 0;
-    while (pos < str.size() && isspace(static_cast<unsigned char>(str[pos]))) ++pos;
-    size_t end = str.size();
-    while (end > pos && isspace(static_cast<unsigned char>(str[end - 1]))) --end;
-    if (pos >= end) throw std::invalid_argument("empty string");
-    bool sign = true;
-    if (str[pos] == '+') { sign = true; ++pos; }
-    else if (str[pos] == '-') { sign = false; ++pos; }
-    if (pos >= end) throw std::invalid_argument("no digits");
-    // skip leading zeros
-    while (pos < end && str[pos] == '0') ++pos;
-    if (pos == end) {
-        // zero
-        size_ = 1;
-        digits_ = new char[1]; digits_[0] = 0; positive_ = true; return;
-    }
-    size_ = end - pos;
-    digits_ = new char[size_];
-    for (size_t i = 0; i < size_; ++i) {
-        char c = str[end - 1 - i]; // least significant first
-        if (c < '0' || c > '9') { delete[] digits_; digits_ = nullptr; throw std::invalid_argument("bad digit"); }
-        digits_[i] = c - '0';
+void BigInt::reserve(size_t limbs) {
+    if (limbs <= capacity_) return;
+    const size_t capacity = std::max(limbs, capacity_ + capacity_ / 2);
+    Limb* grown = new Limb[capacity];
+    std::memcpy(grown, limbs_, size_ * sizeof(Limb));
+    release();
+    limbs_ = grown;
+    capacity_ = capacity;
+}
+
+void BigInt::addInPlace(const Limb* b, size_t nb, bool positive) {
+    if (positive_ == positive) {
+        if (nb > size_) {
+            reserve(nb + 1);
+            std::fill(limbs_ + size_, limbs_ + nb, Limb(0));
+            size_ = nb;
+        }
+        const Limb carry = bigint_kernels::addTo(limbs_, size_, b, nb);
+        if (carry) {
+            reserve(size_ + 1);
+            limbs_[size_++] = carry;
+        }
+        return;
+    } else if (bigint_kernels::compare(limbs_, size_, b, nb) >= 0) {
+        bigint_kernels::subFrom(limbs_, size_, b, nb);
+    } else {
+        // |b| > |this|: this - b wraps around to B^nb - (b - this), so
+        // negating the limbs gives b - this
+        reserve(nb);
+        std::fill(limbs_ + size_, limbs_ + nb, Limb(0));
+        bigint_kernels::subFrom(limbs_, nb, b, nb);
+        for (size_t i = 0; i < nb; ++i) limbs_[i] = ~limbs_[i];
+        const Limb one = 1;
+        bigint_kernels::addTo(limbs_, nb, &one, 1);
+        size_ = nb;
+        positive_ = positive;
     }
-    positive_ = sign;
     trim();
 }
 
-BigInt::BigInt(const std::string& s) : BigInt(s.c_str()) {}
+BigInt BigInt::copyWithCapacity(size_t limbs) const {
+    BigInt res(std::max(limbs, size_), positive_);
+    res.size_ = size_;
+    std::memcpy(res.limbs_, limbs_, size_ * sizeof(Limb));
+    return res;
+}
+
+// Constructors / dtor / assign
+BigInt::BigInt() {
+    becomeZero();
+}
+
+BigInt::BigInt(const char* s) : BigInt(fromString(s, s ? std::strlen(s) : 0)) {}
+
+BigInt::BigInt(const std::string& s) : BigInt(fromString(s.data(), s.size())) {}
 
 BigInt::BigInt(const BigInt& other) {
+    allocate(other.size_);
     size_ = other.size_;
     positive_ = other.positive_;
-    digits_ = new char[size_];
-    for (size_t i = 0; i < size_; ++i) digits_[i] = other.digits_[i];
+    std::memcpy(limbs_, other.limbs_, size_ * sizeof(Limb));
 }
 
+// A moved-from BigInt is zero. Inline magnitudes are copied, heap ones
+// change owner.
 BigInt::BigInt(BigInt&& other) noexcept {
-    digits_ = other.digits_;
+    if (other.limbs_ == other.inline_) {
+        limbs_ = inline_;
+        capacity_ = InlineLimbs;
+        std::memcpy(inline_, other.inline_, sizeof(inline_));
+    } else {
+        limbs_ = other.limbs_;
+        capacity_ = other.capacity_;
+    }
     size_ = other.size_;
     positive_ = other.positive_;
-    other.digits_ = nullptr;
-    other.size_ = 0;
-    other.positive_ = true;
+    other.becomeZero();
 }
 
 BigInt& BigInt::operator=(const BigInt& other) {
     if (this == &other) return *this;
-    delete[] digits_;
+    if (capacity_ < other.size_) {
+        release();
+        allocate(other.size_);
+    }
     size_ = other.size_;
     positive_ = other.positive_;
-    digits_ = new char[size_];
-    for (size_t i = 0; i < size_; ++i) digits_[i] = other.digits_[i];
+    std::memcpy(limbs_, other.limbs_, size_ * sizeof(Limb));
     return *this;
 }
 
 BigInt& BigInt::operator=(BigInt&& other) noexcept {
     if (this == &other) return *this;
-    delete[] digits_;
-    digits_ = other.digits_;
+    if (other.limbs_ == other.inline_) {
+        std::memcpy(limbs_, other.inline_, other.size_ * sizeof(Limb)); // capacity_ >= InlineLimbs
+    } else {
+        release();
+        limbs_ = other.limbs_;
+        capacity_ = other.capacity_;
+    }
     size_ = other.size_;
     positive_ = other.positive_;
-    other.digits_ = nullptr;
-    other.size_ = 0;
-    other.positive_ = true;
+    other.becomeZero();
     return *this;
 }
 
 BigInt::~BigInt() {
-    delete[] digits_;
+    release();
 }
 
 std::string BigInt::toString() const {
-    std::string s;
-    if (!positive_) s.push_back('-');
-    for (size_t i = 0; i < size_; ++i) s.push_back(char('0' + digits_[size_ - 1 - i]));
+    std::string s(maxChars(), '\0');
+    const std::to_chars_result res = toChars(&s[0], &s[0] + s.size());
+    s.resize(size_t(res.ptr - s.data()));
     return s;
 }
 
+// decimal conversion
+//
+// Up to DecimalBaseDigits digits (DecimalBaseLimbs limbs) numbers are
+// converted 9 digits at a time with single-limb multiply-add and division,
+// O(n^2). Larger ones are split on powers P[k] = 10^(9 * 2^k), computed by
+// repeated squaring: parsing evaluates high * P[k] + low, printing writes
+// |x| / P[k] then |x| % P[k] padded to 9 * 2^k digits. Each level costs a
+// few multiplications or divisions, so the whole conversion follows the
+// speed of operator* and divmod instead of being quadratic.
+namespace {
+    constexpr size_t DecimalBaseDigits = 9 * 40;
+    constexpr size_t DecimalBaseLimbs = 40;
+    constexpr size_t MaxPowerLevels = 48;
+}
+
+BigInt BigInt::fromString(const char* s, size_t n) {
+    if (!s) throw std::invalid_argument("null string");
+    // remove leading/trailing spaces
+    size_t pos = 0;
+    while (pos < n && isspace(static_cast<unsigned char>(s[pos]))) ++pos;
+    size_t end = n;
+    while (end > pos && isspace(static_cast<unsigned char>(s[end - 1]))) --end;
+    if (pos >= end) throw std::invalid_argument("empty string");
+    bool sign = true;
+    if (s[pos] == '+') { sign = true; ++pos; }
+    else if (s[pos] == '-') { sign = false; ++pos; }
+    if (pos >= end) throw std::invalid_argument("no digits");
+    for (size_t i = pos; i < end; ++i)
+        if (s[i] < '0' || s[i] > '9') throw std::invalid_argument("bad digit");
+    BigInt res = parseDecimal(s + pos, end - pos);
+    res.positive_ = sign;
+    res.trim();
+    return res;
+}
+
+BigInt BigInt::parseDecimal(const char* digits, size_t n) {
+    // skip leading zeros
+    while (n > 1 && *digits == '0') { ++digits; --n; }
+    BigInt powers[MaxPowerLevels];
+    if (n > DecimalBaseDigits) {
+        powers[0] = BigInt(1, true);
+        powers[0].limbs_[0] = DecimalChunk;
+        for (size_t k = 1; (DecimalChunkDigits << k) < n; ++k)
+            powers[k] = powers[k - 1] * powers[k - 1];
+    }
+    return parseDigits(digits, n, powers);
+}
+
+BigInt BigInt::parseDigits(const char* digits, size_t n, const BigInt* powers) {
+    if (n > DecimalBaseDigits) {
+        size_t k = 0;
+        while ((DecimalChunkDigits << (k + 1)) < n) ++k;
+        const size_t low = DecimalChunkDigits << k;
+        BigInt res = parseDigits(digits, n - low, powers) * powers[k];
+        res += parseDigits(digits + n - low, low, powers);
+        return res;
+    }
+
+    // 10^9 < 2^32, so every 9 decimal digits add less than one limb
+    BigInt res(n / DecimalChunkDigits + 1, true);
+    res.size_ = 0;
+    // most significant chunk first: value = value * 10^len + chunk
+    size_t len = n % DecimalChunkDigits ? n % DecimalChunkDigits : DecimalChunkDigits;
+    for (size_t pos = 0; pos < n; pos += len, len = DecimalChunkDigits) {
+        Limb chunk = 0, scale = 1;
+        for (size_t i = 0; i < len; ++i) {
+            chunk = chunk * 10 + Limb(digits[pos + i] - '0');
+            scale *= 10;
+        }
+        Limb carry = bigint_kernels::mulAddSmall(res.limbs_, res.size_, scale, chunk);
+        if (carry) res.limbs_[res.size_++] = carry;
+    }
+    if (res.size_ == 0) res.limbs_[res.size_++] = 0;
+    res.trim();
+    return res;
+}
+
+std::from_chars_result BigInt::fromChars(const char* first, const char* last, BigInt& value) {
+    const char* p = first;
+    const bool positive = !(p != last && *p == '-');
+    if (!positive) ++p;
+    const char* digits = p;
+    while (p != last && *p >= '0' && *p <= '9') ++p;
+    if (p == digits) return {first, std::errc::invalid_argument};
+    value = parseDecimal(digits, size_t(p - digits));
+    value.positive_ = positive;
+    value.trim();
+    return {p, std::errc()};
+}
+
+size_t BigInt::maxChars() const {
+    // 32 * log10(2) < 9.633 digits per limb, plus the sign
+    return (size_ * 9633 + 999) / 1000 + 1 + (positive_ ? 0 : 1);
+}
+
+std::to_chars_result BigInt::toChars(char* first, char* last) const {
+    if (size_t(last - first) < maxChars()) {
+        // the bound is a little loose: convert once to find the length
+        const std::string s = toString();
+        if (s.size() > size_t(last - first)) return {last, std::errc::value_too_large};
+        std::memcpy(first, s.data(), s.size());
+        return {first + s.size(), std::errc()};
+    }
+    char* out = first;
+    if (!positive_) *out++ = '-';
+    // powers[level] = 10^(9 * 2^level) is the first power above |*this|
+    BigInt powers[MaxPowerLevels];
+    size_t level = 0;
+    if (size_ > DecimalBaseLimbs) {
+        powers[0] = BigInt(1, true);
+        powers[0].limbs_[0] = DecimalChunk;
+        while (absCompare(powers[level], *this) <= 0) {
+            powers[level + 1] = powers[level] * powers[level];
+            ++level;
+        }
+    }
+    return {writeDigits(out, level, false, powers), std::errc()};
+}
+
+char* BigInt::writeDigits(char* out, size_t level, bool pad, const BigInt* powers) const {
+    if (level == 0 || size_ <= DecimalBaseLimbs)
+        return writeSmall(out, pad ? DecimalChunkDigits << level : 0);
+    // |*this| < P[level] = P[level - 1]^2, so both halves are below P[level - 1]
+    const std::pair<BigInt, BigInt> qr = divmod(*this, powers[level - 1]);
+    if (!pad && qr.first.isZero()) return qr.second.writeDigits(out, level - 1, false, powers);
+    out = qr.first.writeDigits(out, level - 1, pad, powers);
+    return qr.second.writeDigits(out, level - 1, true, powers);
+}
+
+char* BigInt::writeSmall(char* out, size_t width) const {
+    // peel off 9 decimal digits at a time, least significant first, into
+    // the end of a local buffer
+    Limb work[DecimalBaseLimbs];
+    char digits[DecimalBaseLimbs * 10 + DecimalChunkDigits];
+    std::memcpy(work, limbs_, size_ * sizeof(Limb));
+    size_t n = bigint_kernels::trimmedLength(work, size_);
+    char* end = digits + sizeof(digits);
+    char* begin = end;
+    while (n != 0) {
+        Limb rem = bigint_kernels::divSmall(work, n, DecimalChunk);
+        n = bigint_kernels::trimmedLength(work, n);
+        for (size_t i = 0; i < DecimalChunkDigits && (n != 0 || rem != 0); ++i) {
+            *--begin = char('0' + rem % 10);
+            rem /= 10;
+        }
+    }
+    const size_t count = size_t(end - begin);
+    if (width > count) {
+        std::memset(out, '0', width - count);
+        out += width - count;
+    } else if (count == 0) {
+        *out++ = '0';
+    }
+    std::memcpy(out, begin, count);
+    return out + count;
+}
+
+// binary encoding
+namespace {
+    size_t varintSize(uint64_t v) {
+        size_t n = 1;
+        for (; v >= 0x80; v >>= 7) ++n;
+        return n;
+    }
+}
+
+size_t BigInt::encodedSize() const {
+    const size_t bytes = (bitLength() + 7) / 8;
+    return varintSize(uint64_t(bytes) << 1) + bytes;
+}
+
+uint8_t* BigInt::encode(uint8_t* out) const {
+    const size_t bytes = (bitLength() + 7) / 8;
+    for (uint64_t header = (uint64_t(bytes) << 1) | (positive_ ? 0 : 1); ; header >>= 7) {
+        if (header < 0x80) {
+            *out++ = uint8_t(header);
+            break;
+        }
+        *out++ = uint8_t(header | 0x80);
+    }
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    std::memcpy(out, limbs_, bytes);
+#else
+    for (size_t i = 0; i < bytes; ++i) out[i] = uint8_t(limbs_[i / 4] >> (8 * (i % 4)));
+#endif
+    return out + bytes;
+}
+
+const uint8_t* BigInt::decode(const uint8_t* first, const uint8_t* last, BigInt& value) {
+    const uint8_t* p = first;
+    uint64_t header = 0;
+    for (unsigned shift = 0; ; shift += 7) {
+        // at most 10 bytes, the 10th holding the 64th bit only, and no
+        // overlong trailing zero byte
+        if (p == last || shift > 63) return nullptr;
+        const uint8_t byte = *p++;
+        if ((shift == 63 && byte > 1) || (byte == 0 && shift != 0)) return nullptr;
+        header |= uint64_t(byte & 0x7f) << shift;
+        if (byte < 0x80) break;
+    }
+    const uint64_t bytes = header >> 1;
+    const bool negative = header & 1;
+    if (bytes > uint64_t(last - p)) return nullptr;
+    if (bytes == 0 ? negative : p[bytes - 1] == 0) return nullptr;
+
+    BigInt res(std::max<size_t>(1, (size_t(bytes) + 3) / 4), !negative);
+    res.limbs_[res.size_ - 1] = 0;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    std::memcpy(res.limbs_, p, size_t(bytes));
+#else
+    std::fill(res.limbs_, res.limbs_ + res.size_, Limb(0));
+    for (size_t i = 0; i < bytes; ++i) res.limbs_[i / 4] |= Limb(p[i]) << (8 * (i % 4));
+#endif
+    value = std::move(res);
+    return p + bytes;
+}
+
 // comparisons
 bool BigInt::operator==(const BigInt& other) const {
     if (positive_ != other.positive_) return false;
     if (size_ != other.size_) return false;
-    for (size_t i = 0; i < size_; ++i) if (digits_[i] != other.digits_[i]) return false;
-    return true;
+    return std::memcmp(limbs_, other.limbs_, size_ * sizeof(Limb)) == 0;
 }
 
 bool BigInt::operator!=(const BigInt& other) const { return !(*this == other); }
@@ -169,9 +462,14 @@ bool BigInt::operator>=(const BigInt& other) const { return !(*this < other); }
 
 // arithmetic
 BigInt BigInt::operator+(const BigInt& other) const {
+    {
+        BigInt res;
+        if (addSmall(*this, other, other.positive_, res)) return res;
+    }
     if (positive_ == other.positive_) {
         BigInt res = addMag(*this, other);
         res.positive_ = positive_;
+        res.trim();
         return res;
     } else {
         int cmp = absCompare(*this, other);
@@ -189,9 +487,14 @@ BigInt BigInt::operator+(const BigInt& other) const {
 }
 
 BigInt BigInt::operator-(const BigInt& other) const {
+    {
+        BigInt res;
+        if (addSmall(*this, other, !other.positive_, res)) return res;
+    }
     if (positive_ != other.positive_) {
         BigInt res = addMag(*this, other);
         res.positive_ = positive_;
+        res.trim();
         return res;
     } else {
         int cmp = absCompare(*this, other);
@@ -209,27 +512,218 @@ BigInt BigInt::operator-(const BigInt& other) const {
 }
 
 BigInt BigInt::operator*(const BigInt& other) const {
-    BigInt res;
-    delete[] res.digits_;
-    res.size_ = size_ + other.size_;
-    res.digits_ = new char[res.size_];
-    for (size_t i = 0; i < res.size_; ++i) res.digits_[i] = 0;
-    for (size_t i = 0; i < size_; ++i) {
-        int carry = 0;
-        for (size_t j = 0; j < other.size_; ++j) {
-            int cur = res.digits_[i + j] + digits_[i] * other.digits_[j] + carry;
-            res.digits_[i + j] = cur % 10;
-            carry = cur / 10;
+    if (size_ + other.size_ <= InlineLimbs) {
+        // the product fits in 128 bits
+        BigInt res;
+        res.size_ = store(res.limbs_, load(limbs_, size_) * load(other.limbs_, other.size_));
+        res.positive_ = positive_ == other.positive_;
+        res.trim();
+        return res;
+    }
+    BigInt res(size_ + other.size_, positive_ == other.positive_);
+    bigint_kernels::multiply(limbs_, size_, other.limbs_, other.size_, res.limbs_);
+    res.trim();
+    return res;
+}
+
+std::pair<BigInt, BigInt> divmod(const BigInt& a, const BigInt& b) {
+    if (b.isZero()) throw std::domain_error("division by zero");
+    if (BigInt::absCompare(a, b) < 0) return {BigInt(), a};
+    BigInt q(a.size_ - b.size_ + 1, a.positive_ == b.positive_);
+    BigInt r(b.size_, a.positive_);
+    bigint_kernels::divide(a.limbs_, a.size_, b.limbs_, b.size_, q.limbs_, r.limbs_);
+    q.trim();
+    r.trim();
+    return {std::move(q), std::move(r)};
+}
+
+BigInt BigInt::operator/(const BigInt& other) const { return divmod(*this, other).first; }
+BigInt BigInt::operator%(const BigInt& other) const { return divmod(*this, other).second; }
+
+BigInt powmod(const BigInt& base, const BigInt& exponent, const BigInt& modulus) {
+    if (!modulus.positive_ || modulus.isZero()) throw std::domain_error("powmod: modulus must be positive");
+    if (!exponent.positive_) throw std::domain_error("powmod: negative exponent");
+    if (modulus.size_ == 1 && modulus.limbs_[0] == 1) return BigInt();
+    BigInt b = base % modulus;
+    if (!b.positive_) b = b + modulus;
+    BigInt res(modulus.size_, true);
+    bigint_kernels::powMod(b.limbs_, b.size_, exponent.limbs_, exponent.size_,
+                           modulus.limbs_, modulus.size_, res.limbs_);
+    res.trim();
+    return res;
+}
+
+// compound assignment
+BigInt& BigInt::operator+=(const BigInt& other) {
+    if (this == &other) {
+        // a += a doubles a
+        reserve(size_ + 1);
+        const Limb carry = bigint_kernels::shiftLeft(limbs_, limbs_, size_, 1);
+        if (carry) limbs_[size_++] = carry;
+        return *this;
+    }
+    addInPlace(other.limbs_, other.size_, other.positive_);
+    return *this;
+}
+
+BigInt& BigInt::operator-=(const BigInt& other) {
+    if (this == &other) return *this = BigInt();
+    addInPlace(other.limbs_, other.size_, !other.positive_);
+    return *this;
+}
+
+BigInt& BigInt::operator*=(const BigInt& other) { return *this = *this * other; }
+BigInt& BigInt::operator/=(const BigInt& other) { return *this = *this / other; }
+BigInt& BigInt::operator%=(const BigInt& other) { return *this = *this % other; }
+
+void BigInt::addScalar(uint64_t mag, bool negative) {
+    if (mag == 0) return;
+    if (positive_ != negative && mag <= Limb(~limbs_[0])) {
+        // no carry out of the low limb: the common case of a counter
+        limbs_[0] += Limb(mag);
+        return;
+    }
+    const Limb b[2] = {Limb(mag), Limb(mag >> 32)};
+    addInPlace(b, b[1] ? 2 : 1, !negative);
+}
+
+void BigInt::mulScalar(uint64_t mag, bool negative) {
+    reserve(size_ + 2);
+    const uint64_t carry = bigint_kernels::mulDoubleLimb(limbs_, size_, mag);
+    limbs_[size_++] = Limb(carry);
+    limbs_[size_++] = Limb(carry >> 32);
+    if (negative) positive_ = !positive_;
+    trim();
+}
+
+void BigInt::divScalar(uint64_t mag, bool negative) {
+    if (mag == 0) throw std::domain_error("division by zero");
+    bigint_kernels::divDoubleLimb(limbs_, size_, mag);
+    if (negative) positive_ = !positive_;
+    trim();
+}
+
+void BigInt::modScalar(uint64_t mag) {
+    if (mag == 0) throw std::domain_error("division by zero");
+    const uint64_t rem = bigint_kernels::divDoubleLimb(limbs_, size_, mag);
+    // rem < mag fits in the two limbs that size_ >= 1 and capacity_ >= 4 leave
+    limbs_[0] = Limb(rem);
+    limbs_[1] = Limb(rem >> 32);
+    size_ = 2;
+    trim();
+}
+
+BigInt BigInt::operator-() const { BigInt r(*this); r.positive_ = !r.positive_; r.trim(); return r; }
+
+// bitwise
+template <class Op>
+BigInt BigInt::bitwise(const BigInt& a, const BigInt& b, Op op) {
+    // One limb more than the longer operand holds both in two's complement.
+    // A negative x is ~(|x| - 1), so the limbs of |x| - 1 are formed on the
+    // fly with a borrow; a negative result is converted back the same way,
+    // as ~r + 1.
+    const bool aNeg = !a.positive_, bNeg = !b.positive_;
+    const bool neg = op(aNeg ? ~Limb(0) : 0, bNeg ? ~Limb(0) : 0) != 0;
+    const size_t n = std::max(a.size_, b.size_) + 1;
+    BigInt res(n, !neg);
+    Limb aBorrow = aNeg, bBorrow = bNeg, carry = neg;
+    for (size_t i = 0; i < n; ++i) {
+        Limb x = i < a.size_ ? a.limbs_[i] : 0;
+        Limb y = i < b.size_ ? b.limbs_[i] : 0;
+        if (aNeg) {
+            const Limb t = x - aBorrow;
+            aBorrow = aBorrow && x == 0;
+            x = ~t;
+        }
+        if (bNeg) {
+            const Limb t = y - bBorrow;
+            bBorrow = bBorrow && y == 0;
+            y = ~t;
+        }
+        Limb z = op(x, y);
+        if (neg) {
+            z = ~z + carry;
+            carry = carry && z == 0;
         }
-        res.digits_[i + other.size_] += carry;
+        res.limbs_[i] = z;
     }
-    res.positive_ = (positive_ == other.positive_);
     res.trim();
     return res;
 }
 
-BigInt BigInt::operator+(int32_t rhs) const { return *this + BigInt(std::to_string(rhs)); }
-BigInt BigInt::operator-(int32_t rhs) const { return *this - BigInt(std::to_string(rhs)); }
-BigInt BigInt::operator*(int32_t rhs) const { return *this * BigInt(std::to_string(rhs)); }
+BigInt BigInt::operator&(const BigInt& other) const {
+    return bitwise(*this, other, [](Limb x, Limb y) { return x & y; });
+}
+
+BigInt BigInt::operator|(const BigInt& other) const {
+    return bitwise(*this, other, [](Limb x, Limb y) { return x | y; });
+}
+
+BigInt BigInt::operator^(const BigInt& other) const {
+    return bitwise(*this, other, [](Limb x, Limb y) { return x ^ y; });
+}
+
+BigInt BigInt::operator~() const { BigInt r = copyWithCapacity(size_ + 1); r.positive_ = !r.positive_; r -= 1; return r; }
+
+BigInt BigInt::operator<<(size_t bits) const {
+    BigInt r = copyWithCapacity(size_ + bits / 32 + 1);
+    r <<= bits;
+    return r;
+}
+
+BigInt BigInt::operator>>(size_t bits) const { BigInt r(*this); r >>= bits; return r; }
+
+BigInt& BigInt::operator&=(const BigInt& other) { return *this = *this & other; }
+BigInt& BigInt::operator|=(const BigInt& other) { return *this = *this | other; }
+BigInt& BigInt::operator^=(const BigInt& other) { return *this = *this ^ other; }
+
+BigInt& BigInt::operator<<=(size_t bits) {
+    if (isZero()) return *this;
+    const size_t limbShift = bits / 32;
+    reserve(size_ + limbShift + 1);
+    const Limb top = bigint_kernels::shiftLeft(limbs_, limbs_, size_, unsigned(bits % 32));
+    limbs_[size_] = top;
+    const size_t n = size_ + (top != 0);
+    std::memmove(limbs_ + limbShift, limbs_, n * sizeof(Limb));
+    std::fill(limbs_, limbs_ + limbShift, Limb(0));
+    size_ = n + limbShift;
+    return *this;
+}
 
-BigInt BigInt::operator-() const { BigInt r(*this); r.positive_ = !r.positive_; return r; }
+BigInt& BigInt::operator>>=(size_t bits) {
+    const bool negative = !positive_;
+    const size_t limbShift = bits / 32;
+    if (limbShift >= size_) {
+        // everything is shifted out: 0, or -1 for a negative value
+        size_ = 1;
+        limbs_[0] = 0;
+        positive_ = true;
+        if (negative) *this -= 1;
+        return *this;
+    }
+    const unsigned s = unsigned(bits % 32);
+    // a negative value rounds towards -inf when one bits are shifted out
+    bool lost = (limbs_[limbShift] & ((Limb(1) << s) - 1)) != 0;
+    for (size_t i = 0; i < limbShift && !lost; ++i) lost = limbs_[i] != 0;
+    size_ -= limbShift;
+    std::memmove(limbs_, limbs_ + limbShift, size_ * sizeof(Limb));
+    bigint_kernels::shiftRight(limbs_, limbs_, size_, s);
+    trim();
+    if (negative && lost) {
+        positive_ = false;
+        const Limb one = 1;
+        addInPlace(&one, 1, false);
+    }
+    return *this;
+}
+
+size_t BigInt::popcount() const {
+    size_t count = 0;
+    for (size_t i = 0; i < size_; ++i) count += size_t(__builtin_popcount(limbs_[i]));
+    return count;
+}
+
+size_t BigInt::bitLength() const {
+    if (isZero()) return 0;
+    return 32 * size_ - size_t(__builtin_clz(limbs_[size_ - 1]));
+}
@@ -0,0 +1,27 @@
+#include "../include/BigIntBatch.hpp"
+
+void BigIntBatch::add(const BigInt* a, const BigInt* b, BigInt* out, size_t n, ThreadPool& pool) {
+    apply(a, b, out, n, [](const BigInt& x, const BigInt& y) { return x + y; }, pool);
+}
+
+void BigIntBatch::subtract(const BigInt* a, const BigInt* b, BigInt* out, size_t n, ThreadPool& pool) {
+    apply(a, b, out, n, [](const BigInt& x, const BigInt& y) { return x - y; }, pool);
+}
+
+void BigIntBatch::multiply(const BigInt* a, const BigInt* b, BigInt* out, size_t n, ThreadPool& pool) {
+    apply(a, b, out, n, [](const BigInt& x, const BigInt& y) { return x * y; }, pool);
+}
+
+void BigIntBatch::divide(const BigInt* a, const BigInt* b, BigInt* out, size_t n, ThreadPool& pool) {
+    apply(a, b, out, n, [](const BigInt& x, const BigInt& y) { return x / y; }, pool);
+}
+
+void BigIntBatch::modulo(const BigInt* a, const BigInt* b, BigInt* out, size_t n, ThreadPool& pool) {
+    apply(a, b, out, n, [](const BigInt& x, const BigInt& y) { return x % y; }, pool);
+}
+
+void BigIntBatch::powmod(const BigInt* base, const BigInt* exponent, const BigInt& modulus,
+                         BigInt* out, size_t n, ThreadPool& pool) {
+    apply(base, exponent, out, n,
+          [&modulus](const BigInt& x, const BigInt& e) { return ::powmod(x, e, modulus); }, pool);
+}
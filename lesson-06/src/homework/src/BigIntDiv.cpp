@@ -0,0 +1,314 @@
+#include "../include/BigIntKernels.hpp"
+#include "../include/BigInt.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+// Division and modular exponentiation on limbs, B = 2^32.
+//
+// Both divisions shift u and v left until the top bit of v is set, which
+// bounds the error of every quotient estimate. Knuth's algorithm D (TAOCP
+// 4.3.1) then produces one quotient limb per step, O(nv * (nu - nv)).
+// Newton division computes X = floor((B^2n - 1) / v), n = nv, by Newton
+// iteration (each step doubles the correct limbs for a few multiply()
+// calls) and divides u by n-limb blocks from the top as Barrett reduction
+// does: two n-limb products per block instead of n^2 limb operations.
+
+namespace bigint_kernels
+{
+    namespace
+    {
+        const Limb One = 1;
+
+        // Knuth D on normalised operands: u has nu + 1 limbs (u[nu] holds
+        // the bits shifted out by normalisation), v has nv >= 2 limbs with
+        // the top bit set; q gets nu - nv + 1 limbs and the remainder is
+        // left in u[0..nv).
+        void divKnuth(Limb* u, size_t nu, const Limb* v, size_t nv, Limb* q) {
+            const DoubleLimb base = DoubleLimb(1) << LimbBits;
+            const Limb vTop = v[nv - 1], vNext = v[nv - 2];
+            for (size_t j = nu - nv + 1; j-- > 0;) {
+                // estimate from the top two limbs, refine with the third:
+                // qhat is then at most one too large
+                const DoubleLimb top = (DoubleLimb(u[j + nv]) << LimbBits) | u[j + nv - 1];
+                DoubleLimb qhat = top / vTop, rhat = top % vTop;
+                while (qhat >= base || qhat * vNext > ((rhat << LimbBits) | u[j + nv - 2])) {
+                    --qhat;
+                    rhat += vTop;
+                    if (rhat >= base) break;
+                }
+                const DoubleLimb borrow = subMul(u + j, v, nv, Limb(qhat));
+                if (borrow > u[j + nv]) {
+                    --qhat; // went negative: add v back
+                    u[j + nv] = Limb(u[j + nv] - borrow + addTo(u + j, nv, v, nv));
+                } else {
+                    u[j + nv] = Limb(u[j + nv] - borrow);
+                }
+                q[j] = Limb(qhat);
+            }
+        }
+
+        // below this the reciprocal is computed by Knuth D directly
+        constexpr size_t ReciprocalBase = 8;
+
+        // x[0..n] = floor((B^2n - 1) / v) for normalised v of n limbs
+        void reciprocal(const Limb* v, size_t n, Limb* x) {
+            if (n == 1) {
+                const DoubleLimb q = ~DoubleLimb(0) / v[0];
+                x[0] = Limb(q);
+                x[1] = Limb(q >> LimbBits);
+                return;
+            }
+            if (n < ReciprocalBase) {
+                Buffer u(2 * n + 1);
+                std::fill(u.p, u.p + 2 * n, ~Limb(0));
+                divKnuth(u.p, 2 * n, v, n, x);
+                return;
+            }
+
+            // X0 = xh * B^l from the reciprocal of the top h limbs, then one
+            // Newton step X1 = X0 + X0 * (B^2n - v * X0) / B^2n. With
+            // vx = v * xh the error term is (B^(n+h) - vx) * B^l, so the
+            // correction reduces to xh * |B^(n+h) - vx| / B^2h.
+            const size_t h = (n + 1) / 2, l = n - h;
+            Buffer xh(h + 1);
+            reciprocal(v + l, h, xh.p);
+
+            Buffer vx(n + h + 1);
+            multiply(v, n, xh.p, h + 1, vx.p);
+            const bool over = vx.p[n + h] != 0; // v * X0 >= B^2n
+            if (over) {
+                vx.p[n + h] -= 1;
+            } else {
+                // B^(n+h) - vx = ~vx + 1 on n + h limbs
+                for (size_t i = 0; i < n + h; ++i) vx.p[i] = ~vx.p[i];
+                addTo(vx.p, n + h, &One, 1);
+            }
+            const size_t nd = trimmedLength(vx.p, n + h + 1);
+
+            Buffer x1(n + 2);
+            std::memcpy(x1.p + l, xh.p, (h + 1) * sizeof(Limb));
+            if (nd != 0) {
+                Buffer corr(h + 1 + nd);
+                multiply(xh.p, h + 1, vx.p, nd, corr.p);
+                const size_t nc = h + 1 + nd > 2 * h ? trimmedLength(corr.p + 2 * h, h + 1 + nd - 2 * h) : 0;
+                if (over) {
+                    subFrom(x1.p, n + 2, corr.p + 2 * h, nc);
+                    subFrom(x1.p, n + 2, &One, 1); // round the correction up
+                } else {
+                    addTo(x1.p, n + 2, corr.p + 2 * h, nc);
+                }
+            }
+
+            // exact fix-up: 0 <= (B^2n - 1) - v * X < v
+            Buffer p(2 * n + 2);
+            multiply(v, n, x1.p, n + 2, p.p);
+            if (p.p[2 * n] != 0 || p.p[2 * n + 1] != 0) {
+                while (p.p[2 * n] != 0 || p.p[2 * n + 1] != 0) {
+                    subFrom(x1.p, n + 2, &One, 1);
+                    subFrom(p.p, 2 * n + 2, v, n);
+                }
+            } else {
+                // (B^2n - 1) - p = ~p on 2n limbs
+                for (size_t i = 0; i < 2 * n; ++i) p.p[i] = ~p.p[i];
+                while (compare(p.p, 2 * n, v, n) >= 0) {
+                    addTo(x1.p, n + 2, &One, 1);
+                    subFrom(p.p, 2 * n, v, n);
+                }
+            }
+            std::memcpy(x, x1.p, (n + 1) * sizeof(Limb));
+        }
+
+        // Newton division of u (nu limbs) by normalised v (n limbs): q gets
+        // ceil(nu / n) * n limbs, r gets n.
+        void divNewton(const Limb* u, size_t nu, const Limb* v, size_t n, Limb* q, Limb* r) {
+            Buffer x(n + 1);
+            reciprocal(v, n, x.p);
+
+            // cur = rem * B^n + block < v * B^n, so each block quotient
+            // fits in n limbs
+            Buffer cur(2 * n), prod(2 * n + 2), qv(2 * n + 1);
+            for (size_t b = (nu + n - 1) / n; b-- > 0;) {
+                const size_t lo = b * n, len = std::min(n, nu - lo);
+                std::memcpy(cur.p, u + lo, len * sizeof(Limb));
+                std::fill(cur.p + len, cur.p + n, Limb(0));
+
+                // qb = floor(floor(cur / B^(n-1)) * X / B^(n+1)), at most
+                // a few units below the true quotient
+                multiply(cur.p + n - 1, n + 1, x.p, n + 1, prod.p);
+                Limb* qb = prod.p + n + 1;
+                multiply(qb, n + 1, v, n, qv.p);
+                subFrom(cur.p, 2 * n, qv.p, 2 * n);
+                while (compare(cur.p, 2 * n, v, n) >= 0) {
+                    subFrom(cur.p, 2 * n, v, n);
+                    addTo(qb, n + 1, &One, 1);
+                }
+                std::memcpy(q + lo, qb, n * sizeof(Limb));
+                std::memcpy(cur.p + n, cur.p, n * sizeof(Limb));
+            }
+            std::memcpy(r, cur.p + n, n * sizeof(Limb));
+        }
+
+        // Montgomery arithmetic modulo an odd m of n limbs, R = B^n:
+        // mul(a, b) = a * b / R mod m for a, b < m. Keeping numbers as
+        // a * R mod m turns every modular product into a multiplication
+        // plus n limb-by-row steps, with no division.
+        class Montgomery {
+        private:
+            const Limb* m_;
+            size_t n_;
+            Limb negInv_; // -m^-1 mod B
+            Buffer t_;    // 2n + 1 limbs
+
+        public:
+            Montgomery(const Limb* m, size_t n) : m_(m), n_(n), t_(2 * n + 1) {
+                Limb inv = m[0]; // Newton: each step doubles the correct bits
+                for (int i = 0; i < 5; ++i) inv *= 2 - m[0] * inv;
+                negInv_ = 0u - inv;
+            }
+
+            void mul(Limb* r, const Limb* a, const Limb* b) {
+                multiply(a, n_, b, n_, t_.p);
+                t_.p[2 * n_] = 0;
+                reduce(r);
+            }
+
+            // r = a / R mod m
+            void fromMontgomery(Limb* r, const Limb* a) {
+                std::memcpy(t_.p, a, n_ * sizeof(Limb));
+                std::fill(t_.p + n_, t_.p + 2 * n_ + 1, Limb(0));
+                reduce(r);
+            }
+
+        private:
+            // r = t / R mod m for t < m * R: add multiples of m clearing
+            // the low limbs one at a time
+            void reduce(Limb* r) {
+                Limb* t = t_.p;
+                for (size_t i = 0; i < n_; ++i) {
+                    const Limb carry = addMul(t + i, m_, n_, t[i] * negInv_);
+                    addTo(t + i + n_, n_ + 1 - i, &carry, 1);
+                }
+                if (t[2 * n_] != 0 || compare(t + n_, n_, m_, n_) >= 0)
+                    subFrom(t + n_, n_ + 1, m_, n_);
+                std::memcpy(r, t + n_, n_ * sizeof(Limb));
+            }
+        };
+
+        bool bit(const Limb* e, size_t i) { return (e[i / LimbBits] >> (i % LimbBits)) & 1; }
+
+        // exponent bits -> sliding window width
+        unsigned windowBits(size_t bits) {
+            return bits > 768 ? 6 : bits > 256 ? 5 : bits > 64 ? 4 : bits > 24 ? 3 : 1;
+        }
+
+        // left-to-right binary exponentiation reducing with divide()
+        void powModPlain(const Limb* base, const Limb* exp, size_t bits,
+                         const Limb* m, size_t n, Limb* r) {
+            Buffer acc(n), prod(2 * n), q(n + 1);
+            acc.p[0] = 1;
+            for (size_t i = bits; i-- > 0;) {
+                multiply(acc.p, n, acc.p, n, prod.p);
+                divide(prod.p, 2 * n, m, n, q.p, acc.p);
+                if (bit(exp, i)) {
+                    multiply(acc.p, n, base, n, prod.p);
+                    divide(prod.p, 2 * n, m, n, q.p, acc.p);
+                }
+            }
+            std::memcpy(r, acc.p, n * sizeof(Limb));
+        }
+    }
+
+    void divide(const Limb* u, size_t nu, const Limb* v, size_t nv, Limb* q, Limb* r) {
+        if (nv == 1) {
+            std::memcpy(q, u, nu * sizeof(Limb));
+            r[0] = divSmall(q, nu, v[0]);
+            return;
+        }
+        const unsigned s = unsigned(__builtin_clz(v[nv - 1]));
+        Buffer vn(nv), un(nu + 1);
+        shiftLeft(vn.p, v, nv, s);
+        un.p[nu] = shiftLeft(un.p, u, nu, s);
+
+        const size_t threshold = std::max<size_t>(bigIntMulOptions().divNewtonThreshold, 2);
+        if (nv >= threshold && nu - nv + 1 >= threshold) {
+            Buffer qn((nu + nv) / nv * nv), rn(nv);
+            divNewton(un.p, nu + 1, vn.p, nv, qn.p, rn.p);
+            std::memcpy(q, qn.p, (nu - nv + 1) * sizeof(Limb));
+            shiftRight(r, rn.p, nv, s);
+        } else {
+            divKnuth(un.p, nu, vn.p, nv, q);
+            shiftRight(r, un.p, nv, s);
+        }
+    }
+
+    void powMod(const Limb* base, size_t nbase, const Limb* exp, size_t nexp,
+                const Limb* m, size_t nm, Limb* r) {
+        const size_t n = nm;
+        nexp = trimmedLength(exp, nexp);
+        std::fill(r, r + n, Limb(0));
+        if (nexp == 0) {
+            r[0] = 1;
+            return;
+        }
+        const size_t bits = nexp * LimbBits - size_t(__builtin_clz(exp[nexp - 1]));
+        Buffer b(n);
+        std::memcpy(b.p, base, nbase * sizeof(Limb));
+
+        if ((m[0] & 1) == 0) {
+            powModPlain(b.p, exp, bits, m, n, r);
+            return;
+        }
+
+        Montgomery mont(m, n);
+        // R^2 mod m converts into Montgomery form
+        Buffer r2(n);
+        {
+            Buffer pow(2 * n + 1), q(n + 2);
+            pow.p[2 * n] = 1;
+            divide(pow.p, 2 * n + 1, m, n, q.p, r2.p);
+        }
+
+        // odd powers base^1, base^3, ..., base^(2^k - 1)
+        const unsigned k = windowBits(bits);
+        const size_t entries = size_t(1) << (k - 1);
+        Buffer table(entries * n), square(n);
+        mont.mul(table.p, b.p, r2.p);
+        mont.mul(square.p, table.p, table.p);
+        for (size_t i = 1; i < entries; ++i)
+            mont.mul(table.p + i * n, table.p + (i - 1) * n, square.p);
+
+        // sliding window over the exponent, top bit first; the top bit
+        // is set, so the first window starts the accumulator
+        Buffer accBuf(n), tmpBuf(n);
+        Limb* acc = accBuf.p;
+        Limb* tmp = tmpBuf.p;
+        bool started = false;
+        for (size_t i = bits; i-- > 0;) {
+            if (!bit(exp, i)) {
+                mont.mul(tmp, acc, acc);
+                std::swap(acc, tmp);
+                continue;
+            }
+            size_t low = i + 1 >= k ? i + 1 - k : 0;
+            while (!bit(exp, low)) ++low;
+            size_t window = 0;
+            for (size_t j = i + 1; j-- > low;) window = 2 * window + bit(exp, j);
+            const Limb* power = table.p + (window / 2) * n;
+            if (started) {
+                for (size_t j = low; j <= i; ++j) {
+                    mont.mul(tmp, acc, acc);
+                    std::swap(acc, tmp);
+                }
+                mont.mul(tmp, acc, power);
+                std::swap(acc, tmp);
+            } else {
+                std::memcpy(acc, power, n * sizeof(Limb));
+                started = true;
+            }
+            i = low;
+        }
+        mont.fromMontgomery(r, acc);
+    }
+}
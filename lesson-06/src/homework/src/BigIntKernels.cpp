@@ -0,0 +1,407 @@
+#include "../include/BigIntKernels.hpp"
+#include "../include/BigInt.hpp"
+#include "../include/ThreadPool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+BigIntMulOptions& bigIntMulOptions() {
+    static BigIntMulOptions options;
+    return options;
+}
+
+namespace bigint_kernels
+{
+    namespace
+    {
+        using u128 = unsigned __int128;
+
+        // Signed number used by the Toom-3 evaluation and interpolation,
+        // where intermediate values can be negative.
+        class Number {
+        private:
+            Limb* d_ = nullptr;
+            size_t n_ = 0; // capacity; limbs above the value are zero
+            bool neg_ = false;
+
+        public:
+            explicit Number(size_t n) : d_(new Limb[n + 1]()), n_(n + 1) {}
+            Number(const Limb* a, size_t na, size_t n) : Number(std::max(na, n)) {
+                std::memcpy(d_, a, na * sizeof(Limb));
+            }
+            Number(Number&& o) noexcept : d_(o.d_), n_(o.n_), neg_(o.neg_) { o.d_ = nullptr; o.n_ = 0; }
+            Number& operator=(Number&& o) noexcept {
+                std::swap(d_, o.d_); std::swap(n_, o.n_); std::swap(neg_, o.neg_);
+                return *this;
+            }
+            Number(const Number&) = delete;
+            Number& operator=(const Number&) = delete;
+            ~Number() { delete[] d_; }
+
+            Limb* data() { return d_; }
+            const Limb* data() const { return d_; }
+            size_t capacity() const { return n_; }
+            size_t size() const { return trimmedLength(d_, n_); }
+            bool negative() const { return neg_; }
+            void setNegative(bool neg) { neg_ = neg && size() != 0; }
+
+            // x + y, or x - y when `subtract`
+            static Number add(const Number& x, const Number& y, bool subtract = false) {
+                const bool yneg = subtract ? !y.neg_ : y.neg_;
+                const size_t nx = x.size(), ny = y.size();
+                Number r(std::max(nx, ny) + 1);
+                if (x.neg_ == yneg) {
+                    std::memcpy(r.d_, x.d_, nx * sizeof(Limb));
+                    addTo(r.d_, r.n_, y.d_, ny);
+                    r.setNegative(x.neg_);
+                } else if (compare(x.d_, nx, y.d_, ny) >= 0) {
+                    std::memcpy(r.d_, x.d_, nx * sizeof(Limb));
+                    subFrom(r.d_, r.n_, y.d_, ny);
+                    r.setNegative(x.neg_);
+                } else {
+                    std::memcpy(r.d_, y.d_, ny * sizeof(Limb));
+                    subFrom(r.d_, r.n_, x.d_, nx);
+                    r.setNegative(yneg);
+                }
+                return r;
+            }
+
+            // exact division of the magnitude by a small divisor
+            void divExact(Limb divisor) {
+                [[maybe_unused]] Limb rem = divSmall(d_, n_, divisor);
+                assert(rem == 0);
+            }
+
+            static Number product(const Number& x, const Number& y) {
+                const size_t nx = x.size(), ny = y.size();
+                Number r(nx + ny);
+                multiply(x.d_, nx, y.d_, ny, r.d_);
+                r.setNegative(x.neg_ != y.neg_);
+                return r;
+            }
+        };
+
+        void toom3(const Limb* a, size_t na, const Limb* b, size_t nb, Limb* r);
+
+        // Toom-3 needs both operands longer than 2/3 of the longer one.
+        bool useToom3(size_t na, size_t nb) {
+            const size_t m = std::min(na, nb);
+            return m >= std::max<size_t>(bigIntMulOptions().toom3Threshold, 3)
+                && m > 2 * ((std::max(na, nb) + 2) / 3);
+        }
+
+        // Scratch limbs needed by karatsuba() on operands of at most n limbs.
+        size_t karatsubaScratch(size_t n) { return 6 * n + 64; }
+
+        void karatsuba(const Limb* a, size_t na, const Limb* b, size_t nb, Limb* r, Limb* scratch) {
+            if (na < nb) { std::swap(a, b); std::swap(na, nb); }
+            // below 4 limbs the (h + 1)-limb middle product is not smaller
+            if (nb < std::max<size_t>(bigIntMulOptions().karatsubaThreshold, 4)) {
+                mulSchoolbook(a, na, b, nb, r);
+                return;
+            }
+            if (useToom3(na, nb)) {
+                toom3(a, na, b, nb, r);
+                return;
+            }
+            const size_t h = (na + 1) / 2;
+
+            ThreadPool* pool = parallelPool(nb);
+
+            if (nb <= h) {
+                // unbalanced: a = a0 + a1 * B^h, both halves times the whole of b
+                Limb* t = scratch;
+                if (pool) {
+                    // the second half gets its own scratch
+                    Buffer own(na - h + nb + karatsubaScratch(std::max(na - h, nb)));
+                    t = own.p;
+                    TaskGroup group(*pool);
+                    group.run([=] { karatsuba(a + h, na - h, b, nb, t, t + (na - h + nb)); });
+                    karatsuba(a, h, b, nb, r, scratch);
+                    group.wait();
+                    std::fill(r + h + nb, r + na + nb, Limb(0));
+                    addTo(r + h, na + nb - h, t, na - h + nb);
+                    return;
+                }
+                karatsuba(a, h, b, nb, r, scratch);
+                std::fill(r + h + nb, r + na + nb, Limb(0));
+                karatsuba(a + h, na - h, b, nb, t, scratch + (na - h + nb));
+                addTo(r + h, na + nb - h, t, na - h + nb);
+                return;
+            }
+
+            // z1 = (a0 + a1)(b0 + b1), later minus z0 and z2
+            Limb* sa = scratch;
+            Limb* sb = sa + h + 1;
+            Limb* z1 = sb + h + 1;
+            auto middle = [&] {
+                std::memcpy(sa, a, h * sizeof(Limb)); sa[h] = 0;
+                std::memcpy(sb, b, h * sizeof(Limb)); sb[h] = 0;
+                addTo(sa, h + 1, a + h, na - h);
+                addTo(sb, h + 1, b + h, nb - h);
+                karatsuba(sa, h + 1, sb, h + 1, z1, z1 + 2 * h + 2);
+            };
+
+            // z0 = a0*b0 and z2 = a1*b1 go straight into r
+            if (pool) {
+                Buffer s0(karatsubaScratch(h)), s2(karatsubaScratch(h));
+                TaskGroup group(*pool);
+                group.run([=, &s0] { karatsuba(a, h, b, h, r, s0.p); });
+                group.run([=, &s2] { karatsuba(a + h, na - h, b + h, nb - h, r + 2 * h, s2.p); });
+                middle();
+                group.wait();
+            } else {
+                karatsuba(a, h, b, h, r, scratch);
+                karatsuba(a + h, na - h, b + h, nb - h, r + 2 * h, scratch);
+                middle();
+            }
+            subFrom(z1, 2 * h + 2, r, 2 * h);
+            subFrom(z1, 2 * h + 2, r + 2 * h, na + nb - 2 * h);
+
+            addTo(r + h, na + nb - h, z1, std::min(trimmedLength(z1, 2 * h + 2), na + nb - h));
+        }
+
+        // Toom-3 (Bodrato's evaluation at 0, 1, -1, -2, inf). Both operands
+        // must have more than 2k limbs, k = ceil(max(na, nb) / 3).
+        void toom3(const Limb* a, size_t na, const Limb* b, size_t nb, Limb* r) {
+            const size_t k = (std::max(na, nb) + 2) / 3;
+            const size_t cap = k + 2;
+
+            auto evaluate = [&](const Limb* x, size_t nx, Number* e) {
+                Number x0(x, k, cap), x1(x + k, k, cap), x2(x + 2 * k, nx - 2 * k, cap);
+                Number p = Number::add(x0, x2);
+                e[1] = Number::add(p, x1);             // p(1)
+                e[2] = Number::add(p, x1, true);       // p(-1)
+                Number t = Number::add(e[2], x2);
+                t = Number::add(t, t);
+                e[3] = Number::add(t, x0, true);       // p(-2) = 2(p(-1) + x2) - x0
+                e[0] = std::move(x0);                  // p(0)
+                e[4] = std::move(x2);                  // p(inf)
+            };
+            Number ea[5] = {Number(0), Number(0), Number(0), Number(0), Number(0)};
+            Number eb[5] = {Number(0), Number(0), Number(0), Number(0), Number(0)};
+            evaluate(a, na, ea);
+            evaluate(b, nb, eb);
+
+            Number w[5] = {Number(0), Number(0), Number(0), Number(0), Number(0)};
+            if (ThreadPool* pool = parallelPool(std::min(na, nb))) {
+                TaskGroup group(*pool);
+                for (size_t i = 1; i < 5; ++i)
+                    group.run([&, i] { w[i] = Number::product(ea[i], eb[i]); });
+                w[0] = Number::product(ea[0], eb[0]);
+                group.wait();
+            } else {
+                for (size_t i = 0; i < 5; ++i) w[i] = Number::product(ea[i], eb[i]);
+            }
+            Number& w0 = w[0];
+            Number& w1 = w[1];
+            Number& wm1 = w[2];
+            Number& wm2 = w[3];
+            Number& winf = w[4];
+
+            Number r3 = Number::add(wm2, w1, true);
+            r3.divExact(3);
+            Number r1 = Number::add(w1, wm1, true);
+            r1.divExact(2);
+            Number r2 = Number::add(wm1, w0, true);
+            r3 = Number::add(r2, r3, true);
+            r3.divExact(2);
+            r3 = Number::add(r3, winf);
+            r3 = Number::add(r3, winf);
+            r2 = Number::add(r2, r1);
+            r2 = Number::add(r2, winf, true);
+            r1 = Number::add(r1, r3, true);
+
+            // r = w0 + r1 B^k + r2 B^2k + r3 B^3k + winf B^4k; every
+            // coefficient of a product of non-negative parts is non-negative
+            const size_t n = na + nb;
+            std::fill(r, r + n, Limb(0));
+            const Number* coeffs[5] = {&w0, &r1, &r2, &r3, &winf};
+            for (size_t i = 0; i < 5; ++i) {
+                assert(!coeffs[i]->negative());
+                const size_t len = coeffs[i]->size();
+                if (len != 0)
+                    addTo(r + i * k, n - i * k, coeffs[i]->data(), len);
+            }
+        }
+    }
+
+    int compare(const Limb* a, size_t na, const Limb* b, size_t nb) {
+        na = trimmedLength(a, na);
+        nb = trimmedLength(b, nb);
+        if (na != nb) return na > nb ? 1 : -1;
+        for (size_t i = na; i-- > 0;)
+            if (a[i] != b[i]) return a[i] > b[i] ? 1 : -1;
+        return 0;
+    }
+
+    size_t trimmedLength(const Limb* a, size_t n) {
+        while (n > 0 && a[n - 1] == 0) --n;
+        return n;
+    }
+
+    Limb addTo(Limb* r, size_t nr, const Limb* a, size_t na) {
+        DoubleLimb carry = 0;
+        size_t i = 0;
+        for (; i < na; ++i) {
+            carry += DoubleLimb(r[i]) + a[i];
+            r[i] = Limb(carry);
+            carry >>= LimbBits;
+        }
+        for (; carry && i < nr; ++i) {
+            carry += r[i];
+            r[i] = Limb(carry);
+            carry >>= LimbBits;
+        }
+        return Limb(carry);
+    }
+
+    Limb subFrom(Limb* r, size_t nr, const Limb* a, size_t na) {
+        Limb borrow = 0;
+        size_t i = 0;
+        for (; i < na; ++i) {
+            const DoubleLimb diff = DoubleLimb(r[i]) - a[i] - borrow;
+            r[i] = Limb(diff);
+            borrow = Limb(diff >> (2 * LimbBits - 1));
+        }
+        for (; borrow && i < nr; ++i) {
+            borrow = r[i] == 0;
+            --r[i];
+        }
+        return borrow;
+    }
+
+    Limb mulAddSmall(Limb* r, size_t n, Limb m, Limb add) {
+        DoubleLimb carry = add;
+        for (size_t i = 0; i < n; ++i) {
+            carry += DoubleLimb(r[i]) * m;
+            r[i] = Limb(carry);
+            carry >>= LimbBits;
+        }
+        return Limb(carry);
+    }
+
+    Limb divSmall(Limb* r, size_t n, Limb d) {
+        DoubleLimb rem = 0;
+        for (size_t i = n; i-- > 0;) {
+            const DoubleLimb cur = (rem << LimbBits) | r[i];
+            r[i] = Limb(cur / d);
+            rem = cur % d;
+        }
+        return Limb(rem);
+    }
+
+    DoubleLimb mulDoubleLimb(Limb* r, size_t n, DoubleLimb m) {
+        if (m >> LimbBits == 0) return mulAddSmall(r, n, Limb(m), 0);
+        u128 carry = 0;
+        for (size_t i = 0; i < n; ++i) {
+            carry += u128(r[i]) * m;
+            r[i] = Limb(carry);
+            carry >>= LimbBits;
+        }
+        return DoubleLimb(carry);
+    }
+
+    DoubleLimb divDoubleLimb(Limb* r, size_t n, DoubleLimb d) {
+        if (d >> LimbBits == 0) return divSmall(r, n, Limb(d));
+        u128 rem = 0;
+        for (size_t i = n; i-- > 0;) {
+            const u128 cur = (rem << LimbBits) | r[i];
+            r[i] = Limb(cur / d);
+            rem = cur % d;
+        }
+        return DoubleLimb(rem);
+    }
+
+    Limb addMul(Limb* r, const Limb* a, size_t n, Limb m) {
+        DoubleLimb carry = 0;
+        for (size_t i = 0; i < n; ++i) {
+            carry += DoubleLimb(a[i]) * m + r[i];
+            r[i] = Limb(carry);
+            carry >>= LimbBits;
+        }
+        return Limb(carry);
+    }
+
+    DoubleLimb subMul(Limb* r, const Limb* a, size_t n, Limb m) {
+        DoubleLimb carry = 0;
+        Limb borrow = 0;
+        for (size_t i = 0; i < n; ++i) {
+            carry += DoubleLimb(a[i]) * m;
+            const DoubleLimb diff = DoubleLimb(r[i]) - Limb(carry) - borrow;
+            r[i] = Limb(diff);
+            borrow = Limb(diff >> (2 * LimbBits - 1));
+            carry >>= LimbBits;
+        }
+        return carry + borrow;
+    }
+
+    Limb shiftLeft(Limb* r, const Limb* a, size_t n, unsigned s) {
+        if (s == 0) {
+            std::memmove(r, a, n * sizeof(Limb));
+            return 0;
+        }
+        Limb out = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const Limb x = a[i];
+            r[i] = (x << s) | out;
+            out = x >> (LimbBits - s);
+        }
+        return out;
+    }
+
+    void shiftRight(Limb* r, const Limb* a, size_t n, unsigned s) {
+        if (s == 0) {
+            std::memmove(r, a, n * sizeof(Limb));
+            return;
+        }
+        for (size_t i = 0; i + 1 < n; ++i)
+            r[i] = (a[i] >> s) | (a[i + 1] << (LimbBits - s));
+        if (n) r[n - 1] = a[n - 1] >> s;
+    }
+
+    void mulSchoolbook(const Limb* a, size_t na, const Limb* b, size_t nb, Limb* r) {
+        std::fill(r, r + na + nb, Limb(0));
+        for (size_t i = 0; i < na; ++i) {
+            const DoubleLimb ai = a[i];
+            DoubleLimb carry = 0;
+            for (size_t j = 0; j < nb; ++j) {
+                carry += ai * b[j] + r[i + j];
+                r[i + j] = Limb(carry);
+                carry >>= LimbBits;
+            }
+            r[i + nb] = Limb(carry);
+        }
+    }
+
+    ThreadPool* parallelPool(size_t m) {
+        const BigIntMulOptions& opt = bigIntMulOptions();
+        if (opt.parallelThreshold == 0 || m < opt.parallelThreshold) return nullptr;
+        ThreadPool& pool = opt.pool ? *opt.pool : ThreadPool::instance();
+        return pool.concurrency() > 1 ? &pool : nullptr;
+    }
+
+    void multiply(const Limb* a, size_t na, const Limb* b, size_t nb, Limb* r) {
+        const size_t n = std::max(na, nb), m = std::min(na, nb);
+        if (m == 0) {
+            std::fill(r, r + na + nb, Limb(0));
+            return;
+        }
+        if (m >= bigIntMulOptions().nttThreshold && nttSupported(na, nb)) {
+            mulNtt(a, na, b, nb, r);
+            return;
+        }
+        if (useToom3(na, nb)) {
+            toom3(a, na, b, nb, r);
+            return;
+        }
+        if (m < bigIntMulOptions().karatsubaThreshold) {
+            mulSchoolbook(a, na, b, nb, r);
+            return;
+        }
+        Buffer scratch(karatsubaScratch(n));
+        karatsuba(a, na, b, nb, r, scratch.p);
+    }
+}
@@ -0,0 +1,209 @@
+#include "../include/BigIntKernels.hpp"
+#include "../include/ThreadPool.hpp"
+
+#include <algorithm>
+
+// Multiplication through number-theoretic transforms.
+//
+// The limbs of both operands are taken as polynomial coefficients and
+// convolved modulo three NTT-friendly primes below 2^30. Each coefficient of
+// the exact convolution is less than min(na, nb) * 2^64 <= 2^85, below the
+// product of the primes (~2^85.9), so the Chinese remainder theorem (in
+// Garner's form) recovers it exactly; the coefficients are then summed with
+// carries into base-2^32 limbs.
+
+namespace bigint_kernels
+{
+    namespace
+    {
+        using u32 = uint32_t;
+        using u64 = uint64_t;
+        using u128 = unsigned __int128;
+
+        // Arithmetic modulo P < 2^30. mul() is a Montgomery product,
+        // a * b / 2^32 mod P, which needs no division; the transforms keep
+        // values multiplied by 2^32 ("Montgomery form") so that products of
+        // two such values stay in that form.
+        template <u32 P>
+        struct Mod {
+            static constexpr u32 negInv() { // -P^-1 mod 2^32
+                u32 x = P;
+                for (int i = 0; i < 5; ++i) x *= 2 - P * x;
+                return 0u - x;
+            }
+            static constexpr u32 NegInv = negInv();
+            static constexpr u32 R2 = u32((u128(1) << 64) % P); // 2^64 mod P
+
+            // x mod P for x < 2P. Written with min() (x - P wraps around
+            // when x < P) so that it stays branch-free: a conditional here
+            // mispredicts on random data.
+            static constexpr u32 reduce(u32 x) { return std::min(x, x - P); }
+
+            static constexpr u32 add(u32 a, u32 b) { return reduce(a + b); }
+            static constexpr u32 sub(u32 a, u32 b) { return reduce(a - b + P); }
+            static constexpr u32 mul(u32 a, u32 b) {
+                const u64 t = u64(a) * b;
+                const u32 m = u32(t) * NegInv;
+                return reduce(u32((t + u64(m) * P) >> 32));
+            }
+            static constexpr u32 toMontgomery(u32 a) { return mul(a, R2); }
+
+            // plain (not Montgomery) modular exponentiation and inverse
+            static constexpr u32 pow(u32 a, u64 e) {
+                u64 r = 1, x = a;
+                for (; e; e >>= 1, x = x * x % P)
+                    if (e & 1) r = r * x % P;
+                return u32(r);
+            }
+            static constexpr u32 inv(u32 a) { return pow(a, P - 2); }
+        };
+
+        // Montgomery-form roots of unity of order 2^(s + 1), for the stage
+        // of each transform whose butterflies are 2^s apart.
+        template <u32 P>
+        struct StageRoots {
+            u32 forward[24] = {};
+            u32 inverse[24] = {};
+
+            constexpr StageRoots() {
+                for (unsigned s = 0; s < 24 && ((P - 1) >> (s + 1)) << (s + 1) == P - 1; ++s) {
+                    const u32 w = Mod<P>::pow(3, (P - 1) >> (s + 1));
+                    forward[s] = Mod<P>::toMontgomery(w);
+                    inverse[s] = Mod<P>::toMontgomery(Mod<P>::inv(w));
+                }
+            }
+        };
+
+        template <u32 P>
+        constexpr StageRoots<P> stageRoots{};
+
+        // p = c * 2^k + 1 with primitive root 3 (see StageRoots); the
+        // transform length is limited by the smallest k (23).
+        constexpr u32 P1 = 998244353; // 119 * 2^23 + 1
+        constexpr u32 P2 = 167772161; // 5 * 2^25 + 1
+        constexpr u32 P3 = 469762049; // 7 * 2^26 + 1
+        constexpr size_t MaxLength = size_t(1) << 23;
+        constexpr size_t MaxShorter = size_t(1) << 21; // keeps coefficients < 2^85
+
+        // Owned, uninitialised array of residues.
+        struct Residues {
+            u32* p;
+            explicit Residues(size_t n) : p(new u32[n]) {}
+            ~Residues() { delete[] p; }
+            Residues(const Residues&) = delete;
+            Residues& operator=(const Residues&) = delete;
+        };
+
+        // In-place decimation-in-frequency transform on Montgomery-form
+        // values: natural order in, bit-reversed order out. tw receives the
+        // twiddles of each stage.
+        template <u32 P>
+        void forward(u32* a, size_t n, u32* tw) {
+            using M = Mod<P>;
+            unsigned stage = 0;
+            while ((size_t(2) << stage) < n) ++stage;
+            for (size_t len = n >> 1; len >= 1; len >>= 1, --stage) {
+                const u32 w = stageRoots<P>.forward[stage];
+                tw[0] = M::toMontgomery(1);
+                for (size_t j = 1; j < len; ++j) tw[j] = M::mul(tw[j - 1], w);
+                for (size_t i = 0; i < n; i += 2 * len) {
+                    u32* x = a + i;
+                    u32* y = a + i + len;
+                    for (size_t j = 0; j < len; ++j) {
+                        const u32 u = x[j], v = y[j];
+                        x[j] = M::add(u, v);
+                        y[j] = M::mul(M::sub(u, v), tw[j]);
+                    }
+                }
+            }
+        }
+
+        // Inverse of forward(): bit-reversed order in, natural order out,
+        // including the division by n and the conversion out of Montgomery
+        // form.
+        template <u32 P>
+        void inverse(u32* a, size_t n, u32* tw) {
+            using M = Mod<P>;
+            unsigned stage = 0;
+            for (size_t len = 1; len < n; len <<= 1, ++stage) {
+                const u32 w = stageRoots<P>.inverse[stage];
+                tw[0] = M::toMontgomery(1);
+                for (size_t j = 1; j < len; ++j) tw[j] = M::mul(tw[j - 1], w);
+                for (size_t i = 0; i < n; i += 2 * len) {
+                    u32* x = a + i;
+                    u32* y = a + i + len;
+                    for (size_t j = 0; j < len; ++j) {
+                        const u32 u = x[j], v = M::mul(y[j], tw[j]);
+                        x[j] = M::add(u, v);
+                        y[j] = M::sub(u, v);
+                    }
+                }
+            }
+            const u32 scale = M::inv(u32(n % P));
+            for (size_t i = 0; i < n; ++i) a[i] = M::mul(a[i], scale);
+        }
+
+        // out[0..n) = cyclic convolution of a and b modulo P
+        template <u32 P>
+        void convolve(const Limb* a, size_t na, const Limb* b, size_t nb, bool square,
+                      u32* out, u32* work, u32* tw, size_t n) {
+            using M = Mod<P>;
+            for (size_t i = 0; i < na; ++i) out[i] = M::toMontgomery(a[i] % P);
+            std::fill(out + na, out + n, 0u);
+            forward<P>(out, n, tw);
+            if (square) {
+                for (size_t i = 0; i < n; ++i) out[i] = M::mul(out[i], out[i]);
+            } else {
+                for (size_t i = 0; i < nb; ++i) work[i] = M::toMontgomery(b[i] % P);
+                std::fill(work + nb, work + n, 0u);
+                forward<P>(work, n, tw);
+                for (size_t i = 0; i < n; ++i) out[i] = M::mul(out[i], work[i]);
+            }
+            inverse<P>(out, n, tw);
+        }
+    }
+
+    bool nttSupported(size_t na, size_t nb) {
+        return std::min(na, nb) <= MaxShorter && na + nb <= MaxLength;
+    }
+
+    void mulNtt(const Limb* a, size_t na, const Limb* b, size_t nb, Limb* r) {
+        size_t n = 1;
+        while (n < na + nb) n <<= 1;
+        const bool square = a == b && na == nb;
+
+        Residues r1(n), r2(n), r3(n), work(n), tw(n / 2 + 1);
+        if (ThreadPool* pool = parallelPool(std::min(na, nb))) {
+            // one prime per task, each with its own work and twiddle arrays
+            Residues work2(n), tw2(n / 2 + 1), work3(n), tw3(n / 2 + 1);
+            TaskGroup group(*pool);
+            group.run([&] { convolve<P2>(a, na, b, nb, square, r2.p, work2.p, tw2.p, n); });
+            group.run([&] { convolve<P3>(a, na, b, nb, square, r3.p, work3.p, tw3.p, n); });
+            convolve<P1>(a, na, b, nb, square, r1.p, work.p, tw.p, n);
+            group.wait();
+        } else {
+            convolve<P1>(a, na, b, nb, square, r1.p, work.p, tw.p, n);
+            convolve<P2>(a, na, b, nb, square, r2.p, work.p, tw.p, n);
+            convolve<P3>(a, na, b, nb, square, r3.p, work.p, tw.p, n);
+        }
+
+        // Garner: x = x1 + x2 * P1 + x3 * P1 * P2. The residues are plain
+        // values, so the constants are in Montgomery form for mul() to
+        // return plain products.
+        constexpr u32 invP1modP2 = Mod<P2>::toMontgomery(Mod<P2>::inv(P1 % P2));
+        constexpr u32 invP1P2modP3 = Mod<P3>::toMontgomery(Mod<P3>::inv(u32(u64(P1) * P2 % P3)));
+        constexpr u32 p1modP3 = Mod<P3>::toMontgomery(P1 % P3);
+        constexpr u64 p1p2 = u64(P1) * P2;
+
+        u128 carry = 0;
+        for (size_t i = 0; i < na + nb; ++i) {
+            const u32 x1 = r1.p[i];
+            const u32 x2 = Mod<P2>::mul(Mod<P2>::sub(r2.p[i], x1 % P2), invP1modP2);
+            const u32 t = Mod<P3>::add(x1 % P3, Mod<P3>::mul(x2, p1modP3));
+            const u32 x3 = Mod<P3>::mul(Mod<P3>::sub(r3.p[i], t), invP1P2modP3);
+            carry += u128(x1) + u128(x2) * P1 + u128(x3) * p1p2;
+            r[i] = Limb(carry);
+            carry >>= LimbBits;
+        }
+    }
+}
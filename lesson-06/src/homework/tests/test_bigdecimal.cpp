@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "../include/BigDecimal.hpp"
+
+namespace
+{
+    BigDecimal dec(const char* s) { return BigDecimal(std::string(s)); }
+}
+
+TEST(BigDecimal, ParseAndPrint) {
+    EXPECT_EQ(dec("123.4500").toString(), "123.4500");
+    EXPECT_EQ(dec("123.4500").scale(), 4);
+    EXPECT_EQ(dec("-0.05").toString(), "-0.05");
+    EXPECT_EQ(dec("-0.05").unscaled().toString(), "-5");
+    EXPECT_EQ(dec("42").scale(), 0);
+    EXPECT_EQ(dec("0.000").toString(), "0.000");
+    EXPECT_EQ(BigDecimal(BigInt("-7"), 3).toString(), "-0.007");
+    EXPECT_EQ(BigDecimal(BigInt("12"), -3).toString(), "12000");
+
+    for (const char* bad : {"", ".5", "1.", "-.5", "1.2.3", "1.-2", "1e5", "--1"})
+        EXPECT_THROW(dec(bad), std::invalid_argument) << bad;
+}
+
+TEST(BigDecimal, SurroundingWhitespace) {
+    for (const char* text : {"1.5", " 1.5", "1.5 ", "1.5\n", "\t 1.5 \r\n"}) {
+        EXPECT_EQ(dec(text).toString(), "1.5") << text;
+        EXPECT_EQ(dec(text).scale(), 1) << text;
+    }
+    EXPECT_EQ(dec("  -0.050  ").toString(), "-0.050");
+    EXPECT_EQ(dec(" 42 ").scale(), 0);
+    for (const char* bad : {"   ", " .5 ", "1. ", "1. 5", "1 .5"})
+        EXPECT_THROW(dec(bad), std::invalid_argument) << bad;
+}
+
+TEST(BigDecimal, Arithmetic) {
+    EXPECT_EQ((dec("1.25") + dec("2.5")).toString(), "3.75");
+    EXPECT_EQ((dec("2.5") + dec("1.25")).toString(), "3.75");
+    EXPECT_EQ((dec("1.25") - dec("2.5")).toString(), "-1.25");
+    EXPECT_EQ((dec("-1.5") * dec("0.25")).toString(), "-0.375");
+    EXPECT_EQ((dec("19.99") * dec("3")).toString(), "59.97");
+    EXPECT_EQ((-dec("3.10")).toString(), "-3.10");
+
+    BigDecimal sum;
+    for (int i = 0; i < 10; ++i) sum += dec("0.1");
+    EXPECT_EQ(sum.toString(), "1.0");
+    EXPECT_EQ(sum, dec("1"));
+    sum -= dec("0.001");
+    EXPECT_EQ(sum.toString(), "0.999");
+    sum *= dec("1000");
+    EXPECT_EQ(sum.toString(), "999.000");
+
+    // far beyond 64 bits
+    const BigDecimal big("123456789012345678901234567890.123456789");
+    EXPECT_EQ((big * big).toString(),
+              "15241578753238836750495351562566681945005334557625361987875.019051998750190521");
+}
+
+TEST(BigDecimal, DivideAndRounding) {
+    // java.math.RoundingMode's table, dividing by 1 to scale 0
+    const char* inputs[] = {"5.5", "2.5", "1.6", "1.1", "1.0", "-1.0", "-1.1", "-1.6", "-2.5", "-5.5"};
+    const struct { RoundingMode mode; const char* expected[10]; } table[] = {
+        {RoundingMode::Up, {"6", "3", "2", "2", "1", "-1", "-2", "-2", "-3", "-6"}},
+        {RoundingMode::Down, {"5", "2", "1", "1", "1", "-1", "-1", "-1", "-2", "-5"}},
+        {RoundingMode::Ceiling, {"6", "3", "2", "2", "1", "-1", "-1", "-1", "-2", "-5"}},
+        {RoundingMode::Floor, {"5", "2", "1", "1", "1", "-1", "-2", "-2", "-3", "-6"}},
+        {RoundingMode::HalfUp, {"6", "3", "2", "1", "1", "-1", "-1", "-2", "-3", "-6"}},
+        {RoundingMode::HalfDown, {"5", "2", "2", "1", "1", "-1", "-1", "-2", "-2", "-5"}},
+        {RoundingMode::HalfEven, {"6", "2", "2", "1", "1", "-1", "-1", "-2", "-2", "-6"}},
+    };
+    for (const auto& row : table) {
+        for (size_t i = 0; i < 10; ++i) {
+            EXPECT_EQ(dec(inputs[i]).setScale(0, row.mode).toString(), row.expected[i])
+                << inputs[i] << " mode " << int(row.mode);
+            EXPECT_EQ(dec(inputs[i]).divide(dec("1"), 0, row.mode).toString(), row.expected[i])
+                << inputs[i] << " mode " << int(row.mode);
+        }
+    }
+
+    EXPECT_EQ(dec("1").divide(dec("3"), 10).toString(), "0.3333333333");
+    EXPECT_EQ(dec("2").divide(dec("3"), 4, RoundingMode::Down).toString(), "0.6666");
+    EXPECT_EQ(dec("-2").divide(dec("0.03"), 2).toString(), "-66.67");
+    EXPECT_EQ(dec("100").divide(dec("7"), -1).toString(), "10");
+    EXPECT_EQ((dec("10.00") / dec("4")).toString(), "2.50");
+    EXPECT_EQ(dec("12.345").setScale(5).toString(), "12.34500");
+    // more than 19 places at once
+    EXPECT_EQ(dec("2.5000000000000000000000000").setScale(0).toString(), "2");
+    EXPECT_EQ(dec("2.5000000000000000000000001").setScale(0).toString(), "3");
+    EXPECT_EQ(dec("-7.0000000000000000000000001").setScale(0, RoundingMode::Floor).toString(), "-8");
+    EXPECT_THROW(dec("1") / dec("0.00"), std::domain_error);
+}
+
+TEST(BigDecimal, Comparisons) {
+    EXPECT_EQ(dec("1.5"), dec("1.50"));
+    EXPECT_NE(dec("1.5"), dec("1.51"));
+    EXPECT_LT(dec("1.5"), dec("1.51"));
+    EXPECT_LT(dec("-2"), dec("-1.999"));
+    EXPECT_GT(dec("0.1"), dec("0.09999999999999999999999"));
+    EXPECT_LE(dec("3.0"), dec("3"));
+    EXPECT_GE(dec("3.0"), dec("3"));
+    EXPECT_EQ(BigDecimal(BigInt("5"), -2), dec("500.0"));
+}
+
+TEST(BigDecimal, ScaleOverflow) {
+    const BigDecimal tiny(BigInt("1"), 2000000000);
+    EXPECT_THROW(tiny * tiny, std::overflow_error);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "../include/BigInt.hpp"
+
+#include <random>
+#include <vector>
+
+namespace
+{
+    std::string randomNumber(size_t n, std::mt19937& rng) {
+        std::uniform_int_distribution<int> digit(0, 9);
+        std::string s(n, '0');
+        for (char& c : s) c = char('0' + digit(rng));
+        s[0] = char('1' + digit(rng) % 9);
+        return rng() % 2 ? "-" + s : s;
+    }
+
+    std::vector<uint8_t> encode(const BigInt& a) {
+        std::vector<uint8_t> bytes(a.encodedSize());
+        EXPECT_EQ(a.encode(bytes.data()), bytes.data() + bytes.size());
+        return bytes;
+    }
+}
+
+TEST(BigIntBinary, KnownEncodings) {
+    EXPECT_EQ(encode(BigInt()), (std::vector<uint8_t>{0}));
+    EXPECT_EQ(encode(BigInt("1")), (std::vector<uint8_t>{2, 1}));
+    EXPECT_EQ(encode(BigInt("-1")), (std::vector<uint8_t>{3, 1}));
+    EXPECT_EQ(encode(BigInt("256")), (std::vector<uint8_t>{4, 0, 1}));
+    EXPECT_EQ(encode(BigInt("-4294967296")), (std::vector<uint8_t>{11, 0, 0, 0, 0, 1}));
+    // 64 bytes: the header 128 takes two varint bytes
+    const std::vector<uint8_t> big = encode(BigInt("1") << 511);
+    ASSERT_EQ(big.size(), 66u);
+    EXPECT_EQ(big[0], 0x80);
+    EXPECT_EQ(big[1], 0x01);
+    EXPECT_EQ(big[65], 0x80);
+}
+
+TEST(BigIntBinary, RoundTrip) {
+    std::mt19937 rng(21);
+    std::vector<uint8_t> stream;
+    std::vector<BigInt> values;
+    for (int i = 0; i < 300; ++i) {
+        values.emplace_back(randomNumber(1 + rng() % (i < 250 ? 60 : 3000), rng));
+        const std::vector<uint8_t> bytes = encode(values.back());
+        stream.insert(stream.end(), bytes.begin(), bytes.end());
+    }
+    // values decode one after the other from a single buffer
+    const uint8_t* p = stream.data();
+    const uint8_t* end = stream.data() + stream.size();
+    for (const BigInt& expected : values) {
+        BigInt v;
+        p = BigInt::decode(p, end, v);
+        ASSERT_NE(p, nullptr);
+        EXPECT_EQ(v, expected);
+    }
+    EXPECT_EQ(p, end);
+}
+
+TEST(BigIntBinary, RejectsMalformedInput) {
+    const std::vector<std::vector<uint8_t>> bad = {
+        {},              // empty
+        {4, 1},          // truncated magnitude
+        {1},             // negative zero
+        {4, 1, 0},       // leading zero byte
+        {0x82, 0x00, 1}, // overlong varint
+        {0x80},          // truncated varint
+        {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01}, // too long
+        {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x02}, // bits past the 64th
+    };
+    for (const std::vector<uint8_t>& bytes : bad) {
+        BigInt v("42");
+        EXPECT_EQ(BigInt::decode(bytes.data(), bytes.data() + bytes.size(), v), nullptr);
+        EXPECT_EQ(v.toString(), "42");
+    }
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "../include/BigInt.hpp"
+
+#include <random>
+
+namespace
+{
+    BigInt big(int64_t v) { return BigInt(std::to_string(v)); }
+
+    std::string randomNumber(size_t n, std::mt19937& rng) {
+        std::uniform_int_distribution<int> digit(0, 9);
+        std::string s(n, '0');
+        for (char& c : s) c = char('0' + digit(rng));
+        s[0] = char('1' + digit(rng) % 9);
+        return rng() % 2 ? "-" + s : s;
+    }
+
+    BigInt powerOfTwo(size_t k) {
+        BigInt r("1");
+        for (size_t i = 0; i < k; ++i) r *= 2;
+        return r;
+    }
+
+    // floor(a / 2^k), as operator/ truncates
+    BigInt floorShift(const BigInt& a, size_t k) {
+        const BigInt d = powerOfTwo(k);
+        BigInt q = a / d;
+        if (q * d != a && a < BigInt()) q -= 1;
+        return q;
+    }
+}
+
+TEST(BigIntBits, MatchesInt64) {
+    std::mt19937_64 rng(11);
+    for (int i = 0; i < 2000; ++i) {
+        // keep the values within int64_t after a shift by up to 20 bits
+        const int64_t x = int64_t(rng()) >> (20 + rng() % 40);
+        const int64_t y = int64_t(rng()) >> (rng() % 64);
+        const size_t k = rng() % 21;
+        EXPECT_EQ(big(x) & big(y), big(x & y)) << x << " & " << y;
+        EXPECT_EQ(big(x) | big(y), big(x | y)) << x << " | " << y;
+        EXPECT_EQ(big(x) ^ big(y), big(x ^ y)) << x << " ^ " << y;
+        EXPECT_EQ(~big(x), big(~x)) << "~" << x;
+        EXPECT_EQ(big(x) << k, big(x * (int64_t(1) << k))) << x << " << " << k;
+        EXPECT_EQ(big(y) >> k, big(y >> k)) << y << " >> " << k;
+    }
+}
+
+TEST(BigIntBits, LargeIdentities) {
+    std::mt19937 rng(12);
+    for (int i = 0; i < 200; ++i) {
+        const BigInt a(randomNumber(1 + rng() % 120, rng));
+        const BigInt b(randomNumber(1 + rng() % 120, rng));
+        const size_t k = rng() % 300;
+        EXPECT_EQ((a & b) + (a | b), a + b) << a << " " << b;
+        EXPECT_EQ((a ^ b), (a | b) - (a & b)) << a << " " << b;
+        EXPECT_EQ(a ^ b ^ b, a) << a << " " << b;
+        EXPECT_EQ(~a, -a - 1) << a;
+        EXPECT_EQ(a << k, a * powerOfTwo(k)) << a << " << " << k;
+        EXPECT_EQ(a >> k, floorShift(a, k)) << a << " >> " << k;
+
+        BigInt c = a;
+        c &= b;
+        EXPECT_EQ(c, a & b);
+        c = a;
+        c |= b;
+        EXPECT_EQ(c, a | b);
+        c = a;
+        c ^= b;
+        EXPECT_EQ(c, a ^ b);
+        c = a;
+        c <<= k;
+        c >>= k;
+        EXPECT_EQ(c, a);
+    }
+}
+
+TEST(BigIntBits, EdgeCases) {
+    const BigInt zero;
+    EXPECT_EQ((~zero).toString(), "-1");
+    EXPECT_EQ((~BigInt("-1")).toString(), "0");
+    EXPECT_EQ((zero << 1000).toString(), "0");
+    EXPECT_EQ((BigInt("-1") >> 1000).toString(), "-1");
+    EXPECT_EQ((BigInt("-4294967296") >> 32).toString(), "-1");
+    EXPECT_EQ((BigInt("-4294967297") >> 32).toString(), "-2");
+    EXPECT_EQ((BigInt("12345") >> 100).toString(), "0");
+    EXPECT_EQ((BigInt("-1") & BigInt("18446744073709551616")).toString(), "18446744073709551616");
+    EXPECT_EQ((BigInt("-18446744073709551616") | BigInt("18446744073709551615")).toString(), "-1");
+
+    EXPECT_EQ(zero.popcount(), 0u);
+    EXPECT_EQ(zero.bitLength(), 0u);
+    EXPECT_EQ(BigInt("-255").popcount(), 8u);
+    EXPECT_EQ(BigInt("-255").bitLength(), 8u);
+    const BigInt p = powerOfTwo(1000);
+    EXPECT_EQ(p.popcount(), 1u);
+    EXPECT_EQ(p.bitLength(), 1001u);
+    EXPECT_EQ((p - 1).popcount(), 1000u);
+    EXPECT_EQ((p - 1).bitLength(), 1000u);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "../include/BigInt.hpp"
+
+#include <cstring>
+#include <random>
+
+namespace
+{
+    std::string randomDigits(size_t n, std::mt19937& rng) {
+        std::uniform_int_distribution<int> digit(0, 9);
+        std::string s(n, '0');
+        for (char& c : s) c = char('0' + digit(rng));
+        s[0] = char('1' + digit(rng) % 9);
+        return s;
+    }
+}
+
+TEST(BigIntDecimal, RoundTripAcrossSplitSizes) {
+    std::mt19937 rng(17);
+    for (size_t n : {1, 9, 10, 359, 360, 361, 385, 386, 700, 721, 1000, 2305, 2306, 4000, 9217, 30000}) {
+        const std::string s = randomDigits(n, rng);
+        EXPECT_EQ(BigInt(s).toString(), s) << n;
+        EXPECT_EQ(BigInt("-" + s).toString(), "-" + s) << n;
+    }
+}
+
+TEST(BigIntDecimal, ZerosInsideAndAtTheEnds) {
+    BigInt ten("10");
+    BigInt power("1");
+    for (int i = 1; i <= 3000; ++i) {
+        power *= 10;
+        if (i % 997 != 0 && i != 3000) continue;
+        const std::string s = "1" + std::string(size_t(i), '0');
+        EXPECT_EQ(BigInt(s), power) << i;
+        EXPECT_EQ(power.toString(), s) << i;
+        EXPECT_EQ((power - 1).toString(), std::string(size_t(i), '9')) << i;
+        // a block of zeros inside a number that is split into halves
+        const std::string inner = "7" + std::string(size_t(i), '0') + "123";
+        EXPECT_EQ(BigInt(inner).toString(), inner) << i;
+    }
+    EXPECT_EQ(BigInt(std::string(5000, '0') + "42").toString(), "42");
+    EXPECT_EQ(BigInt(std::string(5000, '0')).toString(), "0");
+}
+
+TEST(BigIntDecimal, ToChars) {
+    const BigInt a("-12345678901234567890");
+    char buf[64];
+    std::to_chars_result res = a.toChars(buf, buf + sizeof(buf));
+    EXPECT_EQ(res.ec, std::errc());
+    EXPECT_EQ(std::string(buf, res.ptr), "-12345678901234567890");
+    EXPECT_GE(a.maxChars(), 21u);
+
+    // exact fit below maxChars(), then one character short
+    res = a.toChars(buf, buf + 21);
+    EXPECT_EQ(res.ec, std::errc());
+    EXPECT_EQ(res.ptr, buf + 21);
+    res = a.toChars(buf, buf + 20);
+    EXPECT_EQ(res.ec, std::errc::value_too_large);
+    EXPECT_EQ(res.ptr, buf + 20);
+
+    res = BigInt().toChars(buf, buf + 1);
+    EXPECT_EQ(std::string(buf, res.ptr), "0");
+}
+
+TEST(BigIntDecimal, FromChars) {
+    const char text[] = "-000123456789012345678901234567890xyz";
+    BigInt v;
+    std::from_chars_result res = BigInt::fromChars(text, text + std::strlen(text), v);
+    EXPECT_EQ(res.ec, std::errc());
+    EXPECT_EQ(res.ptr, text + std::strlen(text) - 3);
+    EXPECT_EQ(v.toString(), "-123456789012345678901234567890");
+
+    const char* bad[] = {"", "-", "+5", " 5", "x1"};
+    for (const char* s : bad) {
+        BigInt untouched("7");
+        res = BigInt::fromChars(s, s + std::strlen(s), untouched);
+        EXPECT_EQ(res.ec, std::errc::invalid_argument) << s;
+        EXPECT_EQ(res.ptr, s) << s;
+        EXPECT_EQ(untouched.toString(), "7") << s;
+    }
+    const char zero[] = "-0";
+    res = BigInt::fromChars(zero, zero + 2, v);
+    EXPECT_EQ(v.toString(), "0");
+}
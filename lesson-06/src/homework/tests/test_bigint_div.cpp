@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "../include/BigInt.hpp"
+
+#include <random>
+
+namespace
+{
+    std::string randomDigits(size_t n, std::mt19937& rng) {
+        std::uniform_int_distribution<int> digit(0, 9);
+        std::string s(n, '0');
+        for (char& c : s) c = char('0' + digit(rng));
+        s[0] = char('1' + digit(rng) % 9);
+        return s;
+    }
+
+    struct MulOptionsGuard {
+        BigIntMulOptions saved = bigIntMulOptions();
+        ~MulOptionsGuard() { bigIntMulOptions() = saved; }
+    };
+
+    void expectDivision(const BigInt& a, const BigInt& b) {
+        auto [q, r] = divmod(a, b);
+        EXPECT_EQ(q * b + r, a) << a << " / " << b;
+        EXPECT_TRUE(r == BigInt() || (r < BigInt()) == (a < BigInt())) << a << " / " << b;
+        EXPECT_TRUE((r < BigInt() ? -r : r) < (b < BigInt() ? -b : b)) << a << " / " << b;
+    }
+
+    // base^exp mod m by repeated multiplication
+    BigInt slowPowmod(const BigInt& base, int exp, const BigInt& m) {
+        BigInt r("1");
+        for (int i = 0; i < exp; ++i) r = r * base % m;
+        return r;
+    }
+}
+
+TEST(BigIntDiv, KnownQuotients) {
+    BigInt a("121932631137021795226185032733622923332237463801111263526900");
+    BigInt b("987654321098765432109876543210");
+    EXPECT_EQ((a / b).toString(), "123456789012345678901234567890");
+    EXPECT_EQ((a % b).toString(), "0");
+    EXPECT_EQ(((a + 17) % b).toString(), "17");
+    EXPECT_EQ((BigInt("7") / BigInt("-2")).toString(), "-3");
+    EXPECT_EQ((BigInt("-7") / BigInt("2")).toString(), "-3");
+    EXPECT_EQ((BigInt("-7") % BigInt("2")).toString(), "-1");
+    EXPECT_EQ((BigInt("7") % BigInt("-2")).toString(), "1");
+    EXPECT_EQ((BigInt("-6") % BigInt("3")).toString(), "0");
+    EXPECT_EQ((BigInt("5") / BigInt("123456789012345678901")).toString(), "0");
+    EXPECT_EQ((BigInt("-5") % BigInt("123456789012345678901")).toString(), "-5");
+    EXPECT_EQ((BigInt("18446744073709551616") / BigInt("4294967296")).toString(), "4294967296");
+    EXPECT_EQ((a / -1000000007).toString(), "-121932630283493383241731350041503473041713152509119");
+    EXPECT_EQ((a % 1000000007).toString(), "195963067");
+    EXPECT_THROW(a / BigInt("0"), std::domain_error);
+    EXPECT_THROW(a % 0, std::domain_error);
+    EXPECT_THROW(divmod(a, BigInt("-0")), std::domain_error);
+}
+
+TEST(BigIntDiv, RandomKnuthAndNewton) {
+    std::mt19937 rng(3);
+    MulOptionsGuard guard;
+    const std::pair<size_t, size_t> sizes[] = {
+        {1, 1}, {20, 1}, {20, 10}, {40, 39}, {100, 50}, {300, 100}, {1000, 500},
+        {2000, 150}, {3000, 1000}, {5000, 2500},
+    };
+    for (size_t threshold : {size_t(-1), size_t(2), size_t(9)}) {
+        bigIntMulOptions().divNewtonThreshold = threshold;
+        for (auto [na, nb] : sizes) {
+            BigInt a(randomDigits(na, rng));
+            BigInt b(randomDigits(nb, rng));
+            expectDivision(a, b);
+            expectDivision(-a, b);
+            expectDivision(a, -b);
+            expectDivision(a * b, b);
+            expectDivision(a * b - 1, b);
+        }
+    }
+}
+
+TEST(BigIntDiv, NewtonEdgeDivisors) {
+    MulOptionsGuard guard;
+    bigIntMulOptions().divNewtonThreshold = 2;
+    // divisors just above and below powers of 2^32 stress the
+    // reciprocal's fix-up and the normalisation shift
+    BigInt limb("4294967296");
+    BigInt power("1");
+    for (int i = 0; i < 40; ++i) power = power * limb;
+    const BigInt divisors[] = {power / 2, power / 2 + 1, power - 1, power / 3, power / 2 * 3 - 1};
+    BigInt dividend = power * power * power - 12345;
+    for (const BigInt& d : divisors) {
+        expectDivision(dividend, d);
+        expectDivision(d * d - 1, d);
+        expectDivision(d * power, d);
+    }
+}
+
+TEST(BigIntDiv, Powmod) {
+    // Fermat: a^(p-1) = 1 mod p for the Mersenne prime 2^127 - 1
+    BigInt p("170141183460469231731687303715884105727");
+    for (const char* a : {"2", "3", "123456789012345678901234567890", "-5"})
+        EXPECT_EQ(powmod(BigInt(a), p - 1, p).toString(), "1") << a;
+
+    std::mt19937 rng(11);
+    for (size_t digits : {5, 30, 200}) {
+        BigInt m(randomDigits(digits, rng));
+        BigInt even = m * 2;
+        BigInt odd = m * 2 + 1;
+        BigInt base(randomDigits(digits + 3, rng));
+        for (int e : {0, 1, 2, 3, 17, 100}) {
+            EXPECT_EQ(powmod(base, BigInt(std::to_string(e)), odd), slowPowmod(base, e, odd)) << digits << " " << e;
+            EXPECT_EQ(powmod(base, BigInt(std::to_string(e)), even), slowPowmod(base, e, even)) << digits << " " << e;
+            BigInt expected = slowPowmod(-base, e, odd);
+            if (expected < BigInt()) expected = expected + odd;
+            EXPECT_EQ(powmod(-base, BigInt(std::to_string(e)), odd), expected) << digits << " " << e;
+        }
+    }
+
+    EXPECT_EQ(powmod(BigInt("5"), BigInt("3"), BigInt("1")).toString(), "0");
+    EXPECT_EQ(powmod(BigInt("0"), BigInt("0"), BigInt("7")).toString(), "1");
+    EXPECT_THROW(powmod(BigInt("2"), BigInt("3"), BigInt("0")), std::domain_error);
+    EXPECT_THROW(powmod(BigInt("2"), BigInt("3"), BigInt("-7")), std::domain_error);
+    EXPECT_THROW(powmod(BigInt("2"), BigInt("-3"), BigInt("7")), std::domain_error);
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "../include/BigInt.hpp"
+
+#include <random>
+
+namespace
+{
+    std::string randomNumber(size_t n, std::mt19937& rng) {
+        std::uniform_int_distribution<int> digit(0, 9);
+        std::string s(n, '0');
+        for (char& c : s) c = char('0' + digit(rng));
+        s[0] = char('1' + digit(rng) % 9);
+        return rng() % 2 ? "-" + s : s;
+    }
+}
+
+TEST(BigIntInPlace, MatchesBinaryOperators) {
+    std::mt19937 rng(5);
+    for (int i = 0; i < 300; ++i) {
+        const BigInt a(randomNumber(1 + rng() % 40, rng));
+        const BigInt b(randomNumber(1 + rng() % 40, rng));
+        BigInt c = a;
+        c += b;
+        EXPECT_EQ(c, a + b) << a << " + " << b;
+        c = a;
+        c -= b;
+        EXPECT_EQ(c, a - b) << a << " - " << b;
+        c = a;
+        c *= b;
+        EXPECT_EQ(c, a * b) << a << " * " << b;
+        c = a;
+        c /= b;
+        EXPECT_EQ(c, a / b) << a << " / " << b;
+        c = a;
+        c %= b;
+        EXPECT_EQ(c, a % b) << a << " % " << b;
+
+        const int32_t k = int32_t(rng());
+        c = a;
+        c += k;
+        EXPECT_EQ(c, a + BigInt(std::to_string(k))) << a << " + " << k;
+        c = a;
+        c -= k;
+        EXPECT_EQ(c, a - BigInt(std::to_string(k))) << a << " - " << k;
+        c = a;
+        c *= k;
+        EXPECT_EQ(c, a * BigInt(std::to_string(k))) << a << " * " << k;
+        c = a;
+        c /= k;
+        EXPECT_EQ(c, a / BigInt(std::to_string(k))) << a << " / " << k;
+        c = a;
+        c %= k;
+        EXPECT_EQ(c, a % BigInt(std::to_string(k))) << a << " % " << k;
+    }
+}
+
+TEST(BigIntInPlace, SignChangesAndEdgeCases) {
+    BigInt a("5");
+    a -= BigInt("18446744073709551621");
+    EXPECT_EQ(a.toString(), "-18446744073709551616");
+    a += BigInt("18446744073709551616");
+    EXPECT_EQ(a.toString(), "0");
+    a -= 7;
+    EXPECT_EQ(a.toString(), "-7");
+    a *= 0;
+    EXPECT_EQ(a.toString(), "0");
+    EXPECT_FALSE(a < BigInt("0"));
+
+    BigInt m("-1");
+    m *= INT32_MIN;
+    EXPECT_EQ(m.toString(), "2147483648");
+    m -= INT32_MIN;
+    EXPECT_EQ(m.toString(), "4294967296");
+    m /= INT32_MIN;
+    EXPECT_EQ(m.toString(), "-2");
+    EXPECT_THROW(m /= 0, std::domain_error);
+    EXPECT_THROW(m %= BigInt("0"), std::domain_error);
+
+    // the right-hand side is the object itself
+    BigInt x("4294967295");
+    x += x;
+    EXPECT_EQ(x.toString(), "8589934590");
+    x *= x;
+    EXPECT_EQ(x.toString(), "73786976260478468100");
+    x -= x;
+    EXPECT_EQ(x.toString(), "0");
+}
+
+TEST(BigIntInPlace, AccumulationReusesStorage) {
+    // growth across many limbs, then shrinking back below the capacity
+    BigInt sum;
+    BigInt step("79228162514264337593543950336"); // 2^96
+    for (int i = 0; i < 1000; ++i) sum += step;
+    EXPECT_EQ(sum, step * 1000);
+    for (int i = 0; i < 1000; ++i) sum -= step;
+    EXPECT_EQ(sum.toString(), "0");
+
+    BigInt factorial("1");
+    for (int32_t i = 2; i <= 30; ++i) factorial *= i;
+    EXPECT_EQ(factorial.toString(), "265252859812191058636308480000000");
+    BigInt copy("1");
+    copy = factorial; // fits the existing storage after a reserve
+    EXPECT_EQ(copy, factorial);
+}
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+#include "../include/BigInt.hpp"
+
+#include <random>
+
+TEST(BigIntLimbs, StringRoundTrip) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> digit(0, 9);
+    for (size_t n = 1; n < 120; ++n) {
+        std::string s(n, '0');
+        for (char& c : s) c = char('0' + digit(rng));
+        s[0] = char('1' + digit(rng) % 9);
+        EXPECT_EQ(BigInt(s).toString(), s);
+        EXPECT_EQ(BigInt("-" + s).toString(), "-" + s);
+    }
+    EXPECT_EQ(BigInt("  -000123 ").toString(), "-123");
+    EXPECT_EQ(BigInt("-0").toString(), "0");
+    EXPECT_EQ(BigInt("1000000000").toString(), "1000000000");
+    EXPECT_EQ(BigInt("1000000000000000000").toString(), "1000000000000000000");
+    EXPECT_EQ((-BigInt("0")).toString(), "0");
+    EXPECT_THROW(BigInt("12a3"), std::invalid_argument);
+    EXPECT_THROW(BigInt("-"), std::invalid_argument);
+}
+
+TEST(BigIntLimbs, CarriesAcrossLimbs) {
+    BigInt limbMax("4294967295");   // 2^32 - 1
+    BigInt twoTo64("18446744073709551616");
+    EXPECT_EQ((limbMax + 1).toString(), "4294967296");
+    EXPECT_EQ((twoTo64 - 1).toString(), "18446744073709551615");
+    EXPECT_EQ((twoTo64 - twoTo64).toString(), "0");
+    EXPECT_EQ((limbMax * limbMax).toString(), "18446744065119617025");
+    EXPECT_EQ((twoTo64 * -2147483647 - 5).toString(), "-39614081238685424723062423557");
+    EXPECT_EQ((BigInt("-5") + 2147483647).toString(), "2147483642");
+    EXPECT_TRUE(BigInt("4294967296") > limbMax);
+    EXPECT_TRUE(BigInt("-4294967296") < -limbMax);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "../include/BigInt.hpp"
+
+#include <random>
+
+namespace
+{
+    std::string randomDigits(size_t n, std::mt19937& rng) {
+        std::uniform_int_distribution<int> digit(0, 9);
+        std::string s(n, '0');
+        for (char& c : s) c = char('0' + digit(rng));
+        s[0] = char('1' + digit(rng) % 9);
+        return s;
+    }
+
+    // Restores the default cutoffs when a test ends.
+    struct MulOptionsGuard {
+        BigIntMulOptions saved = bigIntMulOptions();
+        ~MulOptionsGuard() { bigIntMulOptions() = saved; }
+    };
+
+    BigInt schoolbook(const BigInt& a, const BigInt& b) {
+        MulOptionsGuard guard;
+        bigIntMulOptions().karatsubaThreshold = size_t(-1);
+        bigIntMulOptions().toom3Threshold = size_t(-1);
+        bigIntMulOptions().nttThreshold = size_t(-1);
+        return a * b;
+    }
+}
+
+TEST(BigIntMul, KnownProduct) {
+    MulOptionsGuard guard;
+    bigIntMulOptions().karatsubaThreshold = 2;
+    bigIntMulOptions().toom3Threshold = 3;
+    BigInt a("123456789012345678901234567890");
+    BigInt b("-987654321098765432109876543210");
+    EXPECT_EQ((a * b).toString(), "-121932631137021795226185032733622923332237463801111263526900");
+    EXPECT_EQ((a * BigInt("0")).toString(), "0");
+    EXPECT_EQ((BigInt("-0") * b).toString(), "0");
+}
+
+TEST(BigIntMul, AlgorithmsAgreeWithSchoolbook) {
+    std::mt19937 rng(42);
+    MulOptionsGuard guard;
+    // small cutoffs so that short operands go through deep recursions
+    bigIntMulOptions().karatsubaThreshold = 4;
+    bigIntMulOptions().toom3Threshold = 9;
+
+    const std::pair<size_t, size_t> sizes[] = {
+        {1, 1}, {5, 5}, {17, 16}, {33, 12}, {100, 100}, {301, 299}, {250, 170},
+        {1000, 999}, {1024, 7}, {2000, 1400}, {777, 1500},
+    };
+    for (auto [na, nb] : sizes) {
+        BigInt a(randomDigits(na, rng));
+        BigInt b(randomDigits(nb, rng));
+        BigInt expected = schoolbook(a, b);
+        EXPECT_EQ(a * b, expected) << na << " x " << nb;
+        EXPECT_EQ(-a * b, -expected) << na << " x " << nb;
+    }
+
+    // carries through long runs of 9s, zero limbs in the middle
+    BigInt nines(std::string(500, '9'));
+    BigInt sparse("1" + std::string(400, '0') + "1");
+    EXPECT_EQ(nines * nines, schoolbook(nines, nines));
+    EXPECT_EQ(sparse * nines, schoolbook(sparse, nines));
+}
+
+TEST(BigIntMul, NttAgreesWithSchoolbook) {
+    std::mt19937 rng(7);
+    MulOptionsGuard guard;
+    bigIntMulOptions().nttThreshold = 1;
+
+    const std::pair<size_t, size_t> sizes[] = {
+        {1, 1}, {10, 10}, {19, 1}, {100, 37}, {300, 300}, {1000, 999}, {5000, 20}, {4000, 6000},
+    };
+    for (auto [na, nb] : sizes) {
+        BigInt a(randomDigits(na, rng));
+        BigInt b(randomDigits(nb, rng));
+        BigInt expected = schoolbook(a, b);
+        EXPECT_EQ(a * b, expected) << na << " x " << nb;
+        EXPECT_EQ(a * -b, -expected) << na << " x " << nb;
+        EXPECT_EQ(a * a, schoolbook(a, a)) << na;
+    }
+}
+
+TEST(BigIntMul, NttLargestCoefficients) {
+    MulOptionsGuard guard;
+    // 2^(32 * 2048) - 1: every limb is 0xFFFFFFFF, so each convolution
+    // coefficient is as large as the length allows
+    BigInt ones("4294967296");
+    for (int i = 0; i < 11; ++i) ones = ones * ones;
+    ones = ones - 1;
+    BigInt expected = schoolbook(ones, ones);
+
+    bigIntMulOptions().nttThreshold = 1;
+    EXPECT_EQ(ones * ones, expected);
+    BigInt copy = ones;
+    EXPECT_EQ(ones * copy, expected);
+}
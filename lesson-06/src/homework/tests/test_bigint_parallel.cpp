@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "../include/BigIntBatch.hpp"
+
+#include <random>
+
+namespace
+{
+    std::string randomNumber(size_t n, std::mt19937& rng) {
+        std::uniform_int_distribution<int> digit(0, 9);
+        std::string s(n, '0');
+        for (char& c : s) c = char('0' + digit(rng));
+        s[0] = char('1' + digit(rng) % 9);
+        return rng() % 2 ? "-" + s : s;
+    }
+
+    struct MulOptionsGuard {
+        BigIntMulOptions saved = bigIntMulOptions();
+        ~MulOptionsGuard() { bigIntMulOptions() = saved; }
+    };
+
+    BigInt serial(const BigInt& a, const BigInt& b) {
+        MulOptionsGuard guard;
+        bigIntMulOptions().parallelThreshold = 0;
+        return a * b;
+    }
+}
+
+TEST(BigIntParallel, MultiplyMatchesSerial) {
+    std::mt19937 rng(3);
+    ThreadPool pool(4); // more threads than cores is fine for correctness
+    MulOptionsGuard guard;
+    bigIntMulOptions().pool = &pool;
+    // small cutoffs so that every algorithm splits, recursively
+    bigIntMulOptions().karatsubaThreshold = 8;
+    bigIntMulOptions().toom3Threshold = 30;
+    bigIntMulOptions().nttThreshold = 600;
+    bigIntMulOptions().parallelThreshold = 10;
+
+    const std::pair<size_t, size_t> sizes[] = {
+        {200, 200}, {1000, 90}, {700, 400}, {3000, 3000}, {9000, 8000}, {20000, 3000},
+    };
+    for (auto [na, nb] : sizes) {
+        const BigInt a(randomNumber(na, rng));
+        const BigInt b(randomNumber(nb, rng));
+        EXPECT_EQ(a * b, serial(a, b)) << na << " x " << nb;
+        EXPECT_EQ(a * a, serial(a, a)) << na;
+    }
+}
+
+TEST(BigIntParallel, BatchOperations) {
+    std::mt19937 rng(4);
+    ThreadPool pool(3);
+    constexpr size_t N = 100;
+    BigInt* a = new BigInt[N];
+    BigInt* b = new BigInt[N];
+    BigInt* out = new BigInt[N];
+    for (size_t i = 0; i < N; ++i) {
+        a[i] = BigInt(randomNumber(1 + rng() % 200, rng));
+        b[i] = BigInt(randomNumber(1 + rng() % 100, rng));
+    }
+
+    BigIntBatch::add(a, b, out, N, pool);
+    for (size_t i = 0; i < N; ++i) EXPECT_EQ(out[i], a[i] + b[i]) << i;
+    BigIntBatch::subtract(a, b, out, N, pool);
+    for (size_t i = 0; i < N; ++i) EXPECT_EQ(out[i], a[i] - b[i]) << i;
+    BigIntBatch::multiply(a, b, out, N, pool);
+    for (size_t i = 0; i < N; ++i) EXPECT_EQ(out[i], a[i] * b[i]) << i;
+    BigIntBatch::divide(a, b, out, N, pool);
+    for (size_t i = 0; i < N; ++i) EXPECT_EQ(out[i], a[i] / b[i]) << i;
+    BigIntBatch::modulo(a, b, out, N, pool);
+    for (size_t i = 0; i < N; ++i) EXPECT_EQ(out[i], a[i] % b[i]) << i;
+
+    const BigInt modulus("1000000000000000000000000000057");
+    for (size_t i = 0; i < N; ++i) b[i] = BigInt(std::to_string(i * i));
+    BigIntBatch::powmod(a, b, modulus, out, N, pool);
+    for (size_t i = 0; i < N; ++i) EXPECT_EQ(out[i], powmod(a[i], b[i], modulus)) << i;
+
+    // in place, and a custom operation
+    BigIntBatch::apply(a, a, a, N, [](const BigInt& x, const BigInt& y) { return x - y; }, pool);
+    for (size_t i = 0; i < N; ++i) EXPECT_EQ(a[i].toString(), "0") << i;
+
+    b[N / 2] = BigInt();
+    EXPECT_THROW(BigIntBatch::divide(out, b, out, N, pool), std::domain_error);
+
+    delete[] out;
+    delete[] b;
+    delete[] a;
+}
+
+TEST(BigIntParallel, BatchErrorsLeaveOtherElementsWritten) {
+    ThreadPool pool(3);
+    // 100 elements are split over several tasks, 5 run inline in one chunk
+    for (size_t n : {size_t(100), size_t(5)}) {
+        BigInt* a = new BigInt[n];
+        BigInt* b = new BigInt[n];
+        BigInt* out = new BigInt[n];
+        for (size_t i = 0; i < n; ++i) {
+            a[i] = BigInt(std::to_string(1000 + i));
+            b[i] = BigInt(std::to_string(i % 7 + 1));
+            out[i] = BigInt("-1");
+        }
+        // zeros in the first chunk (inline on the caller) and in later ones
+        const size_t zeros[] = {1, n / 2, n - 1};
+        for (size_t z : zeros) b[z] = BigInt();
+
+        EXPECT_THROW(BigIntBatch::divide(a, b, out, n, pool), std::domain_error) << n;
+        for (size_t i = 0; i < n; ++i) {
+            if (i == zeros[0] || i == zeros[1] || i == zeros[2])
+                EXPECT_EQ(out[i], BigInt("-1")) << n << " " << i;
+            else
+                EXPECT_EQ(out[i], a[i] / b[i]) << n << " " << i;
+        }
+
+        // the lowest failing index is the one reported
+        try {
+            BigIntBatch::apply(a, b, out, n, [](const BigInt& x, const BigInt& y) -> BigInt {
+                if (y == BigInt()) throw std::runtime_error(x.toString());
+                return x;
+            }, pool);
+            ADD_FAILURE() << "no exception";
+        } catch (const std::runtime_error& e) {
+            EXPECT_STREQ(e.what(), "1001");
+        }
+
+        delete[] out;
+        delete[] b;
+        delete[] a;
+    }
+}
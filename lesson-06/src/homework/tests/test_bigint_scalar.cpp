@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "../include/BigInt.hpp"
+
+#include <limits>
+#include <random>
+
+namespace
+{
+    std::string randomNumber(size_t n, std::mt19937& rng) {
+        std::uniform_int_distribution<int> digit(0, 9);
+        std::string s(n, '0');
+        for (char& c : s) c = char('0' + digit(rng));
+        s[0] = char('1' + digit(rng) % 9);
+        return rng() % 2 ? "-" + s : s;
+    }
+
+    // a op k for every scalar overload against the BigInt operator
+    template <class T>
+    void checkScalar(const BigInt& a, T k) {
+        const BigInt b(std::to_string(k));
+        EXPECT_EQ(a + k, a + b) << a << " + " << k;
+        EXPECT_EQ(a - k, a - b) << a << " - " << k;
+        EXPECT_EQ(a * k, a * b) << a << " * " << k;
+        BigInt c = a;
+        c += k;
+        EXPECT_EQ(c, a + b) << a << " += " << k;
+        c = a;
+        c -= k;
+        EXPECT_EQ(c, a - b) << a << " -= " << k;
+        c = a;
+        c *= k;
+        EXPECT_EQ(c, a * b) << a << " *= " << k;
+        if (k == 0) return;
+        EXPECT_EQ(a / k, a / b) << a << " / " << k;
+        EXPECT_EQ(a % k, a % b) << a << " % " << k;
+        c = a;
+        c /= k;
+        EXPECT_EQ(c, a / b) << a << " /= " << k;
+        c = a;
+        c %= k;
+        EXPECT_EQ(c, a % b) << a << " %= " << k;
+    }
+}
+
+TEST(BigIntScalar, MatchesBigIntOperators) {
+    std::mt19937 rng(8);
+    std::mt19937_64 rng64(8);
+    for (int i = 0; i < 300; ++i) {
+        const BigInt a(randomNumber(1 + rng() % 60, rng));
+        checkScalar(a, int32_t(rng()));
+        checkScalar(a, int64_t(rng64()));
+        checkScalar(a, int64_t(rng64()) >> (rng() % 64));
+        checkScalar(a, uint64_t(rng64()));
+        checkScalar(a, uint64_t(rng64()) >> (rng() % 64));
+    }
+}
+
+TEST(BigIntScalar, Limits) {
+    const BigInt values[] = {BigInt(), BigInt("1"), BigInt("-1"), BigInt("4294967295"),
+                             BigInt("-4294967296"), BigInt("18446744073709551615"),
+                             BigInt("-18446744073709551616"), BigInt("340282366920938463463374607431768211455")};
+    for (const BigInt& a : values) {
+        checkScalar(a, std::numeric_limits<int32_t>::min());
+        checkScalar(a, std::numeric_limits<int32_t>::max());
+        checkScalar(a, std::numeric_limits<int64_t>::min());
+        checkScalar(a, std::numeric_limits<int64_t>::max());
+        checkScalar(a, std::numeric_limits<uint64_t>::max());
+        checkScalar(a, uint64_t(1) << 32);
+        checkScalar(a, int64_t(0));
+    }
+    EXPECT_THROW(BigInt("5") / int64_t(0), std::domain_error);
+    EXPECT_THROW(BigInt("5") % uint64_t(0), std::domain_error);
+}
+
+TEST(BigIntScalar, Counter) {
+    BigInt counter("4294967290");
+    for (int i = 0; i < 10; ++i) counter += 1;
+    EXPECT_EQ(counter.toString(), "4294967300");
+    for (int i = 0; i < 10; ++i) counter -= uint64_t(1);
+    EXPECT_EQ(counter.toString(), "4294967290");
+
+    BigInt down("3");
+    for (int i = 0; i < 6; ++i) down -= int64_t(1);
+    EXPECT_EQ(down.toString(), "-3");
+    for (int i = 0; i < 3; ++i) down += 1;
+    EXPECT_EQ(down.toString(), "0");
+    EXPECT_EQ((down - 0).toString(), "0");
+}
+
+TEST(BigIntScalar, OtherIntegerTypes) {
+    // unsigned, long long, short, ... all pick the template, without
+    // ambiguity, signed ones through int64_t and unsigned through uint64_t
+    const BigInt a("-123456789012345678901234567890");
+    checkScalar(a, 3u);
+    checkScalar(a, std::numeric_limits<unsigned>::max());
+    checkScalar(a, 1LL);
+    checkScalar(a, std::numeric_limits<long long>::min());
+    checkScalar(a, 10ULL);
+    checkScalar(a, short(-7));
+    checkScalar(a, std::numeric_limits<short>::min());
+    checkScalar(a, static_cast<unsigned short>(65535));
+    checkScalar(a, static_cast<signed char>(-128));
+    checkScalar(a, 'A');
+    EXPECT_EQ((BigInt("5") + 3u).toString(), "8");
+    EXPECT_EQ((BigInt("5") * 1LL).toString(), "5");
+    BigInt c("10");
+    c -= short(-2);
+    c *= 4u;
+    EXPECT_EQ(c.toString(), "48");
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include "../include/BigInt.hpp"
+
+#include <utility>
+
+TEST(BigIntSmall, FastPathBoundaries) {
+    const BigInt two64("18446744073709551616");
+    const BigInt two96("79228162514264337593543950336");
+    const BigInt two128("340282366920938463463374607431768211456");
+    const BigInt max96 = two96 - 1;
+
+    // sums that stay in 96 bits, reach 97 bits, or change sign
+    EXPECT_EQ((max96 + max96).toString(), "158456325028528675187087900670");
+    EXPECT_EQ((max96 + 1).toString(), "79228162514264337593543950336");
+    EXPECT_EQ((-max96 - max96).toString(), "-158456325028528675187087900670");
+    EXPECT_EQ((two64 - max96).toString(), "-79228162495817593519834398719");
+    EXPECT_EQ((max96 - max96).toString(), "0");
+    EXPECT_FALSE(max96 - max96 < BigInt("0"));
+
+    // products of up to four limbs, and just past them
+    EXPECT_EQ(((two64 - 1) * (two64 - 1)).toString(), "340282366920938463426481119284349108225");
+    EXPECT_EQ((two64 * two64).toString(), two128.toString());
+    EXPECT_EQ((max96 * BigInt("4294967295")).toString(), "340282366841710300949110269833929293825");
+    EXPECT_EQ((two96 * two64).toString(), "1461501637330902918203684832716283019655932542976");
+    EXPECT_EQ((BigInt("-3") * BigInt("0")).toString(), "0");
+    EXPECT_EQ((BigInt("-3") * BigInt("-5")).toString(), "15");
+
+    // operands of more than three limbs leave the fast path
+    EXPECT_EQ((two128 - 1 + 1).toString(), two128.toString());
+    EXPECT_EQ((two128 + two128 - two128 * 2).toString(), "0");
+}
+
+TEST(BigIntSmall, CopyAndMoveAcrossStorage) {
+    const BigInt small("123456789");
+    const BigInt big("123456789012345678901234567890123456789012345678901234567890");
+
+    BigInt a = small;
+    BigInt b = big;
+    a = big;   // inline -> heap
+    EXPECT_EQ(a, big);
+    b = small; // keeps the heap buffer
+    EXPECT_EQ(b, small);
+
+    BigInt moved(std::move(a));
+    EXPECT_EQ(moved, big);
+    EXPECT_EQ(a.toString(), "0"); // a moved-from BigInt is zero and usable
+    a += 5;
+    EXPECT_EQ(a.toString(), "5");
+
+    BigInt c(small);
+    BigInt d(std::move(c));
+    EXPECT_EQ(d, small);
+    EXPECT_EQ(c.toString(), "0");
+    c = std::move(d);
+    EXPECT_EQ(c, small);
+    moved = std::move(c); // inline into heap storage
+    EXPECT_EQ(moved, small);
+    BigInt& self = moved;
+    moved = std::move(self);
+    EXPECT_EQ(moved, small);
+
+    // growing an inline value onto the heap and back
+    BigInt e("1");
+    for (int i = 0; i < 10; ++i) e *= 1000000007;
+    for (int i = 0; i < 10; ++i) e /= 1000000007;
+    EXPECT_EQ(e.toString(), "1");
+}
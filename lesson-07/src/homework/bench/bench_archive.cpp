@@ -0,0 +1,58 @@
+// Serializing and deserializing one million Data messages through a
+// std::stringstream with the text archive and the two binary ones. Half
+// the numbers are small (< 1000), half are random 64-bit values.
+
+#include "../include/Serializer.hpp"
+#include "../include/Deserializer.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+    constexpr size_t Messages = 1000000;
+
+    template <class Format>
+    void run(const char* name, const std::vector<Data>& input)
+    {
+        std::string archive;
+        const double save = timeIt([&] {
+            std::stringstream s;
+            BasicSerializer<Format> ser(s);
+            for (Data x : input)
+                ser.save(x);
+            archive = s.str();
+        });
+        std::vector<Data> output(input.size());
+        const double load = timeIt([&] {
+            std::stringstream s(archive);
+            BasicDeserializer<Format> d(s);
+            for (Data& y : output)
+                d.load(y);
+        });
+        if (output.back().c != input.back().c)
+            std::printf("mismatch\n");
+        std::printf("%-8s %10.1f %10.1f %12.1f\n", name, save * 1e9 / Messages, load * 1e9 / Messages,
+                    double(archive.size()) / Messages);
+        std::fflush(stdout);
+    }
+}
+
+int main()
+{
+    std::mt19937_64 rng(1);
+    std::vector<Data> input(Messages);
+    for (Data& x : input) {
+        x.a = rng() % 1000;
+        x.b = rng() % 2;
+        x.c = rng();
+    }
+    std::printf("%-8s %10s %10s %12s\n", "format", "save ns", "load ns", "bytes/msg");
+    run<TextFormat>("text", input);
+    run<FixedBinaryFormat>("fixed", input);
+    run<VarintBinaryFormat>("varint", input);
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Throughput, in millions of Data messages per second, of the byte buffer
+// backends against the std::stringstream one for each archive format. The
+// "fields" rows go through operator() instead of save() / load(), which
+// checks the buffer bounds at every field instead of once per message.
+
+#include "../include/Serializer.hpp"
+#include "../include/Deserializer.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+    constexpr size_t Messages = 1000000;
+
+    void report(const char* format, const char* backend, double save, double load)
+    {
+        std::printf("%-8s %-8s %12.1f %12.1f\n", format, backend, Messages / save / 1e6, Messages / load / 1e6);
+        std::fflush(stdout);
+    }
+
+    template <class Format>
+    void run(const char* name, const std::vector<Data>& input)
+    {
+        std::vector<Data> output(input.size());
+        std::string archive;
+
+        const double streamSave = timeIt([&] {
+            std::stringstream s;
+            BasicSerializer<Format> ser(s);
+            for (Data x : input)
+                ser.save(x);
+            archive = s.str();
+        });
+        const double streamLoad = timeIt([&] {
+            std::stringstream s(archive);
+            BasicDeserializer<Format> d(s);
+            for (Data& y : output)
+                d.load(y);
+        });
+        report(name, "stream", streamSave, streamLoad);
+
+        std::vector<uint8_t> buf(archive.size());
+        const double bufferSave = timeIt([&] {
+            BufferSerializer<Format> ser({buf.data(), buf.size()});
+            for (Data x : input)
+                ser.save(x);
+        });
+        const double bufferLoad = timeIt([&] {
+            BufferDeserializer<Format> d({buf.data(), buf.size()});
+            for (Data& y : output)
+                d.load(y);
+        });
+        report(name, "buffer", bufferSave, bufferLoad);
+
+        const double fieldsSave = timeIt([&] {
+            BufferSerializer<Format> ser({buf.data(), buf.size()});
+            for (const Data& x : input)
+                ser(x.a, x.b, x.c);
+        });
+        const double fieldsLoad = timeIt([&] {
+            BufferDeserializer<Format> d({buf.data(), buf.size()});
+            for (Data& y : output)
+                d(y.a, y.b, y.c);
+        });
+        report(name, "fields", fieldsSave, fieldsLoad);
+
+        if (std::string(buf.begin(), buf.end()) != archive || output.back().c != input.back().c)
+            std::printf("mismatch\n");
+    }
+}
+
+int main()
+{
+    std::mt19937_64 rng(1);
+    std::vector<Data> input(Messages);
+    for (Data& x : input) {
+        x.a = rng() % 1000;
+        x.b = rng() % 2;
+        x.c = rng();
+    }
+    std::printf("%-8s %-8s %12s %12s\n", "format", "backend", "save M/s", "load M/s");
+    run<TextFormat>("text", input);
+    run<FixedBinaryFormat>("fixed", input);
+    run<VarintBinaryFormat>("varint", input);
+    return 0;
+}
@@ -0,0 +1,104 @@
+// Messages with containers through the byte buffer backend, varint
+// binary format:
+//  - a vector of 1000 uint64_t written and read as one array (memcpy)
+//    against the same values as 1000 single fields;
+//  - a message with strings, a vector of strings and a map loaded into a
+//    fresh object each time against the same object, reusing its storage.
+
+#include "../include/Serializer.hpp"
+#include "../include/Deserializer.hpp"
+#include "bench_utils.hpp"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr size_t Elements = 1000;
+    constexpr size_t Rounds = 10000;
+
+    // the same values as separate fields
+    struct Elementwise
+    {
+        std::vector<uint64_t>& values;
+
+        template <class SerializerT>
+        Error serialize(SerializerT& serializer)
+        {
+            uint64_t size = values.size();
+            Error err = serializer(size);
+            values.resize(size_t(size));
+            for (size_t i = 0; i < values.size() && err == Error::NoError; ++i)
+                err = serializer(values[i]);
+            return err;
+        }
+    };
+
+    struct Record
+    {
+        std::string name;
+        std::vector<std::string> tags;
+        std::map<std::string, uint64_t> counters;
+
+        template <class SerializerT>
+        Error serialize(SerializerT& serializer)
+        {
+            return serializer(name, tags, counters);
+        }
+    };
+
+    using Format = VarintBinaryFormat;
+}
+
+int main()
+{
+    std::mt19937_64 rng(1);
+    std::vector<uint64_t> ids(Elements);
+    for (uint64_t& v : ids)
+        v = rng();
+    std::vector<uint8_t> buf(Elements * 16 + 64);
+
+    std::vector<uint64_t> out(Elements);
+    Elementwise in{ids}, back{out};
+    const double arraySave = timeIt([&] {
+        for (size_t r = 0; r < Rounds; ++r)
+            BufferSerializer<Format>({buf.data(), buf.size()})(ids);
+    });
+    const double arrayLoad = timeIt([&] {
+        for (size_t r = 0; r < Rounds; ++r)
+            BufferDeserializer<Format>({buf.data(), buf.size()})(out);
+    });
+    const double fieldSave = timeIt([&] {
+        for (size_t r = 0; r < Rounds; ++r)
+            BufferSerializer<Format>({buf.data(), buf.size()}).save(in);
+    });
+    const double fieldLoad = timeIt([&] {
+        for (size_t r = 0; r < Rounds; ++r)
+            BufferDeserializer<Format>({buf.data(), buf.size()}).load(back);
+    });
+    std::printf("%u x uint64_t    save ns    load ns\n", unsigned(Elements));
+    std::printf("array       %10.0f %10.0f\n", arraySave * 1e9 / Rounds, arrayLoad * 1e9 / Rounds);
+    std::printf("elementwise %10.0f %10.0f\n", fieldSave * 1e9 / Rounds, fieldLoad * 1e9 / Rounds);
+
+    Record record;
+    record.name = std::string(40, 'n');
+    for (int i = 0; i < 20; ++i) {
+        record.tags.push_back("tag number " + std::to_string(i) + std::string(20, 't'));
+        record.counters["counter number " + std::to_string(i) + std::string(20, 'c')] = rng();
+    }
+    BufferSerializer<Format>({buf.data(), buf.size()}).save(record);
+    const double fresh = timeIt([&] {
+        for (size_t r = 0; r < Rounds; ++r) {
+            Record y;
+            BufferDeserializer<Format>({buf.data(), buf.size()}).load(y);
+        }
+    });
+    Record reused;
+    const double reuse = timeIt([&] {
+        for (size_t r = 0; r < Rounds; ++r)
+            BufferDeserializer<Format>({buf.data(), buf.size()}).load(reused);
+    });
+    std::printf("record load ns: fresh %.0f, reused %.0f\n", fresh * 1e9 / Rounds, reuse * 1e9 / Rounds);
+    return 0;
+}
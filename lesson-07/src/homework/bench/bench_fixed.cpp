@@ -0,0 +1,133 @@
+// Messages of 4, 16 and 64 fields (half uint64_t, a quarter uint32_t, a
+// quarter bool) written and read in one piece, against the variadic
+// process() recursion, one checked field at a time with an error check
+// after each. Fixed and varint binary formats, buffer and stream backends.
+
+#include "../include/Serializer.hpp"
+#include "../include/Deserializer.hpp"
+#include "bench_utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr size_t Messages = 100000;
+
+    template <class T, size_t N>
+    auto tie(std::array<T, N>& values)
+    {
+        return std::apply([](auto&... v) { return std::tie(v...); }, values);
+    }
+
+    template <size_t N>
+    struct Wide
+    {
+        std::array<uint64_t, N / 2> ints;
+        std::array<uint32_t, N / 4> small;
+        std::array<bool, N / 4> flags;
+
+        auto fields() { return std::tuple_cat(tie(ints), tie(small), tie(flags)); }
+
+        template <class SerializerT>
+        Error serialize(SerializerT& serializer)
+        {
+            return std::apply([&](auto&... f) { return serializer(f...); }, fields());
+        }
+    };
+
+    template <class Archive, class = void>
+    struct HasProcess : std::false_type {};
+
+    template <class Archive>
+    struct HasProcess<Archive, std::void_t<decltype(std::declval<Archive&>().process())>> : std::true_type {};
+
+    template <size_t N>
+    struct PerField
+    {
+        Wide<N>* w;
+
+        // process() directly: operator() would send these all-fixed-size
+        // fields, even one at a time, to processFixed(). SizeBound, which
+        // only measures, has no process().
+        template <class SerializerT>
+        Error serialize(SerializerT& serializer)
+        {
+            return std::apply([&](auto&... f) {
+                if constexpr (HasProcess<SerializerT>::value)
+                    return serializer.process(f...);
+                else
+                    return serializer(f...);
+            }, w->fields());
+        }
+    };
+
+    template <class Format, class Message, class Writer, class Reader>
+    void run(const char* name, std::vector<Message>& input, std::vector<Message>& output,
+             Writer makeWriter, Reader makeReader)
+    {
+        const double save = timeIt([&] {
+            auto ser = makeWriter();
+            for (Message& x : input)
+                ser.save(x);
+        });
+        const double load = timeIt([&] {
+            auto d = makeReader();
+            for (Message& y : output)
+                d.load(y);
+        });
+        std::printf("  %-22s %10.1f %10.1f\n", name, save * 1e9 / Messages, load * 1e9 / Messages);
+        std::fflush(stdout);
+    }
+
+    template <class Format, size_t N>
+    void runFormat(const char* format, std::vector<uint8_t>& buf)
+    {
+        std::mt19937_64 rng(N);
+        std::vector<Wide<N>> input(Messages), output(Messages);
+        for (Wide<N>& x : input) {
+            for (uint64_t& v : x.ints) v = rng() >> (rng() % 64);
+            for (uint32_t& v : x.small) v = uint32_t(rng());
+            for (bool& v : x.flags) v = rng() % 2;
+        }
+        std::vector<PerField<N>> inputPerField(Messages), outputPerField(Messages);
+        for (size_t i = 0; i < Messages; ++i) {
+            inputPerField[i].w = &input[i];
+            outputPerField[i].w = &output[i];
+        }
+        std::printf("%s, %u fields%21s %10s\n", format, unsigned(N), "save ns", "load ns");
+
+        auto bufWriter = [&] { return BufferSerializer<Format>({buf.data(), buf.size()}); };
+        auto bufReader = [&] { return BufferDeserializer<Format>({buf.data(), buf.size()}); };
+        run<Format>("buffer, one piece", input, output, bufWriter, bufReader);
+        run<Format>("buffer, recursion", inputPerField, outputPerField, bufWriter, bufReader);
+
+        std::stringstream s;
+        auto streamWriter = [&] { s.str(""); s.clear(); return BasicSerializer<Format>(s); };
+        auto streamReader = [&] { s.clear(); s.seekg(0); return BasicDeserializer<Format>(s); };
+        run<Format>("stream, one piece", input, output, streamWriter, streamReader);
+        run<Format>("stream, recursion", inputPerField, outputPerField, streamWriter, streamReader);
+
+        if (!std::equal(input.back().ints.begin(), input.back().ints.end(), output.back().ints.begin()))
+            std::printf("mismatch\n");
+    }
+}
+
+int main()
+{
+    std::vector<uint8_t> buf(Messages * 64 * 10);
+    runFormat<FixedBinaryFormat, 4>("fixed", buf);
+    runFormat<FixedBinaryFormat, 16>("fixed", buf);
+    runFormat<FixedBinaryFormat, 64>("fixed", buf);
+    runFormat<VarintBinaryFormat, 4>("varint", buf);
+    runFormat<VarintBinaryFormat, 16>("varint", buf);
+    runFormat<VarintBinaryFormat, 64>("varint", buf);
+    return 0;
+}
@@ -0,0 +1,22 @@
+#ifndef BENCH_UTILS_HPP
+#define BENCH_UTILS_HPP
+
+#include <algorithm>
+#include <chrono>
+
+// Timing helpers shared by the benchmarks in this directory.
+
+// best of three runs of f, in seconds
+template <class F>
+double timeIt(F&& f)
+{
+    double best = 1e300;
+    for (int r = 0; r < 3; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+#endif // BENCH_UTILS_HPP
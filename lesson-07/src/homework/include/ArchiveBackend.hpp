@@ -0,0 +1,294 @@
+#ifndef ARCHIVE_BACKEND_HPP
+#define ARCHIVE_BACKEND_HPP
+
+#include "ArchiveFormat.hpp"
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#pragma once
+
+// Where an archive's bytes go to and come from. The formats of
+// ArchiveFormat.hpp use a writer as
+//     void put(char c);
+//     void write(const char* data, size_t size);
+// and a reader as
+//     int get();                              // next byte, -1 at the end
+//     bool read(char* data, size_t size);     // false when truncated
+//     bool token(const char*& first, size_t& size); // next word (text format)
+
+// std::ostream / std::istream, the original backend
+class StreamWriter
+{
+    private:
+        std::ostream& out_;
+
+    public:
+        StreamWriter(std::ostream& out) : out_(out) {}
+
+        void put(char c) { out_.put(c); }
+        void write(const char* data, size_t size) { out_.write(data, std::streamsize(size)); }
+};
+
+class StreamReader
+{
+    private:
+        std::istream& in_;
+        std::string token_;
+
+    public:
+        StreamReader(std::istream& in) : in_(in) {}
+
+        int get()
+        {
+            const auto c = in_.get();
+            return c == std::istream::traits_type::eof() ? -1 : int(c);
+        }
+
+        bool read(char* data, size_t size)
+        {
+            return bool(in_.read(data, std::streamsize(size)));
+        }
+
+        bool token(const char*& first, size_t& size)
+        {
+            in_ >> token_;
+            first = token_.data();
+            size = token_.size();
+            return size != 0;
+        }
+};
+
+// Contiguous memory [data, data + size). The serializer checks once per
+// message that the message fits (see SizeBound) and then writes through
+// an UncheckedBufferWriter; the checked put / write here only run for a
+// message whose upper bound exceeds the space left, and report an overflow
+// instead of writing past the end.
+class BufferWriter
+{
+    private:
+        uint8_t* pos_;
+        uint8_t* end_;
+        bool overflow_ = false;
+
+    public:
+        BufferWriter(void* data, size_t size)
+            : pos_(static_cast<uint8_t*>(data)), end_(pos_ + size) {}
+
+        void put(char c)
+        {
+            if (pos_ == end_)
+                overflow_ = true;
+            else
+                *pos_++ = uint8_t(c);
+        }
+
+        void write(const char* data, size_t size)
+        {
+            if (size_t(end_ - pos_) < size)
+                overflow_ = true;
+            else {
+                std::memcpy(pos_, data, size);
+                pos_ += size;
+            }
+        }
+
+        uint8_t* position() const { return pos_; }
+        void setPosition(uint8_t* pos) { pos_ = pos; }
+        size_t remaining() const { return size_t(end_ - pos_); }
+
+        // a put / write did not fit; cleared by the serializer per message
+        // and per operator() call
+        bool overflow() const { return overflow_; }
+        void setOverflow(bool overflow) { overflow_ = overflow; }
+        void clearOverflow() { overflow_ = false; }
+};
+
+class UncheckedBufferWriter
+{
+    private:
+        uint8_t* pos_;
+
+    public:
+        explicit UncheckedBufferWriter(uint8_t* pos) : pos_(pos) {}
+
+        void put(char c) { *pos_++ = uint8_t(c); }
+        void write(const char* data, size_t size)
+        {
+            std::memcpy(pos_, data, size);
+            pos_ += size;
+        }
+
+        uint8_t* position() const { return pos_; }
+};
+
+// Reads [data, data + size), with the same split: an UncheckedBufferReader
+// when the message's upper bound fits in what is left, checked get / read
+// otherwise (and always for formats without BoundedReads).
+class BufferReader
+{
+    private:
+        const uint8_t* pos_;
+        const uint8_t* end_;
+
+        // the C locale's whitespace, as std::isspace without the lookup
+        static bool isSpace(uint8_t c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+    public:
+        BufferReader(const void* data, size_t size)
+            : pos_(static_cast<const uint8_t*>(data)), end_(pos_ + size) {}
+
+        int get() { return pos_ != end_ ? *pos_++ : -1; }
+
+        bool read(char* data, size_t size)
+        {
+            if (size_t(end_ - pos_) < size)
+                return false;
+            std::memcpy(data, pos_, size);
+            pos_ += size;
+            return true;
+        }
+
+        // skips whitespace like operator>> and returns the word in place
+        bool token(const char*& first, size_t& size)
+        {
+            while (pos_ != end_ && isSpace(*pos_))
+                ++pos_;
+            const uint8_t* begin = pos_;
+            while (pos_ != end_ && !isSpace(*pos_))
+                ++pos_;
+            first = reinterpret_cast<const char*>(begin);
+            size = size_t(pos_ - begin);
+            return size != 0;
+        }
+
+        const uint8_t* position() const { return pos_; }
+        void setPosition(const uint8_t* pos) { pos_ = pos; }
+        size_t remaining() const { return size_t(end_ - pos_); }
+};
+
+class UncheckedBufferReader
+{
+    private:
+        const uint8_t* pos_;
+
+    public:
+        explicit UncheckedBufferReader(const uint8_t* pos) : pos_(pos) {}
+
+        int get() { return *pos_++; }
+        bool read(char* data, size_t size)
+        {
+            std::memcpy(data, pos_, size);
+            pos_ += size;
+            return true;
+        }
+
+        const uint8_t* position() const { return pos_; }
+};
+
+// Upper bound of the encoded size of a message in Format, obtained by
+// running its serialize() with this in place of an archive. Fixed-size
+// fields only contribute constants, so for them the whole pass folds to a
+// constant once inlined. Strings, containers and byte strings are measured
+// when writing (ForReading == false); before reading, their size is
+// unknown and the bound is infinite (bounded() == false).
+template <class Format, bool ForReading>
+class SizeBound
+{
+    private:
+        size_t size_ = 0;
+        bool bounded_ = true;
+
+        template <class T>
+        void add(const T& value)
+        {
+            if constexpr (std::is_same<T, bool>::value)
+                size_ += Format::MaxBoolSize;
+            else if constexpr (std::is_integral<T>::value)
+                size_ += Format::MaxIntSize;
+            else if constexpr (IsFloatField<T>::value)
+                size_ += Format::MaxFloatSize;
+            else if constexpr (IsByteEncodable<T>::value) {
+                if constexpr (ForReading)
+                    bounded_ = false;
+                else
+                    size_ += Format::bytesSize(value.encodedSize());
+            } else
+                const_cast<T&>(value).serialize(*this);
+        }
+
+        void add(const std::string& value)
+        {
+            if constexpr (ForReading)
+                bounded_ = false;
+            else
+                size_ += Format::stringSize(value.size());
+        }
+
+        // written only (see BasicSerializer::process(std::string_view))
+        void add(std::string_view value) { size_ += Format::stringSize(value.size()); }
+        void add(const char* value) { add(std::string_view(value)); }
+
+        template <class T, class A>
+        void add(const std::vector<T, A>& values)
+        {
+            if constexpr (ForReading)
+                bounded_ = false;
+            else if constexpr (IsArrayElement<T>::value)
+                size_ += Format::template arraySize<T>(values.size());
+            else {
+                size_ += Format::MaxIntSize;
+                for (const auto& value : values)
+                    add(value);
+            }
+        }
+
+        template <class K, class V, class C, class A>
+        void add(const std::map<K, V, C, A>& values)
+        {
+            if constexpr (ForReading)
+                bounded_ = false;
+            else {
+                size_ += Format::MaxIntSize;
+                for (const auto& entry : values) {
+                    add(entry.first);
+                    add(entry.second);
+                }
+            }
+        }
+
+        template <class T>
+        void add(const std::optional<T>& value)
+        {
+            size_ += Format::MaxBoolSize;
+            if (value)
+                add(*value);
+            else if (ForReading)
+                add(T()); // the value that may follow
+        }
+
+    public:
+        template <class T>
+        void measure(T& object)
+        {
+            add(object);
+        }
+
+        template <class... ArgsT>
+        Error operator()(ArgsT&&... args)
+        {
+            (add(args), ...);
+            return Error::NoError;
+        }
+
+        size_t size() const { return size_; }
+        bool bounded() const { return bounded_; }
+};
+
+#endif
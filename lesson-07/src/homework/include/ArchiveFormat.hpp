@@ -0,0 +1,519 @@
+#ifndef ARCHIVE_FORMAT_HPP
+#define ARCHIVE_FORMAT_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#pragma once
+
+enum class Error
+{
+    NoError,
+    CorruptedArchive,
+    BufferOverflow // the message does not fit in the output buffer
+};
+
+// Types saved as an opaque byte string (e.g. BigInt from lesson-06): they
+// provide
+//     size_t encodedSize() const;
+//     uint8_t* encode(uint8_t* out) const;
+//     static const uint8_t* decode(const uint8_t* first, const uint8_t* last, T& value);
+// where decode() returns the end of the encoding, or nullptr when the bytes
+// are corrupted.
+template <class T, class = void>
+struct IsByteEncodable : std::false_type {};
+
+template <class T>
+struct IsByteEncodable<T, std::void_t<
+    decltype(std::declval<const T&>().encodedSize()),
+    decltype(std::declval<const T&>().encode(std::declval<uint8_t*>())),
+    decltype(T::decode(std::declval<const uint8_t*>(), std::declval<const uint8_t*>(), std::declval<T&>()))>>
+    : std::true_type {};
+
+// Nested messages: types with a serialize() accepting Archive
+template <class T, class Archive, class = void>
+struct HasSerialize : std::false_type {};
+
+template <class T, class Archive>
+struct HasSerialize<T, Archive, std::void_t<
+    decltype(std::declval<T&>().serialize(std::declval<Archive&>()))>>
+    : std::true_type {};
+
+// float and double: their IEEE 754 bytes in the binary formats, the
+// shortest decimal that reads back the same value in the text format
+template <class T>
+struct IsFloatField
+    : std::integral_constant<bool, std::is_same<T, float>::value || std::is_same<T, double>::value> {};
+
+// Elements of std::vector written as one array (writeArray / readArray)
+// rather than one value at a time: integers and floating-point numbers.
+// Other trivially copyable elements (structs) keep the per-element path,
+// since their bytes include padding and depend on the host's byte order.
+template <class T>
+struct IsArrayElement
+    : std::integral_constant<bool, (std::is_integral<T>::value && !std::is_same<T, bool>::value) ||
+                                   IsFloatField<T>::value> {};
+
+// Fields whose largest encoded size follows from their type: bool and
+// integers. A serialize() call made only of them is written and read in
+// one piece (BasicSerializer::operator()), its size a compile-time
+// constant.
+template <class T>
+struct IsFixedSizeField : std::is_integral<T> {};
+
+template <class Format, class T>
+struct MaxFieldSize
+    : std::integral_constant<size_t, std::is_same<T, bool>::value ? Format::MaxBoolSize : Format::MaxIntSize> {};
+
+// Integer fields other than uint64_t travel as a uint64_t: unsigned
+// values as they are, signed ones sign-extended or, in formats with
+// ZigZagSigned (varints), zigzag-mapped (0, -1, 1, -2, ... to 0, 1, 2,
+// 3, ...) so that small negative values stay short.
+template <class Format, class T>
+uint64_t toWire(T value)
+{
+    if constexpr (std::is_signed<T>::value && Format::ZigZagSigned) {
+        const uint64_t v = uint64_t(int64_t(value));
+        return (v << 1) ^ (0 - (v >> 63));
+    } else {
+        return uint64_t(value);
+    }
+}
+
+// false when `wire` is not the encoding of a T
+template <class Format, class T>
+bool fromWire(uint64_t wire, T& value)
+{
+    if constexpr (std::is_signed<T>::value && Format::ZigZagSigned) {
+        const int64_t v = int64_t((wire >> 1) ^ (0 - (wire & 1)));
+        if (int64_t(T(v)) != v)
+            return false;
+        value = T(v);
+    } else {
+        if (uint64_t(T(wire)) != wire)
+            return false;
+        value = T(wire);
+    }
+    return true;
+}
+
+// Archive formats: how BasicSerializer and BasicDeserializer write and read
+// each value. A format provides static write(out, value) and
+// read(in, value&) for bool, uint64_t, float and double, plus writeBytes /
+// readBytes for byte strings, writeString / readString for std::string and
+// writeArray / readArray for vectors of numbers, on any writer / reader of
+// ArchiveBackend.hpp; the largest size each value can take, so that
+// buffer backends check the space once per message; and whether signed
+// integers are zigzag-mapped (see toWire()).
+
+// Decimal numbers, true / false and byte strings in hexadecimal, each
+// followed by a space: the original text archive. Strings are their length
+// then, unless empty, their bytes in hexadecimal; arrays their length then
+// each element as a number.
+struct TextFormat
+{
+    static constexpr char Separator = ' ';
+
+    static constexpr size_t MaxBoolSize = 6;  // "false "
+    static constexpr size_t MaxIntSize = 21;  // 20 digits and the separator
+    static constexpr size_t MaxFloatSize = 25; // "-2.2250738585072014e-308 "
+    static constexpr size_t bytesSize(size_t n) { return 2 * n + 1; }
+    static constexpr size_t stringSize(size_t n) { return MaxIntSize + bytesSize(n); }
+    template <class T>
+    static constexpr size_t arraySize(size_t n)
+    {
+        return MaxIntSize + n * (IsFloatField<T>::value ? MaxFloatSize : MaxIntSize);
+    }
+    // a token can be preceded by any amount of whitespace, so reads are
+    // always checked
+    static constexpr bool BoundedReads = false;
+    // whether every bool and integer takes exactly its Max*Size
+    static constexpr bool ExactSizes = false;
+    static constexpr bool ZigZagSigned = false;
+
+    template <class Writer>
+    static Error write(Writer& out, bool value)
+    {
+        if (value)
+            out.write("true ", 5);
+        else
+            out.write("false ", 6);
+        return Error::NoError;
+    }
+
+    template <class Writer>
+    static Error write(Writer& out, uint64_t value)
+    {
+        char buf[MaxIntSize];
+        char* end = std::to_chars(buf, buf + MaxIntSize - 1, value).ptr;
+        *end++ = Separator;
+        out.write(buf, size_t(end - buf));
+        return Error::NoError;
+    }
+
+    template <class Writer, class T>
+    static std::enable_if_t<IsFloatField<T>::value, Error> write(Writer& out, T value)
+    {
+        char buf[MaxFloatSize];
+        char* end = std::to_chars(buf, buf + MaxFloatSize - 1, value).ptr;
+        *end++ = Separator;
+        out.write(buf, size_t(end - buf));
+        return Error::NoError;
+    }
+
+    template <class Writer>
+    static Error writeBytes(Writer& out, const uint8_t* bytes, size_t size)
+    {
+        std::vector<char> text(bytesSize(size));
+        toHex(bytes, size, text.data());
+        text.back() = Separator;
+        out.write(text.data(), text.size());
+        return Error::NoError;
+    }
+
+    template <class Writer>
+    static Error writeString(Writer& out, const char* data, size_t size)
+    {
+        write(out, uint64_t(size));
+        if (size != 0)
+            writeBytes(out, reinterpret_cast<const uint8_t*>(data), size);
+        return Error::NoError;
+    }
+
+    // integers other than uint64_t are written as uint64_t, like single
+    // values
+    template <class Writer, class T>
+    static Error writeArray(Writer& out, const T* data, size_t size)
+    {
+        write(out, uint64_t(size));
+        for (size_t i = 0; i < size; ++i) {
+            if constexpr (IsFloatField<T>::value)
+                write(out, data[i]);
+            else
+                write(out, uint64_t(data[i]));
+        }
+        return Error::NoError;
+    }
+
+    template <class Reader>
+    static Error read(Reader& in, bool& value)
+    {
+        const char* token;
+        size_t size;
+        if (!in.token(token, size))
+            return Error::CorruptedArchive;
+        return parse(token, size, value);
+    }
+
+    template <class Reader>
+    static Error read(Reader& in, uint64_t& value)
+    {
+        const char* token;
+        size_t size;
+        if (!in.token(token, size))
+            return Error::CorruptedArchive;
+        return parse(token, size, value);
+    }
+
+    template <class Reader, class T>
+    static std::enable_if_t<IsFloatField<T>::value, Error> read(Reader& in, T& value)
+    {
+        const char* token;
+        size_t size;
+        if (!in.token(token, size))
+            return Error::CorruptedArchive;
+        return parse(token, size, value);
+    }
+
+    // Bytes: std::vector<uint8_t> or std::string
+    template <class Reader, class Bytes>
+    static Error readBytes(Reader& in, Bytes& bytes)
+    {
+        const char* token;
+        size_t size;
+        if (!in.token(token, size) || size % 2 != 0)
+            return Error::CorruptedArchive;
+        bytes.resize(size / 2);
+        return parseHex(token, size, reinterpret_cast<uint8_t*>(&bytes[0]));
+    }
+
+    template <class Reader>
+    static Error readString(Reader& in, std::string& value)
+    {
+        uint64_t size = 0;
+        if (read(in, size) != Error::NoError)
+            return Error::CorruptedArchive;
+        if (size == 0) {
+            value.clear();
+            return Error::NoError;
+        }
+        if (readBytes(in, value) != Error::NoError || value.size() != size)
+            return Error::CorruptedArchive;
+        return Error::NoError;
+    }
+
+    // elements that do not fit in T are corrupted. The elements are
+    // overwritten in place; the vector only grows one element at a time,
+    // so that a corrupted size fails at the end of the input rather than
+    // in a huge allocation.
+    template <class Reader, class T, class A>
+    static Error readArray(Reader& in, std::vector<T, A>& values)
+    {
+        uint64_t size = 0;
+        if (read(in, size) != Error::NoError)
+            return Error::CorruptedArchive;
+        if (size < values.size())
+            values.resize(size_t(size));
+        for (uint64_t i = 0; i < size; ++i) {
+            T value{};
+            if constexpr (IsFloatField<T>::value) {
+                if (read(in, value) != Error::NoError)
+                    return Error::CorruptedArchive;
+            } else {
+                uint64_t v = 0;
+                if (read(in, v) != Error::NoError || uint64_t(T(v)) != v)
+                    return Error::CorruptedArchive;
+                value = T(v);
+            }
+            if (i == values.size())
+                values.emplace_back();
+            values[size_t(i)] = value;
+        }
+        return Error::NoError;
+    }
+
+    // token conversions (Serializer.cpp, Deserializer.cpp)
+    static void toHex(const uint8_t* bytes, size_t size, char* out);
+    static Error parse(const char* token, size_t size, bool& value);
+    static Error parse(const char* token, size_t size, uint64_t& value);
+    static Error parse(const char* token, size_t size, float& value);
+    static Error parse(const char* token, size_t size, double& value);
+    // size / 2 bytes to out; size must be even and non-zero
+    static Error parseHex(const char* token, size_t size, uint8_t* out);
+};
+
+enum class IntEncoding
+{
+    Fixed,  // 8 little-endian bytes
+    Varint  // LEB128: 7 bits per byte, low bits first, 1 to 10 bytes;
+            // signed integers zigzag-mapped first
+};
+
+// Binary archive without separators: integers as IntEncoding says, bools
+// as one byte 0 or 1, byte strings and strings as their length (an
+// integer) followed by the bytes. Floats and doubles are their 4 or 8
+// little-endian IEEE 754 bytes. Arrays of numbers are their length then
+// the elements' sizeof(T) little-endian bytes each, whatever IntEncoding:
+// on little-endian machines, a single memcpy each way. Reading rejects
+// anything another value could not have written: bytes other than 0 and 1
+// for a bool, overlong or overflowing varints, a truncated stream.
+template <IntEncoding Ints>
+struct BinaryFormat
+{
+    static constexpr size_t MaxBoolSize = 1;
+    static constexpr size_t MaxIntSize = Ints == IntEncoding::Fixed ? 8 : 10;
+    static constexpr size_t MaxFloatSize = 8;
+    static constexpr size_t bytesSize(size_t n) { return MaxIntSize + n; }
+    static constexpr size_t stringSize(size_t n) { return bytesSize(n); }
+    template <class T>
+    static constexpr size_t arraySize(size_t n) { return MaxIntSize + n * sizeof(T); }
+    static constexpr bool BoundedReads = true;
+    static constexpr bool ExactSizes = Ints == IntEncoding::Fixed;
+    // -1 is 1 byte rather than 10
+    static constexpr bool ZigZagSigned = Ints == IntEncoding::Varint;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    static constexpr bool LittleEndianHost = false;
+#else
+    static constexpr bool LittleEndianHost = true;
+#endif
+
+    // reverses the bytes of each of the n elements of size `size` at p
+    static void swapBytes(char* p, size_t n, size_t size)
+    {
+        for (size_t i = 0; i < n; ++i, p += size)
+            std::reverse(p, p + size);
+    }
+
+    template <class Writer>
+    static Error write(Writer& out, bool value)
+    {
+        out.put(value ? 1 : 0);
+        return Error::NoError;
+    }
+
+    template <class Writer>
+    static Error write(Writer& out, uint64_t value)
+    {
+        char buf[MaxIntSize];
+        size_t n = 0;
+        if constexpr (Ints == IntEncoding::Fixed) {
+            for (; n < 8; ++n)
+                buf[n] = char(value >> (8 * n));
+        } else {
+            for (; value >= 0x80; value >>= 7)
+                buf[n++] = char(value | 0x80);
+            buf[n++] = char(value);
+        }
+        out.write(buf, n);
+        return Error::NoError;
+    }
+
+    template <class Writer, class T>
+    static std::enable_if_t<IsFloatField<T>::value, Error> write(Writer& out, T value)
+    {
+        char buf[sizeof(T)];
+        std::memcpy(buf, &value, sizeof(T));
+        if constexpr (!LittleEndianHost)
+            swapBytes(buf, 1, sizeof(T));
+        out.write(buf, sizeof(T));
+        return Error::NoError;
+    }
+
+    template <class Writer>
+    static Error writeBytes(Writer& out, const uint8_t* bytes, size_t size)
+    {
+        write(out, uint64_t(size));
+        out.write(reinterpret_cast<const char*>(bytes), size);
+        return Error::NoError;
+    }
+
+    template <class Writer>
+    static Error writeString(Writer& out, const char* data, size_t size)
+    {
+        return writeBytes(out, reinterpret_cast<const uint8_t*>(data), size);
+    }
+
+    template <class Writer, class T>
+    static Error writeArray(Writer& out, const T* data, size_t size)
+    {
+        write(out, uint64_t(size));
+        if constexpr (LittleEndianHost || sizeof(T) == 1) {
+            out.write(reinterpret_cast<const char*>(data), size * sizeof(T));
+        } else {
+            for (size_t i = 0; i < size; ++i) {
+                char buf[sizeof(T)];
+                std::memcpy(buf, &data[i], sizeof(T));
+                swapBytes(buf, 1, sizeof(T));
+                out.write(buf, sizeof(T));
+            }
+        }
+        return Error::NoError;
+    }
+
+    template <class Reader>
+    static Error read(Reader& in, bool& value)
+    {
+        const int c = in.get();
+        if (c != 0 && c != 1)
+            return Error::CorruptedArchive;
+        value = c == 1;
+        return Error::NoError;
+    }
+
+    template <class Reader>
+    static Error read(Reader& in, uint64_t& value)
+    {
+        if constexpr (Ints == IntEncoding::Fixed) {
+            unsigned char buf[8];
+            if (!in.read(reinterpret_cast<char*>(buf), 8))
+                return Error::CorruptedArchive;
+            uint64_t v = 0;
+            for (size_t i = 0; i < 8; ++i)
+                v |= uint64_t(buf[i]) << (8 * i);
+            value = v;
+        } else {
+            uint64_t v = 0;
+            for (unsigned shift = 0; ; shift += 7) {
+                const int c = in.get();
+                // end of input, more than 64 bits, or a useless trailing
+                // zero byte
+                if (c < 0 || (shift == 63 && c > 1) || (c == 0 && shift != 0))
+                    return Error::CorruptedArchive;
+                v |= uint64_t(c & 0x7f) << shift;
+                if (c < 0x80)
+                    break;
+            }
+            value = v;
+        }
+        return Error::NoError;
+    }
+
+    template <class Reader, class T>
+    static std::enable_if_t<IsFloatField<T>::value, Error> read(Reader& in, T& value)
+    {
+        char buf[sizeof(T)];
+        if (!in.read(buf, sizeof(T)))
+            return Error::CorruptedArchive;
+        if constexpr (!LittleEndianHost)
+            swapBytes(buf, 1, sizeof(T));
+        std::memcpy(&value, buf, sizeof(T));
+        return Error::NoError;
+    }
+
+    // Bytes: std::vector<uint8_t> or std::string
+    template <class Reader, class Bytes>
+    static Error readBytes(Reader& in, Bytes& bytes)
+    {
+        uint64_t size = 0;
+        if (read(in, size) != Error::NoError)
+            return Error::CorruptedArchive;
+        return readElements(in, bytes, size);
+    }
+
+    template <class Reader>
+    static Error readString(Reader& in, std::string& value)
+    {
+        return readBytes(in, value);
+    }
+
+    template <class Reader, class T, class A>
+    static Error readArray(Reader& in, std::vector<T, A>& values)
+    {
+        uint64_t size = 0;
+        if (read(in, size) != Error::NoError || size > uint64_t(-1) / sizeof(T))
+            return Error::CorruptedArchive;
+        Error err = readElements(in, values, size);
+        if constexpr (!LittleEndianHost && sizeof(T) > 1) {
+            if (err == Error::NoError)
+                swapBytes(reinterpret_cast<char*>(values.data()), values.size(), sizeof(T));
+        }
+        return err;
+    }
+
+    // size elements of a contiguous container, read straight into its
+    // storage: in one go when its capacity is already large enough,
+    // otherwise growing by up to 64KB at a time, so that a corrupted length
+    // fails at the end of the input rather than in a huge allocation
+    template <class Reader, class Container>
+    static Error readElements(Reader& in, Container& values, uint64_t size)
+    {
+        using T = typename Container::value_type;
+        if (size <= values.capacity()) {
+            values.resize(size_t(size));
+            if (size != 0 && !in.read(reinterpret_cast<char*>(&values[0]), size_t(size) * sizeof(T)))
+                return Error::CorruptedArchive;
+            return Error::NoError;
+        }
+        const uint64_t chunk = std::max<uint64_t>(1, (1 << 16) / sizeof(T));
+        values.clear();
+        while (values.size() < size) {
+            const size_t old = values.size();
+            values.resize(old + size_t(std::min<uint64_t>(size - old, chunk)));
+            if (!in.read(reinterpret_cast<char*>(&values[old]), (values.size() - old) * sizeof(T)))
+                return Error::CorruptedArchive;
+        }
+        return Error::NoError;
+    }
+};
+
+using FixedBinaryFormat = BinaryFormat<IntEncoding::Fixed>;
+using VarintBinaryFormat = BinaryFormat<IntEncoding::Varint>;
+
+#endif
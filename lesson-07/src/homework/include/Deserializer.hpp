@@ -5,51 +5,244 @@
 #include <cstdint>
 #include <stdexcept>
 #include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
 
 #pragma once
 
-class Deserializer
+// Reads what BasicSerializer<Format> wrote, from Reader; Deserializer is
+// the text archive on a stream.
+template <class Format, class Reader = StreamReader>
+class BasicDeserializer
 {
-    static constexpr char Separator = ' ';
-
     private:
-    // process использует variadic templates
-        std::istream& in_ ;
+        Reader in_ ;
 
-        template <class T, class... Args>
-        Error process(T& val, Args&... args)
+        // the reading side of BasicSerializer::processFixed: with a bound
+        // on the fields' size known at compile time, one check (or, from a
+        // stream in a format of exact sizes, one read) and then every field
+        // in turn, their errors combined at the end. Otherwise the fields
+        // are read through the checked reader, still all or nothing.
+        template <class... ArgsT>
+        Error processFixed(ArgsT&... args)
         {
-            Error err = load(val);
-            if (err != Error::NoError)
+            constexpr size_t size = (size_t(0) + ... + MaxFieldSize<Format, ArgsT>::value);
+            if constexpr (std::is_same<Reader, UncheckedBufferReader>::value) {
+                return loadFixed(in_, args...);
+            } else if constexpr (std::is_same<Reader, BufferReader>::value && Format::BoundedReads) {
+                if (in_.remaining() < size)
+                    return loadFixed(in_, args...); // may still be there
+                UncheckedBufferReader in(in_.position());
+                Error err = loadFixed(in, args...);
+                in_.setPosition(in.position());
                 return err;
-            return process(args...);
+            } else if constexpr (std::is_same<Reader, StreamReader>::value && Format::ExactSizes) {
+                char buf[size];
+                if (!in_.read(buf, size))
+                    return Error::CorruptedArchive;
+                UncheckedBufferReader in(reinterpret_cast<const uint8_t*>(buf));
+                return loadFixed(in, args...);
+            } else {
+                return loadFixed(in_, args...);
+            }
         }
 
-        Error process() { return Error::NoError; }
+        // Every field is read into a temporary, in order (a comma fold is
+        // sequenced), with no branch in between; the fields are assigned
+        // only if all of them are valid, so that a failed load() leaves
+        // them untouched.
+        template <class R, class... ArgsT>
+        static Error loadFixed(R& in, ArgsT&... args)
+        {
+            std::tuple<ArgsT...> values;
+            bool ok = true;
+            std::apply([&](auto&... value) { ((ok &= loadField(in, value)), ...); }, values);
+            if (!ok)
+                return Error::CorruptedArchive;
+            std::tie(args...) = values;
+            return Error::NoError;
+        }
+
+        template <class R, class T>
+        static bool loadField(R& in, T& value)
+        {
+            if constexpr (std::is_same<T, bool>::value || std::is_same<T, uint64_t>::value) {
+                return Format::read(in, value) == Error::NoError;
+            } else {
+                uint64_t v = 0;
+                return Format::read(in, v) == Error::NoError && fromWire<Format>(v, value);
+            }
+        }
         
 
     public:
-        explicit Deserializer(std::istream& in) : in_(in)
+        explicit BasicDeserializer(Reader in) : in_(in)
         {
 
         }
 
+        Reader& reader() { return in_; }
+
+        // On an error, the fields before the corrupted one may already be
+        // loaded, never those after it; a serialize() call of bools and
+        // integers only (processFixed) is assigned all at once or not at all.
         template <class T>
         Error load(T& object)
         {
-            return object.serialize(*this);
+            if constexpr (std::is_same<Reader, BufferReader>::value && Format::BoundedReads) {
+                SizeBound<Format, true> bound;
+                bound.measure(object);
+                if (bound.bounded() && bound.size() <= in_.remaining()) {
+                    // one check for the whole message
+                    BasicDeserializer<Format, UncheckedBufferReader> fast(
+                        UncheckedBufferReader(in_.position()));
+                    Error err = fast.load(object);
+                    in_.setPosition(fast.reader().position());
+                    return err;
+                }
+            }
+            if constexpr (IsByteEncodable<T>::value) {
+                std::vector<uint8_t> bytes;
+                Error err = Format::readBytes(in_, bytes);
+                if (err != Error::NoError)
+                    return err;
+                const uint8_t* end = bytes.data() + bytes.size();
+                if (T::decode(bytes.data(), end, object) != end)
+                    return Error::CorruptedArchive;
+                return Error::NoError;
+            } else if constexpr (std::is_integral<T>::value) {
+                // other integer types, written as uint64_t: corrupted when
+                // the value does not fit
+                uint64_t value = 0;
+                if (load(value) != Error::NoError || !fromWire<Format>(value, object))
+                    return Error::CorruptedArchive;
+                return Error::NoError;
+            } else if constexpr (IsFloatField<T>::value) {
+                return Format::read(in_, object);
+            } else {
+                return object.serialize(*this);
+            }
         }
 
         template <class... ArgsT>
         Error operator()(ArgsT&... args)
         {
+            if constexpr (sizeof...(ArgsT) != 0 && (IsFixedSizeField<ArgsT>::value && ...))
+                return processFixed(args...);
+            else
+                return process(args...);
+        }
+
+        // process использует variadic templates: the generic path of
+        // operator(), one checked field at a time. Public, like
+        // BasicSerializer::process.
+        template <class T, class... Args>
+        Error process(T& val, Args&... args)
+        {
+            Error err = load(val);
+            if (err != Error::NoError)
+                return err;
             return process(args...);
         }
 
-        Error load() ;
-        Error load(bool& value);
-        Error load(uint64_t &arg);      
+        Error process() { return Error::NoError; }
+
+        Error load() { return Error::NoError; }
+        Error load(bool& value) { return Format::read(in_, value); }
+        Error load(uint64_t &arg) { return Format::read(in_, arg); }
+
+        // Containers are overwritten, reusing what they hold: the string's
+        // or vector's storage, the vector's elements (and so their own
+        // storage), the map's nodes, the optional's value.
+        Error load(std::string& value) { return Format::readString(in_, value); }
+
+        template <class T, class A>
+        Error load(std::vector<T, A>& values)
+        {
+            if constexpr (IsArrayElement<T>::value) {
+                return Format::readArray(in_, values);
+            } else {
+                uint64_t size = 0;
+                if (load(size) != Error::NoError)
+                    return Error::CorruptedArchive;
+                if (size < values.size())
+                    values.resize(size_t(size));
+                // one element at a time, so that a corrupted size fails at
+                // the end of the input rather than in a huge allocation
+                for (uint64_t i = 0; i < size; ++i) {
+                    if (i == values.size())
+                        values.emplace_back();
+                    Error err;
+                    if constexpr (std::is_same<T, bool>::value) {
+                        bool value = false;
+                        err = load(value);
+                        values[i] = value;
+                    } else {
+                        err = load(values[i]);
+                    }
+                    if (err != Error::NoError)
+                        return err;
+                }
+                return Error::NoError;
+            }
+        }
+
+        // keys must be distinct, as the serializer writes them
+        template <class K, class V, class C, class A>
+        Error load(std::map<K, V, C, A>& values)
+        {
+            uint64_t size = 0;
+            if (load(size) != Error::NoError)
+                return Error::CorruptedArchive;
+            // the old nodes are refilled and moved back in
+            std::map<K, V, C, A> old;
+            old.swap(values);
+            for (uint64_t i = 0; i < size; ++i) {
+                const size_t before = values.size();
+                Error err;
+                if (!old.empty()) {
+                    auto node = old.extract(old.begin());
+                    err = process(node.key(), node.mapped());
+                    values.insert(values.end(), std::move(node));
+                } else {
+                    K key{};
+                    V value{};
+                    err = process(key, value);
+                    values.emplace_hint(values.end(), std::move(key), std::move(value));
+                }
+                if (err != Error::NoError)
+                    return err;
+                if (values.size() == before)
+                    return Error::CorruptedArchive;
+            }
+            return Error::NoError;
+        }
+
+        template <class T>
+        Error load(std::optional<T>& value)
+        {
+            bool present = false;
+            if (load(present) != Error::NoError)
+                return Error::CorruptedArchive;
+            if (!present) {
+                value.reset();
+                return Error::NoError;
+            }
+            if (!value)
+                value.emplace();
+            return load(*value);
+        }
 };
 
-#endif
+using Deserializer = BasicDeserializer<TextFormat>;
+using FixedBinaryDeserializer = BasicDeserializer<FixedBinaryFormat>;
+using VarintBinaryDeserializer = BasicDeserializer<VarintBinaryFormat>;
 
+// from a byte buffer: BufferDeserializer<VarintBinaryFormat> d({data, size});
+template <class Format>
+using BufferDeserializer = BasicDeserializer<Format, BufferReader>;
+
+#endif
@@ -1,18 +1,21 @@
 #ifndef SERIALIZER_HPP
 #define SERIALIZER_HPP
 
+#include "ArchiveFormat.hpp"
+#include "ArchiveBackend.hpp"
 #include <cstdint>
 #include <stdexcept>
 #include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #pragma once
 
-enum class Error
-{
-    NoError,
-    CorruptedArchive
-};
-
 struct Data
 {
     uint64_t a;
@@ -26,47 +29,238 @@ struct Data
     }
 };
 
-class Serializer
+// Writes values in the archive format Format (see ArchiveFormat.hpp) to
+// Writer, a stream by default (see ArchiveBackend.hpp); Serializer is the
+// text archive on a stream.
+template <class Format, class Writer = StreamWriter>
+class BasicSerializer
 {
-    static constexpr char Separator = ' ';
-
     private:
     // process использует variadic templates
-        std::ostream& out_ ;
+        Writer out_ ;
+
+        // all-bool-and-integer calls of operator(): the fields' size is a
+        // compile-time constant, checked at most once, then each field is
+        // stored in turn without dispatch or error checks
+        template <class... ArgsT>
+        Error processFixed(const ArgsT&... args)
+        {
+            constexpr size_t size = (size_t(0) + ... + MaxFieldSize<Format, ArgsT>::value);
+            if constexpr (std::is_same<Writer, UncheckedBufferWriter>::value) {
+                storeFixed(out_, args...);
+            } else if constexpr (std::is_same<Writer, BufferWriter>::value) {
+                if (out_.remaining() < size)
+                    return process(args...); // may still fit, field by field
+                UncheckedBufferWriter out(out_.position());
+                storeFixed(out, args...);
+                out_.setPosition(out.position());
+            } else {
+                // one write to the stream
+                uint8_t buf[size];
+                UncheckedBufferWriter out(buf);
+                storeFixed(out, args...);
+                out_.write(reinterpret_cast<const char*>(buf), size_t(out.position() - buf));
+            }
+            return Error::NoError;
+        }
+
+        template <class W, class... ArgsT>
+        static void storeFixed(W& out, const ArgsT&... args)
+        {
+            (Format::write(out, wireValue(args)), ...);
+        }
+
+        static bool wireValue(bool value) { return value; }
+
+        template <class T>
+        static uint64_t wireValue(T value) { return toWire<Format>(value); }
+
+        template <class... ArgsT>
+        Error dispatch(ArgsT&&... args)
+        {
+            if constexpr (sizeof...(ArgsT) != 0 && (IsFixedSizeField<std::decay_t<ArgsT>>::value && ...))
+                return processFixed(args...);
+            else
+                return process(std::forward<ArgsT>(args)...);
+        }
+
+        template <class T>
+        Error saveFields(T& object)
+        {
+            if constexpr (HasSerialize<T, BasicSerializer>::value)
+                return object.serialize(*this);
+            else
+                return process(object);
+        }
 
     public:
-        explicit Serializer(std::ostream& out) : out_(out)
+        explicit BasicSerializer(Writer out) : out_(out)
         {
 
         }
 
+        Writer& writer() { return out_; }
+
+        // On a BufferWriter a message is either written whole or not at
+        // all (Error::BufferOverflow, nothing written).
         template <class T>
         Error save(T& object)
         {
-            return object.serialize(*this);
+            if constexpr (std::is_same<Writer, BufferWriter>::value) {
+                SizeBound<Format, false> bound;
+                bound.measure(object);
+                if (bound.size() <= out_.remaining()) {
+                    // one check for the whole message
+                    BasicSerializer<Format, UncheckedBufferWriter> fast(
+                        UncheckedBufferWriter(out_.position()));
+                    Error err = fast.save(object);
+                    out_.setPosition(fast.writer().position());
+                    return err;
+                }
+                // the bound is pessimistic (every varint at its longest):
+                // the message may still fit
+                uint8_t* start = out_.position();
+                out_.clearOverflow();
+                Error err = saveFields(object);
+                if (out_.overflow()) {
+                    out_.setPosition(start);
+                    return Error::BufferOverflow;
+                }
+                return err;
+            } else {
+                return saveFields(object);
+            }
         }
 
+        // On a BufferWriter a call is, like a message, either written whole
+        // or not at all (Error::BufferOverflow, nothing written).
         template <class... ArgsT>
-        Error operator()(ArgsT... args)
+        Error operator()(ArgsT&&... args)
         {
-            return process(std::forward<ArgsT>(args)...);
+            if constexpr (std::is_same<Writer, BufferWriter>::value) {
+                // an overflow of an earlier call stays visible to save()
+                const bool earlier = out_.overflow();
+                uint8_t* start = out_.position();
+                out_.clearOverflow();
+                Error err = dispatch(std::forward<ArgsT>(args)...);
+                if (out_.overflow()) {
+                    out_.setPosition(start);
+                    return Error::BufferOverflow;
+                }
+                out_.setOverflow(earlier);
+                return err;
+            } else {
+                return dispatch(std::forward<ArgsT>(args)...);
+            }
         }
 
         // variadic dispatcher implemented in-header
         Error process() { return Error::NoError; }
 
-        template <class T, class... Args>
-        Error process(T&& val, Args&&... args)
+        // two or more values: the first one, then the rest (a single value
+        // goes to one of the overloads below)
+        template <class T, class U, class... Args>
+        Error process(T&& val, U&& next, Args&&... args)
         {
             Error err = process(std::forward<T>(val));
             if (err != Error::NoError)
                 return err;
-            return process(std::forward<Args>(args)...);
+            return process(std::forward<U>(next), std::forward<Args>(args)...);
         }
 
         // overloads for supported types
-        Error process(bool arg);
-        Error process(uint64_t arg);
+        Error process(bool arg) { return Format::write(out_, arg); }
+        Error process(uint64_t arg) { return Format::write(out_, arg); }
+
+        // other integer types are written as uint64_t (see toWire()). A
+        // literal such as 5 is an int, and signed: in a varint format it
+        // reads back into a signed type.
+        template <class T>
+        std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value, Error>
+        process(T arg)
+        {
+            return process(toWire<Format>(arg));
+        }
+
+        template <class T>
+        std::enable_if_t<IsFloatField<T>::value, Error> process(T arg)
+        {
+            return Format::write(out_, arg);
+        }
+
+        template <class T>
+        std::enable_if_t<IsByteEncodable<T>::value, Error> process(const T& value)
+        {
+            std::vector<uint8_t> bytes(value.encodedSize());
+            value.encode(bytes.data());
+            return Format::writeBytes(out_, bytes.data(), bytes.size());
+        }
+
+        // containers: their size, then their elements
+        Error process(const std::string& value)
+        {
+            return Format::writeString(out_, value.data(), value.size());
+        }
+
+        // string literals and views, written as std::string (a literal
+        // would otherwise convert to bool)
+        Error process(std::string_view value)
+        {
+            return Format::writeString(out_, value.data(), value.size());
+        }
+
+        Error process(const char* value) { return process(std::string_view(value)); }
+
+        template <class T>
+        Error process(const T*) = delete;
+
+        template <class T, class A>
+        Error process(const std::vector<T, A>& values)
+        {
+            if constexpr (IsArrayElement<T>::value) {
+                return Format::writeArray(out_, values.data(), values.size());
+            } else {
+                Error err = process(uint64_t(values.size()));
+                for (auto it = values.begin(); it != values.end() && err == Error::NoError; ++it)
+                    err = process(*it);
+                return err;
+            }
+        }
+
+        template <class K, class V, class C, class A>
+        Error process(const std::map<K, V, C, A>& values)
+        {
+            Error err = process(uint64_t(values.size()));
+            for (auto it = values.begin(); it != values.end() && err == Error::NoError; ++it)
+                err = process(it->first, it->second);
+            return err;
+        }
+
+        // a bool, then the value if there is one
+        template <class T>
+        Error process(const std::optional<T>& value)
+        {
+            Error err = process(value.has_value());
+            if (err != Error::NoError || !value)
+                return err;
+            return process(*value);
+        }
+
+        // nested messages. serialize() is not const since the deserializer
+        // uses it too, but writing does not modify the object.
+        template <class T>
+        std::enable_if_t<HasSerialize<T, BasicSerializer>::value, Error> process(const T& object)
+        {
+            return const_cast<T&>(object).serialize(*this);
+        }
 };
 
+using Serializer = BasicSerializer<TextFormat>;
+using FixedBinarySerializer = BasicSerializer<FixedBinaryFormat>;
+using VarintBinarySerializer = BasicSerializer<VarintBinaryFormat>;
+
+// into a byte buffer: BufferSerializer<VarintBinaryFormat> s({data, size});
+template <class Format>
+using BufferSerializer = BasicSerializer<Format, BufferWriter>;
+
 #endif
@@ -1,19 +1,14 @@
 #include "../include/Serializer.hpp"
 #include "../include/Deserializer.hpp"
 #include <string>
-#include <sstream>
+#include <string_view>
 
 // Template variadic `process` implemented in header `Deserializer.hpp`.
-// Non-template overloads / helpers remain here.
+// The text format's token parsers remain here.
 
-Error Deserializer::load() {
-    return Error::NoError;
-}
-
-Error Deserializer::load(bool& value)
+Error TextFormat::parse(const char* token, size_t size, bool& value)
 {
-    std::string text;
-    in_ >> text;
+    const std::string_view text(token, size);
 
     if (text == "true")
         value = true;
@@ -25,24 +20,57 @@ Error Deserializer::load(bool& value)
     return Error::NoError;
 }
 
-Error Deserializer::load(uint64_t &arg)
+Error TextFormat::parse(const char* token, size_t size, uint64_t &arg)
 {
-    std::string text;
-    in_ >> text;
+    if (size == 0) 
+        return Error::CorruptedArchive;
 
-    if (text.empty()) 
+    // digits only, no sign, and within uint64_t
+    uint64_t num;
+    const auto res = std::from_chars(token, token + size, num);
+    if (res.ec != std::errc() || res.ptr != token + size)
         return Error::CorruptedArchive;
+    arg = num;
 
-    try {
-        size_t pos;
-        uint64_t num = std::stoull(text, &pos);
-        if (pos != text.size())
-            return Error::CorruptedArchive;
-        arg = num;
-    }
-    catch (...) {
+    return Error::NoError;
+}
+
+// the whole token, in any form std::from_chars accepts (including inf and
+// nan); out of range values are corrupted
+template <class T>
+static Error parseFloat(const char* token, size_t size, T& value)
+{
+    T num;
+    const auto res = std::from_chars(token, token + size, num);
+    if (size == 0 || res.ec != std::errc() || res.ptr != token + size)
         return Error::CorruptedArchive;
-    }
+    value = num;
+    return Error::NoError;
+}
+
+Error TextFormat::parse(const char* token, size_t size, float& value)
+{
+    return parseFloat(token, size, value);
+}
+
+Error TextFormat::parse(const char* token, size_t size, double& value)
+{
+    return parseFloat(token, size, value);
+}
+
+Error TextFormat::parseHex(const char* token, size_t size, uint8_t* out)
+{
 
+    auto digit = [](char c) -> int {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        return -1;
+    };
+    for (size_t i = 0; i < size / 2; ++i) {
+        const int hi = digit(token[2 * i]), lo = digit(token[2 * i + 1]);
+        if (hi < 0 || lo < 0)
+            return Error::CorruptedArchive;
+        out[i] = uint8_t(hi << 4 | lo);
+    }
     return Error::NoError;
-}
\ No newline at end of file
+}
@@ -1,15 +1,10 @@
 #include "../include/Serializer.hpp"
-#include <string>
-#include <sstream>
 
-Error Serializer::process(bool arg)
+void TextFormat::toHex(const uint8_t* bytes, size_t size, char* out)
 {
-    this->out_ << (arg ? "true" : "false") << Serializer::Separator;
-    return Error::NoError;
+    static const char digits[] = "0123456789abcdef";
+    for (size_t i = 0; i < size; ++i) {
+        out[2 * i] = digits[bytes[i] >> 4];
+        out[2 * i + 1] = digits[bytes[i] & 0xf];
+    }
 }
-
-Error Serializer::process(uint64_t arg)
-{
-    this->out_ << arg << Serializer::Separator;
-    return Error::NoError;
-}
\ No newline at end of file
@@ -0,0 +1,57 @@
+// bigint_test.cpp: BigInt from lesson-06 as a byte-encodable field
+#include <gtest/gtest.h>
+#include "../include/Serializer.hpp"
+#include "../include/Deserializer.hpp"
+#include "BigInt.hpp"
+#include <sstream>
+
+struct Account
+{
+    uint64_t id;
+    BigInt balance;
+    bool active;
+
+    template <class SerializerT>
+    Error serialize(SerializerT& serializer)
+    {
+        return serializer(id, balance, active);
+    }
+};
+
+TEST(BigIntSerialization, RoundTrip) {
+    Account x{7, BigInt("-123456789012345678901234567890"), true};
+    std::stringstream s;
+    Serializer ser(s);
+    ASSERT_EQ(ser.save(x), Error::NoError);
+
+    Account y{0, BigInt(), false};
+    Deserializer d(s);
+    ASSERT_EQ(d.load(y), Error::NoError);
+    EXPECT_EQ(x.id, y.id);
+    EXPECT_EQ(x.balance, y.balance);
+    EXPECT_EQ(x.active, y.active);
+}
+
+TEST(BigIntSerialization, TextForm) {
+    std::stringstream s;
+    Serializer ser(s);
+    ASSERT_EQ(ser(BigInt("256"), BigInt("-1"), BigInt()), Error::NoError);
+    EXPECT_EQ(s.str(), "040001 0301 00 ");
+
+    BigInt a, b, c;
+    Deserializer d(s);
+    ASSERT_EQ(d(a, b, c), Error::NoError);
+    EXPECT_EQ(a.toString(), "256");
+    EXPECT_EQ(b.toString(), "-1");
+    EXPECT_EQ(c.toString(), "0");
+}
+
+TEST(BigIntSerialization, Corrupted) {
+    const char* bad[] = {"0", "zz ", "0401 ", "040100 ", "02010 ", "020101 "};
+    for (const char* text : bad) {
+        std::stringstream s(text);
+        Deserializer d(s);
+        BigInt v;
+        EXPECT_EQ(d.load(v), Error::CorruptedArchive) << text;
+    }
+}
@@ -0,0 +1,112 @@
+// binary_test.cpp: the fixed-width and varint binary archives
+#include <gtest/gtest.h>
+#include "../include/Serializer.hpp"
+#include "../include/Deserializer.hpp"
+#include <limits>
+#include <sstream>
+
+template <class Format>
+class BinaryArchiveTest : public ::testing::Test {};
+
+using BinaryFormats = ::testing::Types<FixedBinaryFormat, VarintBinaryFormat>;
+TYPED_TEST_SUITE(BinaryArchiveTest, BinaryFormats);
+
+TYPED_TEST(BinaryArchiveTest, RoundTrip) {
+    const uint64_t values[] = {0, 1, 127, 128, 300, uint64_t(1) << 32,
+                               std::numeric_limits<uint64_t>::max()};
+    std::stringstream s;
+    BasicSerializer<TypeParam> ser(s);
+    for (uint64_t v : values) {
+        Data x{v, v % 2 == 0, ~v};
+        ASSERT_EQ(ser.save(x), Error::NoError);
+    }
+    BasicDeserializer<TypeParam> d(s);
+    for (uint64_t v : values) {
+        Data y{1, false, 1};
+        ASSERT_EQ(d.load(y), Error::NoError);
+        EXPECT_EQ(y.a, v);
+        EXPECT_EQ(y.b, v % 2 == 0);
+        EXPECT_EQ(y.c, ~v);
+    }
+    Data z{};
+    EXPECT_EQ(d.load(z), Error::CorruptedArchive);
+}
+
+TYPED_TEST(BinaryArchiveTest, Truncated) {
+    std::stringstream s;
+    BasicSerializer<TypeParam> ser(s);
+    ASSERT_EQ(ser(uint64_t(1) << 40, true, uint64_t(1) << 50), Error::NoError);
+    const std::string full = s.str();
+    for (size_t n = 0; n < full.size(); ++n) {
+        std::stringstream part(full.substr(0, n));
+        BasicDeserializer<TypeParam> d(part);
+        Data y{};
+        EXPECT_EQ(d.load(y), Error::CorruptedArchive) << n;
+    }
+}
+
+TEST(BinaryArchive, Layout) {
+    std::stringstream fixed;
+    FixedBinarySerializer f(fixed);
+    ASSERT_EQ(f(uint64_t(0x0102030405060708), true), Error::NoError);
+    EXPECT_EQ(fixed.str(), std::string("\x08\x07\x06\x05\x04\x03\x02\x01\x01", 9));
+
+    std::stringstream varint;
+    VarintBinarySerializer v(varint);
+    ASSERT_EQ(v(0u, 127u, 300u, false), Error::NoError);
+    EXPECT_EQ(varint.str(), std::string("\x00\x7f\xac\x02\x00", 5));
+    varint.str("");
+    ASSERT_EQ(v(std::numeric_limits<uint64_t>::max()), Error::NoError);
+    EXPECT_EQ(varint.str().size(), 10u);
+}
+
+TEST(BinaryArchive, ZigZagSignedVarints) {
+    std::stringstream varint;
+    VarintBinarySerializer v(varint);
+    // in one piece (processFixed), then field by field (process)
+    ASSERT_EQ(v(int32_t(-5), int8_t(-3)), Error::NoError);
+    ASSERT_EQ(v(int64_t(63), std::string(), int64_t(-64), int64_t(64)), Error::NoError);
+    EXPECT_EQ(varint.str(), std::string("\x09\x05" "\x7e\x00\x7f\x80\x01", 7));
+    varint.str("");
+    ASSERT_EQ(v(std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()), Error::NoError);
+    EXPECT_EQ(varint.str().size(), 20u);
+
+    VarintBinaryDeserializer d(varint);
+    int64_t lo = 0, hi = 0;
+    ASSERT_EQ(d(lo, hi), Error::NoError);
+    EXPECT_EQ(lo, std::numeric_limits<int64_t>::min());
+    EXPECT_EQ(hi, std::numeric_limits<int64_t>::max());
+
+    // what -200 decodes to does not fit an int8_t
+    std::stringstream wide;
+    VarintBinarySerializer ws(wide);
+    ASSERT_EQ(ws(int32_t(-200), int32_t(-200)), Error::NoError);
+    VarintBinaryDeserializer w(wide);
+    int8_t small = 1;
+    EXPECT_EQ(w.load(small), Error::CorruptedArchive);
+    EXPECT_EQ(w(small), Error::CorruptedArchive);
+    EXPECT_EQ(small, 1);
+
+    // the fixed format keeps sign-extended 8-byte integers
+    std::stringstream fixed;
+    FixedBinarySerializer f(fixed);
+    ASSERT_EQ(f(int32_t(-5)), Error::NoError);
+    EXPECT_EQ(fixed.str(), std::string("\xfb\xff\xff\xff\xff\xff\xff\xff", 8));
+}
+
+TEST(BinaryArchive, Corrupted) {
+    const std::string bad[] = {
+        std::string("\x02", 1),                 // bool that is not 0 or 1
+        std::string("\x80\x00", 2),             // overlong varint
+        std::string(9, '\xff') + '\x02',        // varint above 2^64
+        std::string("\x80", 1),                 // truncated varint
+    };
+    for (const std::string& bytes : bad) {
+        std::stringstream s(bytes);
+        VarintBinaryDeserializer d(s);
+        uint64_t v = 0;
+        bool b = false;
+        const Error err = bytes[0] == '\x02' ? d.load(b) : d.load(v);
+        EXPECT_EQ(err, Error::CorruptedArchive);
+    }
+}
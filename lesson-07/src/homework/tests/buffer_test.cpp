@@ -0,0 +1,124 @@
+// buffer_test.cpp: the byte buffer backends against the stream ones
+#include <gtest/gtest.h>
+#include "../include/Serializer.hpp"
+#include "../include/Deserializer.hpp"
+#include <limits>
+#include <sstream>
+#include <vector>
+
+template <class Format>
+class BufferArchiveTest : public ::testing::Test {};
+
+using Formats = ::testing::Types<TextFormat, FixedBinaryFormat, VarintBinaryFormat>;
+TYPED_TEST_SUITE(BufferArchiveTest, Formats);
+
+namespace
+{
+    std::vector<Data> sample()
+    {
+        std::vector<Data> input;
+        const uint64_t values[] = {0, 1, 127, 128, 300, uint64_t(1) << 32,
+                                   std::numeric_limits<uint64_t>::max()};
+        for (uint64_t v : values)
+            input.push_back(Data{v, v % 2 == 0, ~v});
+        return input;
+    }
+}
+
+TYPED_TEST(BufferArchiveTest, SameBytesAsStream) {
+    const std::vector<Data> input = sample();
+    std::stringstream s;
+    BasicSerializer<TypeParam> streamSer(s);
+    std::vector<uint8_t> buf(1024);
+    BufferSerializer<TypeParam> ser({buf.data(), buf.size()});
+    for (Data x : input) {
+        ASSERT_EQ(streamSer.save(x), Error::NoError);
+        ASSERT_EQ(ser.save(x), Error::NoError);
+    }
+    const size_t size = size_t(ser.writer().position() - buf.data());
+    EXPECT_EQ(std::string(buf.begin(), buf.begin() + size), s.str());
+
+    BufferDeserializer<TypeParam> d({buf.data(), size});
+    for (const Data& x : input) {
+        Data y{1, false, 1};
+        ASSERT_EQ(d.load(y), Error::NoError);
+        EXPECT_EQ(y.a, x.a);
+        EXPECT_EQ(y.b, x.b);
+        EXPECT_EQ(y.c, x.c);
+    }
+    // the text format leaves the last separator
+    EXPECT_EQ(d.reader().remaining(), (std::is_same<TypeParam, TextFormat>::value ? 1u : 0u));
+    Data z{};
+    EXPECT_EQ(d.load(z), Error::CorruptedArchive);
+}
+
+TYPED_TEST(BufferArchiveTest, Overflow) {
+    // every buffer size around the exact one: a message is written whole
+    // or not at all, through the checked path near the end of the buffer
+    Data x{5, true, uint64_t(1) << 40};
+    std::stringstream s;
+    BasicSerializer<TypeParam>(s).save(x);
+    const size_t exact = s.str().size();
+    for (size_t n = 0; n <= exact + 2; ++n) {
+        std::vector<uint8_t> buf(n + 1, 0xee);
+        BufferSerializer<TypeParam> ser({buf.data(), n});
+        const Error err = ser.save(x);
+        const size_t written = size_t(ser.writer().position() - buf.data());
+        if (n < exact) {
+            EXPECT_EQ(err, Error::BufferOverflow) << n;
+            EXPECT_EQ(written, 0u) << n;
+        } else {
+            EXPECT_EQ(err, Error::NoError) << n;
+            EXPECT_EQ(written, exact) << n;
+        }
+        EXPECT_EQ(buf[n], 0xee) << n;
+    }
+}
+
+TYPED_TEST(BufferArchiveTest, OverflowThroughOperator) {
+    // operator() called directly, without save(): fixed-size fields and a
+    // string, each too large for the buffer
+    std::vector<uint8_t> buf(6, 0xee);
+    BufferSerializer<TypeParam> ser({buf.data(), 5});
+    EXPECT_EQ(ser(uint64_t(1) << 60, true), Error::BufferOverflow);
+    EXPECT_EQ(ser.writer().position(), buf.data());
+    EXPECT_EQ(ser(std::string(100, 'x')), Error::BufferOverflow);
+    EXPECT_EQ(ser.writer().position(), buf.data());
+    EXPECT_EQ(buf[5], 0xee);
+
+    // a call that fits still goes in after a failed one
+    EXPECT_EQ(ser(true), Error::NoError);
+    EXPECT_NE(ser.writer().position(), buf.data());
+}
+
+TYPED_TEST(BufferArchiveTest, Truncated) {
+    std::vector<uint8_t> buf(64);
+    BufferSerializer<TypeParam> ser({buf.data(), buf.size()});
+    Data x{uint64_t(1) << 40, true, uint64_t(1) << 50};
+    ASSERT_EQ(ser.save(x), Error::NoError);
+    const size_t size = size_t(ser.writer().position() - buf.data());
+    // in the text format any prefix of the last number is a number
+    size_t complete = size;
+    if (std::is_same<TypeParam, TextFormat>::value)
+        complete = std::string(buf.begin(), buf.begin() + size).rfind(' ', size - 2) + 1;
+    for (size_t n = 0; n < complete; ++n) {
+        // a copy of exactly n bytes, so that reading past it shows up
+        // under the sanitizers
+        std::vector<uint8_t> part(buf.begin(), buf.begin() + n);
+        BufferDeserializer<TypeParam> d({part.data(), part.size()});
+        Data y{};
+        EXPECT_EQ(d.load(y), Error::CorruptedArchive) << n;
+    }
+}
+
+TEST(BufferArchive, CorruptedVarintStaysInBuffer) {
+    // a run of continuation bytes ending the buffer, behind a valid
+    // message: the unchecked path is only taken for the first one
+    std::vector<uint8_t> buf = {0x01, 0x01, 0x02};
+    buf.insert(buf.end(), 25, 0x80);
+    BufferDeserializer<VarintBinaryFormat> d({buf.data(), buf.size()});
+    Data y{};
+    ASSERT_EQ(d.load(y), Error::NoError);
+    EXPECT_EQ(y.c, 2u);
+    EXPECT_EQ(d.load(y), Error::CorruptedArchive);
+}
@@ -0,0 +1,294 @@
+// container_test.cpp: strings, containers, optionals and nested messages
+#include <gtest/gtest.h>
+#include "../include/Serializer.hpp"
+#include "../include/Deserializer.hpp"
+#include <limits>
+#include <sstream>
+
+namespace
+{
+    struct Point
+    {
+        uint64_t x;
+        uint64_t y;
+
+        bool operator==(const Point& other) const { return x == other.x && y == other.y; }
+
+        template <class SerializerT>
+        Error serialize(SerializerT& serializer)
+        {
+            return serializer(x, y);
+        }
+    };
+
+    struct Message
+    {
+        std::string name;
+        Data header;
+        std::vector<uint64_t> ids;
+        std::vector<int32_t> deltas;
+        std::vector<std::string> tags;
+        std::vector<Point> points;
+        std::vector<bool> flags;
+        std::map<std::string, uint64_t> counters;
+        std::map<uint64_t, Point> places;
+        std::optional<uint64_t> limit;
+        std::optional<Point> origin;
+        uint32_t version;
+
+        template <class SerializerT>
+        Error serialize(SerializerT& serializer)
+        {
+            return serializer(name, header, ids, deltas, tags, points, flags, counters, places, limit,
+                              origin, version);
+        }
+    };
+
+    struct Samples
+    {
+        float gain;
+        double offset;
+        std::vector<float> coarse;
+        std::vector<double> fine;
+
+        template <class SerializerT>
+        Error serialize(SerializerT& serializer)
+        {
+            return serializer(gain, offset, coarse, fine);
+        }
+    };
+
+    // a string literal field, which only the serializer can use
+    struct Literal
+    {
+        template <class SerializerT>
+        Error serialize(SerializerT& serializer)
+        {
+            return serializer("hello");
+        }
+    };
+
+    Message sample()
+    {
+        Message m;
+        m.name = "a name with spaces";
+        m.header = Data{1, true, 2};
+        m.ids = {0, 1, 300, std::numeric_limits<uint64_t>::max()};
+        m.deltas = {-1, 0, std::numeric_limits<int32_t>::min(), 7};
+        m.tags = {"", "x", std::string(300, 'z')};
+        m.points = {{1, 2}, {3, 4}};
+        m.flags = {true, false, true};
+        m.counters = {{"", 0}, {"b", 5}, {"c", 1ull << 40}};
+        m.places = {{10, {1, 1}}, {20, {2, 2}}};
+        m.limit = 99;
+        m.origin = std::nullopt;
+        m.version = 3;
+        return m;
+    }
+
+    void expectEqual(const Message& a, const Message& b)
+    {
+        EXPECT_EQ(a.name, b.name);
+        EXPECT_EQ(a.header.a, b.header.a);
+        EXPECT_EQ(a.header.b, b.header.b);
+        EXPECT_EQ(a.header.c, b.header.c);
+        EXPECT_EQ(a.ids, b.ids);
+        EXPECT_EQ(a.deltas, b.deltas);
+        EXPECT_EQ(a.tags, b.tags);
+        EXPECT_EQ(a.points, b.points);
+        EXPECT_EQ(a.flags, b.flags);
+        EXPECT_EQ(a.counters, b.counters);
+        EXPECT_EQ(a.places, b.places);
+        EXPECT_EQ(a.limit, b.limit);
+        EXPECT_EQ(a.origin, b.origin);
+        EXPECT_EQ(a.version, b.version);
+    }
+}
+
+template <class Format>
+class ContainerArchiveTest : public ::testing::Test {};
+
+using Formats = ::testing::Types<TextFormat, FixedBinaryFormat, VarintBinaryFormat>;
+TYPED_TEST_SUITE(ContainerArchiveTest, Formats);
+
+TYPED_TEST(ContainerArchiveTest, RoundTrip) {
+    Message x = sample();
+    Message other = sample();
+    other.origin = Point{5, 6};
+    other.limit.reset();
+    other.tags.clear();
+
+    std::stringstream s;
+    BasicSerializer<TypeParam> ser(s);
+    ASSERT_EQ(ser.save(x), Error::NoError);
+    ASSERT_EQ(ser.save(other), Error::NoError);
+
+    std::vector<uint8_t> buf(s.str().size());
+    BufferSerializer<TypeParam> bufSer({buf.data(), buf.size()});
+    ASSERT_EQ(bufSer.save(x), Error::NoError);
+    ASSERT_EQ(bufSer.save(other), Error::NoError);
+    EXPECT_EQ(std::string(buf.begin(), buf.end()), s.str());
+
+    BasicDeserializer<TypeParam> d(s);
+    BufferDeserializer<TypeParam> bufD({buf.data(), buf.size()});
+    for (const Message* expected : {&x, &other}) {
+        Message y, z;
+        ASSERT_EQ(d.load(y), Error::NoError);
+        ASSERT_EQ(bufD.load(z), Error::NoError);
+        expectEqual(y, *expected);
+        expectEqual(z, *expected);
+    }
+}
+
+TYPED_TEST(ContainerArchiveTest, FloatingPoint) {
+    // every value reads back bit for bit, through the bulk array path
+    Samples x{-0.1f, 1e-300,
+              {0.0f, -1.5f, std::numeric_limits<float>::max(), std::numeric_limits<float>::denorm_min()},
+              {0.1, -2.2250738585072014e-308, std::numeric_limits<double>::infinity(), 1.0 / 3}};
+    std::stringstream s;
+    ASSERT_EQ(BasicSerializer<TypeParam>(s).save(x), Error::NoError);
+    std::vector<uint8_t> buf(s.str().size());
+    BufferSerializer<TypeParam> bufSer({buf.data(), buf.size()});
+    ASSERT_EQ(bufSer.save(x), Error::NoError);
+    EXPECT_EQ(std::string(buf.begin(), buf.end()), s.str());
+
+    Samples y{}, z{};
+    ASSERT_EQ(BasicDeserializer<TypeParam>(s).load(y), Error::NoError);
+    ASSERT_EQ(BufferDeserializer<TypeParam>({buf.data(), buf.size()}).load(z), Error::NoError);
+    for (const Samples* got : {&y, &z}) {
+        EXPECT_EQ(got->gain, x.gain);
+        EXPECT_EQ(got->offset, x.offset);
+        EXPECT_EQ(got->coarse, x.coarse);
+        EXPECT_EQ(got->fine, x.fine);
+    }
+}
+
+TYPED_TEST(ContainerArchiveTest, ReusesStorage) {
+    Message x = sample();
+    std::stringstream s;
+    BasicSerializer<TypeParam>(s).save(x);
+
+    // a larger message loaded into first: nothing needs to grow
+    Message y = sample();
+    y.name.append(100, '!');
+    y.ids.resize(100);
+    y.tags.push_back("more");
+    const char* name = y.name.data();
+    const uint64_t* ids = y.ids.data();
+    const int32_t* deltas = y.deltas.data();
+    const char* longTag = y.tags[2].data();
+    const uint64_t* counter = &y.counters["b"];
+    const Point* place = &y.places[20];
+
+    BasicDeserializer<TypeParam> d(s);
+    ASSERT_EQ(d.load(y), Error::NoError);
+    expectEqual(y, x);
+    EXPECT_EQ(y.name.data(), name);
+    EXPECT_EQ(y.ids.data(), ids);
+    EXPECT_EQ(y.deltas.data(), deltas);
+    EXPECT_EQ(y.tags[2].data(), longTag);
+    // map nodes are reused in order
+    EXPECT_EQ(&y.counters["b"], counter);
+    EXPECT_EQ(&y.places[20], place);
+}
+
+TEST(ContainerArchive, Layout) {
+    std::stringstream text;
+    Serializer t(text);
+    ASSERT_EQ(t(std::string("ab"), std::string(), std::vector<uint32_t>{5, 6},
+                std::optional<uint64_t>()), Error::NoError);
+    EXPECT_EQ(text.str(), "2 6162 0 2 5 6 false ");
+
+    std::stringstream varint;
+    VarintBinarySerializer v(varint);
+    ASSERT_EQ(v(std::string("ab"), std::vector<uint16_t>{0x0102, 3}, std::optional<uint64_t>(300),
+                std::map<uint64_t, bool>{{1, true}}), Error::NoError);
+    // arrays keep their elements' width, in little-endian order
+    EXPECT_EQ(varint.str(), std::string("\x02" "ab" "\x02\x02\x01\x03\x00" "\x01\xac\x02" "\x01\x01\x01", 14));
+
+    std::stringstream floats;
+    ASSERT_EQ(Serializer(floats)(0.5, std::vector<float>{1.5f, -2}), Error::NoError);
+    EXPECT_EQ(floats.str(), "0.5 2 1.5 -2 ");
+    std::stringstream binary;
+    ASSERT_EQ(FixedBinarySerializer(binary)(std::vector<float>{1.5f}), Error::NoError);
+    EXPECT_EQ(binary.str(), std::string("\x01\0\0\0\0\0\0\0" "\0\0\xc0\x3f", 12));
+}
+
+TEST(ContainerArchive, StringLiterals) {
+    // written as std::string, not converted to bool
+    std::stringstream s;
+    ASSERT_EQ(Serializer(s)("hello", std::string_view("ab")), Error::NoError);
+    EXPECT_EQ(s.str(), "5 68656c6c6f 2 6162 ");
+
+    std::string a, b;
+    ASSERT_EQ(Deserializer(s)(a, b), Error::NoError);
+    EXPECT_EQ(a, "hello");
+    EXPECT_EQ(b, "ab");
+
+    Literal literal;
+    std::vector<uint8_t> buf(6);
+    BufferSerializer<VarintBinaryFormat> ser({buf.data(), buf.size()});
+    ASSERT_EQ(ser.save(literal), Error::NoError);
+    EXPECT_EQ(std::string(buf.begin(), buf.end()), "\x05hello");
+}
+
+TEST(ContainerArchive, Corrupted) {
+    {
+        // not a number, and out of range for a float
+        std::stringstream s("1.5x 1e50 ");
+        float f = 1;
+        EXPECT_EQ(Deserializer(s)(f), Error::CorruptedArchive);
+        EXPECT_EQ(Deserializer(s)(f), Error::CorruptedArchive);
+        EXPECT_EQ(f, 1.0f);
+    }
+    {
+        // duplicate map key
+        std::stringstream s("2 1 true 1 false ");
+        Deserializer d(s);
+        std::map<uint64_t, bool> m;
+        EXPECT_EQ(d.load(m), Error::CorruptedArchive);
+    }
+    {
+        // array element out of range, narrowing of a single value
+        std::stringstream s("1 300 70000 ");
+        Deserializer d(s);
+        std::vector<uint8_t> bytes;
+        EXPECT_EQ(d.load(bytes), Error::CorruptedArchive);
+        uint16_t small = 0;
+        EXPECT_EQ(d.load(small), Error::CorruptedArchive);
+    }
+    {
+        // string length disagreeing with its bytes
+        std::stringstream s("3 6162 ");
+        Deserializer d(s);
+        std::string str;
+        EXPECT_EQ(d.load(str), Error::CorruptedArchive);
+    }
+    {
+        // huge lengths at the end of the input fail without allocating
+        const std::string huge("\xff\xff\xff\xff\xff\xff\xff\xff\x7f", 9);
+        std::vector<uint8_t> buf(huge.begin(), huge.end());
+        std::string str;
+        std::vector<uint64_t> ids;
+        std::vector<std::string> tags;
+        BufferDeserializer<VarintBinaryFormat> a({buf.data(), buf.size()});
+        EXPECT_EQ(a.load(str), Error::CorruptedArchive);
+        BufferDeserializer<VarintBinaryFormat> b({buf.data(), buf.size()});
+        EXPECT_EQ(b.load(ids), Error::CorruptedArchive);
+        BufferDeserializer<VarintBinaryFormat> c({buf.data(), buf.size()});
+        EXPECT_EQ(c.load(tags), Error::CorruptedArchive);
+    }
+}
+
+TEST(ContainerArchive, Truncated) {
+    Message x = sample();
+    std::stringstream s;
+    FixedBinarySerializer(s).save(x);
+    const std::string full = s.str();
+    for (size_t n = 0; n < full.size(); ++n) {
+        std::vector<uint8_t> part(full.begin(), full.begin() + n);
+        BufferDeserializer<FixedBinaryFormat> d({part.data(), part.size()});
+        Message y;
+        EXPECT_EQ(d.load(y), Error::CorruptedArchive) << n;
+    }
+}